@@ -1,113 +1,364 @@
 #pragma once
 
 #include <cstdlib>
+#include <cstddef>
 #include <iterator>
 #include <functional>
 #include <utility>
 
 #include <fmt/core.h>
 
+#include "../list/exceptions.hpp"
+#include "../list/node_cache.hpp"
+
 
 template <typename T>
 class ForwardList{
 private:
-  class Node{
-    friend class ForwardListIterator;
+  // Links only. The list keeps one of them before the first element,
+  // the last element links to nullptr, which is End()
+  class BaseNode{
     friend class ForwardList;
-    /*???*/
 
     private:
-      /*???*/
+      BaseNode* next_ = nullptr;
+  };
+
+  class Node : public BaseNode{
+    friend class ForwardList;
 
+    public:
+      template <typename... Args>
+      explicit Node(Args&&... args) : value_(std::forward<Args>(args)...) {
+      }
+
+    private:
+      T value_;
   };
+
 public:
   class ForwardListIterator{
+    friend class ForwardList;
+
     public:
-    /*???*/
+      using value_type = T;
+      using reference_type = value_type&;
+      using pointer_type = value_type*;
+      using reference = reference_type;
+      using pointer = pointer_type;
+      using difference_type = std::ptrdiff_t;
+      using iterator_category = std::forward_iterator_tag;
+
+      inline bool operator==(const ForwardListIterator& other) const {
+          return current == other.current;
+      };
+
+      inline bool operator!=(const ForwardListIterator& other) const {
+          return current != other.current;
+      };
+
+      inline reference_type operator*() const {
+          return static_cast<Node*>(current)->value_;
+      };
+
+      ForwardListIterator& operator++() {
+          current = current->next_;
+          return *this;
+      };
+
+      ForwardListIterator operator++(int) {
+          ForwardListIterator old = *this;
+          current = current->next_;
+          return old;
+      };
+
+      inline pointer_type operator->() const {
+          return &static_cast<Node*>(current)->value_;
+      };
 
   private:
-      ForwardListIterator(const Node*) {
-          // Not implemented
+      explicit ForwardListIterator(const BaseNode* node) : current(const_cast<BaseNode*>(node)) {
       }
   private:
-      Node* current;
+      BaseNode* current;
   };
 
 public:
   ForwardList() {
-    // Not implemented
   }
 
-  explicit ForwardList(size_t /*sz*/) {
-    // Not implemented
+  explicit ForwardList(size_t sz) {
+    while (sz--) {
+      PushFront(T());
+    }
   }
 
-  ForwardList(const std::initializer_list<T>& /*values*/) {
-    // Not implemented
+  ForwardList(const std::initializer_list<T>& values) {
+    AssignRange(values.begin(), values.end());
   }
 
-  ForwardList(const ForwardList& /*other*/) {
-    // Not implemented
+  ForwardList(const ForwardList& other) {
+    AssignRange(other.Begin(), other.End());
   }
 
-  ForwardList& operator=(const ForwardList& /*other*/) {
-    std::abort(); // Not implemented
+  // Reuses nodes of this list through the cache. The copies are made before
+  // the old elements are destroyed, so if copying throws, the list is left as it was
+  ForwardList& operator=(const ForwardList& other) {
+    if (this != &other) {
+      BaseNode copies;
+      BaseNode* tail = &copies;
+      try {
+        for (auto it = other.Begin(); it != other.End(); ++it) {
+          tail->next_ = CreateNode(*it);
+          tail = tail->next_;
+        }
+      } catch (...) {
+        tail->next_ = nullptr;
+        for (BaseNode* node = copies.next_; node != nullptr;) {
+          BaseNode* next = node->next_;
+          DestroyNode(node);
+          node = next;
+        }
+        throw;
+      }
+      Clear();
+      head_.next_ = copies.next_;
+      size_ = other.size_;
+    }
+    return *this;
   }
 
   ForwardListIterator Begin() const noexcept {
-    std::abort(); // Not implemented
+    return ForwardListIterator(head_.next_);
   }
 
   ForwardListIterator End() const noexcept {
-    std::abort(); // Not implemented
+    return ForwardListIterator(nullptr);
   }
 
   inline T& Front() const {
-    std::abort(); // Not implemented
+    return *Begin();
   }
 
   inline bool IsEmpty() const noexcept {
-    std::abort(); // Not implemented
+    return size_ == 0;
   }
 
   inline size_t Size() const noexcept {
-    std::abort(); // Not implemented
+    return size_;
+  }
+
+  void Swap(ForwardList& a) {
+    std::swap(head_.next_, a.head_.next_);
+    std::swap(size_, a.size_);
+    cache_.Swap(a.cache_);
+  }
+
+  void EraseAfter(ForwardListIterator pos) {
+    EraseAfter(pos.current);
+  }
+
+  void InsertAfter(ForwardListIterator pos, const T& value) {
+    EmplaceAfter(pos.current, value);
   }
 
-  void Swap(ForwardList& /*a*/) {
-    // Not implemented
+  void InsertAfter(ForwardListIterator pos, T&& value) {
+    EmplaceAfter(pos.current, std::move(value));
   }
 
-  void EraseAfter(ForwardListIterator /*pos*/) {
-    // Not implemented
+  // Constructs the element from args right in its node after pos
+  template <typename... Args>
+  ForwardListIterator EmplaceAfter(ForwardListIterator pos, Args&&... args) {
+    return ForwardListIterator(EmplaceAfter(pos.current, std::forward<Args>(args)...));
   }
 
-  void InsertAfter(ForwardListIterator /*pos*/, const T& /*value*/) {
-    // Not implemented
+  ForwardListIterator Find(const T& value) const {
+    for (BaseNode* node = head_.next_; node != nullptr; node = node->next_) {
+      Prefetch(node->next_);
+      if (ValueOf(node) == value) {
+        return ForwardListIterator(node);
+      }
+    }
+    return End();
+  }
+
+  // Calls function on every element in order. The next node is prefetched
+  // before function runs on the current one, so its work overlaps the load
+  template <typename Function>
+  void ForEach(Function function) {
+    for (BaseNode* node = head_.next_; node != nullptr;) {
+      BaseNode* next = node->next_;
+      Prefetch(next);
+      function(static_cast<Node*>(node)->value_);
+      node = next;
+    }
+  }
+
+  template <typename Function>
+  void ForEach(Function function) const {
+    for (const BaseNode* node = head_.next_; node != nullptr;) {
+      const BaseNode* next = node->next_;
+      Prefetch(next);
+      function(ValueOf(node));
+      node = next;
+    }
   }
 
-  ForwardListIterator Find(const T& /*value*/) const {
-    std::abort(); // Not implemented
+  // Looks for every value of [first, last) and writes an iterator to its first match,
+  // or End(), to out. The list is walked once per FIND_BATCH values instead of once
+  // per value, so each node is loaded from memory once for the whole batch
+  template <typename ForwardIterator, typename OutputIterator>
+  OutputIterator FindMany(ForwardIterator first, ForwardIterator last, OutputIterator out) const {
+    while (first != last) {
+      const T* values[FIND_BATCH];
+      BaseNode* found[FIND_BATCH];
+      size_t count = 0;
+      for (; first != last && count < FIND_BATCH; ++first, ++count) {
+        values[count] = &*first;
+        found[count] = nullptr;
+      }
+
+      size_t pending = count;
+      for (BaseNode* node = head_.next_; node != nullptr && pending != 0; node = node->next_) {
+        Prefetch(node->next_);
+        for (size_t i = 0; i < count; ++i) {
+          if (found[i] == nullptr && ValueOf(node) == *values[i]) {
+            found[i] = node;
+            --pending;
+          }
+        }
+      }
+
+      for (size_t i = 0; i < count; ++i) {
+        *out++ = ForwardListIterator(found[i]);
+      }
+    }
+    return out;
   }
 
   void Clear() noexcept {
-    // Not implemented
+    BaseNode* node = head_.next_;
+    while (node != nullptr) {
+      BaseNode* next = node->next_;
+      DestroyNode(node);
+      node = next;
+    }
+    head_.next_ = nullptr;
+    size_ = 0;
+  }
+
+  void PushFront(const T& value) {
+    EmplaceAfter(&head_, value);
   }
 
-  void PushFront(const T& /*value*/) {
-    // Not implemented
+  void PushFront(T&& value) {
+    EmplaceAfter(&head_, std::move(value));
+  }
+
+  template <typename... Args>
+  T& EmplaceFront(Args&&... args) {
+    return static_cast<Node*>(EmplaceAfter(&head_, std::forward<Args>(args)...))->value_;
   }
 
   void PopFront() {
-    // Not implemented
+    if (IsEmpty()) {
+      throw ListIsEmptyException("PopFront from empty list");
+    }
+    EraseAfter(&head_);
+  }
+
+  // Erased nodes are kept for reuse: up to CacheLimit() of them,
+  // and all of those preallocated by Reserve
+  void SetCacheLimit(size_t limit) noexcept {
+    cache_.SetLimit(limit);
+  }
+
+  inline size_t CacheLimit() const noexcept {
+    return cache_.Limit();
+  }
+
+  // Elements the list can hold without allocating
+  inline size_t Capacity() const noexcept {
+    return size_ + cache_.CachedCount();
+  }
+
+  // Preallocates nodes for count elements in one slab
+  void Reserve(size_t count) {
+    if (count > size_) {
+      cache_.Reserve(count - size_);
+    }
+  }
+
+  // Returns cached nodes to the heap
+  void ShrinkToFit() noexcept {
+    cache_.ShrinkToFit();
   }
 
   ~ForwardList() {
-    // Not implemented
+    Clear();
+  }
+
+private:
+  static constexpr size_t FIND_BATCH = 16;
+
+  static inline const T& ValueOf(const BaseNode* node) noexcept {
+    return static_cast<const Node*>(node)->value_;
+  }
+
+  // Asks the CPU to start loading the node while the current one is compared,
+  // instead of stalling on it at the next step
+  static inline void Prefetch(const BaseNode* node) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(node);
+#endif
+  }
+
+  template <typename... Args>
+  Node* CreateNode(Args&&... args) {
+    void* memory = cache_.Allocate();
+    try {
+      return new (memory) Node(std::forward<Args>(args)...);
+    } catch (...) {
+      cache_.Deallocate(memory);
+      throw;
+    }
+  }
+
+  void DestroyNode(BaseNode* node) noexcept {
+    static_cast<Node*>(node)->~Node();
+    cache_.Deallocate(node);
+  }
+
+  template <typename... Args>
+  BaseNode* EmplaceAfter(BaseNode* pos, Args&&... args) {
+    Node* node = CreateNode(std::forward<Args>(args)...);
+    node->next_ = pos->next_;
+    pos->next_ = node;
+    ++size_;
+    return node;
+  }
+
+  void EraseAfter(BaseNode* pos) noexcept {
+    BaseNode* node = pos->next_;
+    pos->next_ = node->next_;
+    DestroyNode(node);
+    --size_;
+  }
+
+  // Appends [first, last) in order, the list must be empty
+  template <typename Iterator>
+  void AssignRange(Iterator first, Iterator last) {
+    BaseNode* tail = &head_;
+    for (; first != last; ++first) {
+      EmplaceAfter(tail, *first);
+      tail = tail->next_;
+    }
   }
 
 private:
-  /*???*/
+  BaseNode head_;
+  size_t size_ = 0;
+  NodeCache<Node> cache_;
 };
 
 
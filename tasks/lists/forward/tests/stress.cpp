@@ -1,6 +1,8 @@
+#include <algorithm>
 #include <random>
 #include <forward_list>
 #include <string>
+#include <vector>
 
 #include <benchmark/benchmark.h>
 #include <fmt/core.h>
@@ -31,6 +33,79 @@ void ConstructRandomList(std::forward_list<int>& list, int sz) {
   }
 }
 
+// List of values 0..sz-1 whose nodes were moved around rounds times per element,
+// so that neighbours in the list are no longer neighbours in memory
+void ConstructScatteredList(ForwardList<int>& list, int sz, int rounds) {
+  std::mt19937 mt(17);
+  std::vector<ForwardList<int>::ForwardListIterator> elements;
+  for (int i = sz; i-- > 0;) {
+    list.PushFront(i);
+  }
+  for (auto it = list.Begin(); it != list.End(); ++it) {
+    elements.push_back(it);
+  }
+  for (int64_t step = 0; step < int64_t{sz} * rounds; ++step) {
+    auto before = elements[mt() % elements.size()];
+    auto victim = before;
+    if (++victim == list.End()) {
+      continue;
+    }
+    int value = *victim;
+    auto pos = elements[mt() % elements.size()];
+    if (*pos == value) {
+      continue;
+    }
+    list.EraseAfter(before);
+    list.InsertAfter(pos, value);
+    elements[value] = ++pos;
+  }
+}
+
+void ConstructScatteredList(std::forward_list<int>& list, int sz, int rounds) {
+  std::mt19937 mt(17);
+  std::vector<std::forward_list<int>::iterator> elements;
+  for (int i = sz; i-- > 0;) {
+    list.push_front(i);
+  }
+  for (auto it = list.begin(); it != list.end(); ++it) {
+    elements.push_back(it);
+  }
+  for (int64_t step = 0; step < int64_t{sz} * rounds; ++step) {
+    auto before = elements[mt() % elements.size()];
+    auto victim = std::next(before);
+    if (victim == list.end()) {
+      continue;
+    }
+    int value = *victim;
+    auto pos = elements[mt() % elements.size()];
+    if (*pos == value) {
+      continue;
+    }
+    list.erase_after(before);
+    elements[value] = list.insert_after(pos, value);
+  }
+}
+
+const int FIND_KEYS = 16;
+
+std::vector<int> RandomKeys(int sz) {
+  std::mt19937 mt(23);
+  std::vector<int> keys(FIND_KEYS);
+  for (auto& key : keys) {
+    key = static_cast<int>(mt() % sz);
+  }
+  return keys;
+}
+
+// Payloads which are expensive to copy but cheap to move
+constexpr size_t STRING_LENGTH = 64;
+constexpr size_t HEAVY_LENGTH = 256;
+using Heavy = std::vector<int>;
+
+std::string MakeString(int i) {
+  return std::string(STRING_LENGTH, static_cast<char>('a' + i % 26));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void BM_CustomListPushFront(benchmark::State& state) {
   ForwardList<int> list;
@@ -74,6 +149,104 @@ void BM_StdListMiddleInsert(benchmark::State& state) {
   state.SetComplexityN(state.range(0));
 }
 
+void BM_CustomListCopyString(benchmark::State& state) {
+  ForwardList<std::string> list;
+  for (auto _ : state) {
+    for (int i = 0; i < state.range(0); ++i) {
+      std::string value = MakeString(i);
+      list.PushFront(value);
+    }
+    list.Clear();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_CustomListMoveString(benchmark::State& state) {
+  ForwardList<std::string> list;
+  for (auto _ : state) {
+    for (int i = 0; i < state.range(0); ++i) {
+      list.PushFront(MakeString(i));
+    }
+    list.Clear();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_CustomListEmplaceString(benchmark::State& state) {
+  ForwardList<std::string> list;
+  for (auto _ : state) {
+    for (int i = 0; i < state.range(0); ++i) {
+      list.EmplaceFront(STRING_LENGTH, static_cast<char>('a' + i % 26));
+    }
+    list.Clear();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_StdListEmplaceString(benchmark::State& state) {
+  std::forward_list<std::string> list;
+  for (auto _ : state) {
+    for (int i = 0; i < state.range(0); ++i) {
+      list.emplace_front(STRING_LENGTH, static_cast<char>('a' + i % 26));
+    }
+    list.clear();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_CustomListCopyHeavy(benchmark::State& state) {
+  ForwardList<Heavy> list;
+  for (auto _ : state) {
+    for (int i = 0; i < state.range(0); ++i) {
+      Heavy value = Heavy(HEAVY_LENGTH, i);
+      list.PushFront(value);
+    }
+    list.Clear();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_CustomListMoveHeavy(benchmark::State& state) {
+  ForwardList<Heavy> list;
+  for (auto _ : state) {
+    for (int i = 0; i < state.range(0); ++i) {
+      list.PushFront(Heavy(HEAVY_LENGTH, i));
+    }
+    list.Clear();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_CustomListEmplaceHeavy(benchmark::State& state) {
+  ForwardList<Heavy> list;
+  for (auto _ : state) {
+    for (int i = 0; i < state.range(0); ++i) {
+      list.EmplaceFront(HEAVY_LENGTH, i);
+    }
+    list.Clear();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_StdListEmplaceHeavy(benchmark::State& state) {
+  std::forward_list<Heavy> list;
+  for (auto _ : state) {
+    for (int i = 0; i < state.range(0); ++i) {
+      list.emplace_front(HEAVY_LENGTH, i);
+    }
+    list.clear();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetComplexityN(state.range(0));
+}
+
 void BM_CustomListErase(benchmark::State& state) {
   ForwardList<int> list;
   for (auto _ : state) {
@@ -143,16 +316,170 @@ void BM_StdListFind(benchmark::State& state) {
 }
 
 
+// FIND_KEYS lookups of present values in a scattered list
+void BM_CustomListFindScattered(benchmark::State& state) {
+  ForwardList<int> list;
+  ConstructScatteredList(list, state.range(0), 4);
+  auto keys = RandomKeys(state.range(0));
+  for (auto _ : state) {
+    for (int key : keys) {
+      benchmark::DoNotOptimize(list.Find(key));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * FIND_KEYS);
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_CustomListFindManyScattered(benchmark::State& state) {
+  ForwardList<int> list;
+  ConstructScatteredList(list, state.range(0), 4);
+  auto keys = RandomKeys(state.range(0));
+  std::vector<ForwardList<int>::ForwardListIterator> found(FIND_KEYS, list.End());
+  for (auto _ : state) {
+    list.FindMany(keys.begin(), keys.end(), found.begin());
+    benchmark::DoNotOptimize(found.data());
+  }
+  state.SetItemsProcessed(state.iterations() * FIND_KEYS);
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_StdListFindScattered(benchmark::State& state) {
+  std::forward_list<int> list;
+  ConstructScatteredList(list, state.range(0), 4);
+  auto keys = RandomKeys(state.range(0));
+  for (auto _ : state) {
+    for (int key : keys) {
+      benchmark::DoNotOptimize(std::find(list.begin(), list.end(), key));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * FIND_KEYS);
+  state.SetComplexityN(state.range(0));
+}
+
+// Full traversal of a scattered list with some work per element
+uint64_t Mix(uint64_t hash, int value) {
+  hash ^= static_cast<uint64_t>(value);
+  hash *= 0x9E3779B97F4A7C15ULL;
+  return hash ^ (hash >> 29);
+}
+
+void BM_CustomListIterateScattered(benchmark::State& state) {
+  ForwardList<int> list;
+  ConstructScatteredList(list, state.range(0), 4);
+  for (auto _ : state) {
+    uint64_t hash = 0;
+    for (auto it = list.Begin(); it != list.End(); ++it) {
+      hash = Mix(hash, *it);
+    }
+    benchmark::DoNotOptimize(hash);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_CustomListForEachScattered(benchmark::State& state) {
+  ForwardList<int> list;
+  ConstructScatteredList(list, state.range(0), 4);
+  for (auto _ : state) {
+    uint64_t hash = 0;
+    list.ForEach([&hash](int value) {
+      hash = Mix(hash, value);
+    });
+    benchmark::DoNotOptimize(hash);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetComplexityN(state.range(0));
+}
+
+// A queue of fixed length: every iteration moves all its elements through the nodes
+void BM_CustomListChurn(benchmark::State& state) {
+  ForwardList<int> list;
+  ConstructRandomList(list, state.range(0));
+  auto tail = list.Begin();
+  std::advance(tail, state.range(0) - 1);
+  for (auto _ : state) {
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      list.InsertAfter(tail, list.Front());
+      ++tail;
+      list.PopFront();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_CustomListChurnNoCache(benchmark::State& state) {
+  ForwardList<int> list;
+  list.SetCacheLimit(0);
+  ConstructRandomList(list, state.range(0));
+  auto tail = list.Begin();
+  std::advance(tail, state.range(0) - 1);
+  for (auto _ : state) {
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      list.InsertAfter(tail, list.Front());
+      ++tail;
+      list.PopFront();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_StdListChurn(benchmark::State& state) {
+  std::forward_list<int> list;
+  ConstructRandomList(list, state.range(0));
+  auto tail = list.begin();
+  std::advance(tail, state.range(0) - 1);
+  for (auto _ : state) {
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      tail = list.insert_after(tail, list.front());
+      list.pop_front();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_CustomListReservedPushFront(benchmark::State& state) {
+  ForwardList<int> list;
+  for (auto _ : state) {
+    state.PauseTiming();
+    list.Clear();
+    list.ShrinkToFit();
+    state.ResumeTiming();
+    list.Reserve(state.range(0));
+    ConstructRandomList(list, state.range(0));
+  }
+  state.SetComplexityN(state.range(0));
+}
+
 BENCHMARK(BM_CustomListPushFront)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMillisecond);
 BENCHMARK(BM_StdListPushFront)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMillisecond);
 BENCHMARK(BM_CustomListMiddleInsert)->Range(1<<10, 1<<15)->Complexity()->Unit(benchmark::kMillisecond);
 BENCHMARK(BM_StdListMiddleInsert)->Range(1<<10, 1<<15)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CustomListCopyString)->Range(1<<10, 1<<16)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CustomListMoveString)->Range(1<<10, 1<<16)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CustomListEmplaceString)->Range(1<<10, 1<<16)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StdListEmplaceString)->Range(1<<10, 1<<16)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CustomListCopyHeavy)->Range(1<<10, 1<<16)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CustomListMoveHeavy)->Range(1<<10, 1<<16)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CustomListEmplaceHeavy)->Range(1<<10, 1<<16)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StdListEmplaceHeavy)->Range(1<<10, 1<<16)->Complexity()->Unit(benchmark::kMillisecond);
 BENCHMARK(BM_CustomListErase)->Range(1<<10, 1<<17)->Complexity()->Unit(benchmark::kMillisecond);
 BENCHMARK(BM_StdListErase)->Range(1<<10, 1<<17)->Complexity()->Unit(benchmark::kMillisecond);
 BENCHMARK(BM_CustomListClear)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMillisecond);
 BENCHMARK(BM_StdListClear)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMillisecond);
 BENCHMARK(BM_CustomListFind)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMillisecond);
 BENCHMARK(BM_StdListFind)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CustomListFindScattered)->Range(1<<10, 1<<18)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CustomListFindManyScattered)->Range(1<<10, 1<<18)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StdListFindScattered)->Range(1<<10, 1<<18)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CustomListIterateScattered)->Range(1<<10, 1<<18)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CustomListForEachScattered)->Range(1<<10, 1<<18)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CustomListChurn)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CustomListChurnNoCache)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StdListChurn)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CustomListReservedPushFront)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMillisecond);
 
 
 BENCHMARK_MAIN();
\ No newline at end of file
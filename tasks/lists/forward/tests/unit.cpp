@@ -1,4 +1,7 @@
 #include <forward_list>
+#include <stdexcept>
+#include <string>
+#include <vector>
 #include <thread>
 #include <future>
 #include <fmt/core.h>
@@ -185,6 +188,170 @@ TEST_F(ListTest, Clear) {
 }
 
 
+TEST(ForwardListCacheTest, ReusesErasedNodes) {
+  ForwardList<int> list{1, 2, 3};
+  const int* first = &list.Front();
+  list.PopFront();
+  ASSERT_EQ(list.Capacity(), 3);
+  list.PushFront(4);
+  ASSERT_EQ(&list.Front(), first);
+}
+
+TEST(ForwardListCacheTest, LimitIsRespected) {
+  ForwardList<int> list;
+  list.SetCacheLimit(3);
+  for (int i = 0; i < 10; ++i) {
+    list.PushFront(i);
+  }
+  list.Clear();
+  ASSERT_EQ(list.Capacity(), 3);
+  list.ShrinkToFit();
+  ASSERT_EQ(list.Capacity(), 0);
+}
+
+TEST(ForwardListCacheTest, ReserveAndShrinkToFit) {
+  ForwardList<std::string> list;
+  list.SetCacheLimit(0);
+  list.Reserve(50);
+  ASSERT_EQ(list.Capacity(), 50);
+  for (int i = 0; i < 50; ++i) {
+    list.PushFront(std::to_string(i));
+  }
+  ASSERT_EQ(list.Capacity(), 50);
+  list.PopFront();
+  ASSERT_EQ(list.Capacity(), 50);
+  list.ShrinkToFit();
+  ASSERT_EQ(list.Capacity(), 50);
+  list.Clear();
+  list.ShrinkToFit();
+  ASSERT_EQ(list.Capacity(), 0);
+}
+
+TEST(ForwardListCacheTest, SwapMovesCache) {
+  ForwardList<int> list{1, 2};
+  ForwardList<int> other;
+  list.Reserve(20);
+  std::swap(list, other);
+  ASSERT_EQ(other.Capacity(), 20);
+  ASSERT_EQ(list.Capacity(), 0);
+  ASSERT_EQ(other.Front(), 1);
+}
+
+struct ThrowingCopy {
+  static inline int copies_left = 0;
+  int value;
+
+  ThrowingCopy(int v) : value(v) {
+  }
+
+  ThrowingCopy(const ThrowingCopy& other) : value(other.value) {
+    if (copies_left-- == 0) {
+      throw std::runtime_error("copy failed");
+    }
+  }
+};
+
+TEST(ForwardListAssignmentTest, ThrowingCopyLeavesListIntact) {
+  ForwardList<ThrowingCopy> list;
+  ForwardList<ThrowingCopy> other;
+  ThrowingCopy::copies_left = 20;
+  for (int i = 0; i < 10; ++i) {
+    list.PushFront(ThrowingCopy(i));
+    other.PushFront(ThrowingCopy(i + 10));
+  }
+  ThrowingCopy::copies_left = 5;
+  ASSERT_THROW(list = other, std::runtime_error);
+  ASSERT_EQ(list.Size(), 10);
+  int expected = 9;
+  for (auto it = list.Begin(); it != list.End(); ++it) {
+    ASSERT_EQ(it->value, expected--);
+  }
+}
+
+// Counts copies and moves of values
+struct Tracked {
+  static inline int copies = 0;
+  static inline int moves = 0;
+  std::string value;
+
+  Tracked(std::string v) : value(std::move(v)) {
+  }
+
+  Tracked(const std::string& prefix, int number) : value(prefix + std::to_string(number)) {
+  }
+
+  Tracked(const Tracked& other) : value(other.value) {
+    ++copies;
+  }
+
+  Tracked(Tracked&& other) noexcept : value(std::move(other.value)) {
+    ++moves;
+  }
+
+  static void Reset() {
+    copies = moves = 0;
+  }
+};
+
+TEST(ForwardListEmplaceTest, MoveOverloadsDontCopy) {
+  ForwardList<Tracked> list;
+  Tracked::Reset();
+  Tracked value("a");
+  list.PushFront(std::move(value));
+  list.InsertAfter(list.Begin(), Tracked("b"));
+  ASSERT_EQ(Tracked::copies, 0);
+  ASSERT_EQ(Tracked::moves, 2);
+  ASSERT_EQ(list.Front().value, "a");
+  ASSERT_EQ((++list.Begin())->value, "b");
+}
+
+TEST(ForwardListEmplaceTest, ConstructsInPlace) {
+  ForwardList<Tracked> list;
+  Tracked::Reset();
+  list.EmplaceFront("x", 1).value += "!";
+  auto it = list.EmplaceAfter(list.Begin(), "x", 2);
+  list.EmplaceAfter(it, "x", 3);
+  ASSERT_EQ(Tracked::copies, 0);
+  ASSERT_EQ(Tracked::moves, 0);
+  ASSERT_EQ(it->value, "x2");
+  ASSERT_EQ(list.Front().value, "x1!");
+  ASSERT_EQ(list.Size(), 3);
+}
+
+TEST(ForwardListFindTest, FindManyMatchesFind) {
+  ForwardList<int> list;
+  for (int i = 0; i < 100; ++i) {
+    list.PushFront(i % 40);
+  }
+  std::vector<int> keys;
+  for (int key = -5; key < 45; ++key) {
+    keys.push_back(key);
+  }
+  std::vector<ForwardList<int>::ForwardListIterator> found(keys.size(), list.Begin());
+  ASSERT_EQ(list.FindMany(keys.begin(), keys.end(), found.begin()), found.end());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    ASSERT_EQ(found[i], list.Find(keys[i]));
+    if (keys[i] >= 0 && keys[i] < 40) {
+      ASSERT_EQ(*found[i], keys[i]);
+    } else {
+      ASSERT_EQ(found[i], list.End());
+    }
+  }
+}
+
+TEST(ForwardListFindTest, ForEachVisitsInOrder) {
+  ForwardList<int> list{1, 2, 3, 4};
+  list.ForEach([](int& value) {
+    value *= 10;
+  });
+  const ForwardList<int>& view = list;
+  std::vector<int> values;
+  view.ForEach([&values](const int& value) {
+    values.push_back(value);
+  });
+  ASSERT_EQ(values, (std::vector<int>{10, 20, 30, 40}));
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
 
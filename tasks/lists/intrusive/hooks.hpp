@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+
+
+// Links embedded into an element of IntrusiveList. An element may have several hooks
+// to be in several lists at once, one list per hook.
+//
+// Copying an element doesn't copy its links: the copy isn't in any list.
+class IntrusiveListHook{
+  template <typename T, IntrusiveListHook T::*Member>
+  friend class IntrusiveList;
+
+public:
+  IntrusiveListHook() {
+  }
+
+  IntrusiveListHook(const IntrusiveListHook&) {
+  }
+
+  IntrusiveListHook& operator=(const IntrusiveListHook&) {
+    return *this;
+  }
+
+  inline bool IsLinked() const noexcept {
+    return next_ != nullptr;
+  }
+
+private:
+  IntrusiveListHook* prev_ = nullptr;
+  IntrusiveListHook* next_ = nullptr;
+};
+
+// Link embedded into an element of IntrusiveForwardList
+class IntrusiveForwardListHook{
+  template <typename T, IntrusiveForwardListHook T::*Member>
+  friend class IntrusiveForwardList;
+
+public:
+  IntrusiveForwardListHook() {
+  }
+
+  IntrusiveForwardListHook(const IntrusiveForwardListHook&) {
+  }
+
+  IntrusiveForwardListHook& operator=(const IntrusiveForwardListHook&) {
+    return *this;
+  }
+
+private:
+  IntrusiveForwardListHook* next_ = nullptr;
+};
+
+namespace detail {
+  // Offset of the hook inside T, found at compile time. The element is never constructed:
+  // the address of its hook is compared with the bytes of the same union
+  template <typename T, typename Hook, Hook T::*Member>
+  consteval std::ptrdiff_t HookOffset() noexcept {
+    union Storage {
+      constexpr Storage() : bytes{} {
+      }
+
+      constexpr ~Storage() {
+      }
+
+      unsigned char bytes[sizeof(T)];
+      T element;
+    };
+
+    Storage storage;
+    const void* hook = &(storage.element.*Member);
+    for (std::size_t offset = 0; offset < sizeof(T); ++offset) {
+      if (hook == static_cast<const void*>(storage.bytes + offset)) {
+        return offset;
+      }
+    }
+    return -1;
+  }
+
+  // The element which embeds hook
+  template <typename T, typename Hook, Hook T::*Member>
+  inline T* ElementOf(const Hook* hook) noexcept {
+    constexpr std::ptrdiff_t OFFSET = HookOffset<T, Hook, Member>();
+    static_assert(OFFSET >= 0, "Member is not a hook of T");
+    auto* bytes = reinterpret_cast<unsigned char*>(const_cast<Hook*>(hook));
+    return reinterpret_cast<T*>(bytes - OFFSET);
+  }
+}
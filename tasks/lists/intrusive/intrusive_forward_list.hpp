@@ -0,0 +1,169 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+#include "../list/exceptions.hpp"
+#include "hooks.hpp"
+
+
+// Singly linked list of elements which embed an IntrusiveForwardListHook.
+//
+// Like IntrusiveList it doesn't own or allocate elements. Without back links
+// an element can only be unlinked after its predecessor: EraseAfter and PopFront.
+template <typename T, IntrusiveForwardListHook T::*Member>
+class IntrusiveForwardList{
+private:
+  using Hook = IntrusiveForwardListHook;
+
+  static inline T* ElementOf(const Hook* hook) noexcept {
+    return detail::ElementOf<T, Hook, Member>(hook);
+  }
+
+public:
+  class IntrusiveForwardListIterator{
+    friend class IntrusiveForwardList;
+
+    public:
+      using value_type = T;
+      using reference_type = value_type&;
+      using pointer_type = value_type*;
+      using reference = reference_type;
+      using pointer = pointer_type;
+      using difference_type = std::ptrdiff_t;
+      using iterator_category = std::forward_iterator_tag;
+
+      inline bool operator==(const IntrusiveForwardListIterator& other) const {
+          return current == other.current;
+      };
+
+      inline bool operator!=(const IntrusiveForwardListIterator& other) const {
+          return current != other.current;
+      };
+
+      inline reference_type operator*() const {
+          return *ElementOf(current);
+      };
+
+      IntrusiveForwardListIterator& operator++() {
+          current = current->next_;
+          return *this;
+      };
+
+      IntrusiveForwardListIterator operator++(int) {
+          IntrusiveForwardListIterator old = *this;
+          current = current->next_;
+          return old;
+      };
+
+      inline pointer_type operator->() const {
+          return ElementOf(current);
+      };
+
+  private:
+      explicit IntrusiveForwardListIterator(const Hook* hook) : current(const_cast<Hook*>(hook)) {
+      }
+  private:
+      Hook* current;
+  };
+
+public:
+  IntrusiveForwardList() {
+  }
+
+  IntrusiveForwardList(const IntrusiveForwardList&) = delete;
+
+  IntrusiveForwardList& operator=(const IntrusiveForwardList&) = delete;
+
+  IntrusiveForwardListIterator Begin() const noexcept {
+    return IntrusiveForwardListIterator(head_.next_);
+  }
+
+  IntrusiveForwardListIterator End() const noexcept {
+    return IntrusiveForwardListIterator(nullptr);
+  }
+
+  // Iterator to an element of this list
+  IntrusiveForwardListIterator IteratorTo(T& element) const noexcept {
+    return IntrusiveForwardListIterator(&(element.*Member));
+  }
+
+  inline T& Front() const {
+    return *Begin();
+  }
+
+  inline bool IsEmpty() const noexcept {
+    return size_ == 0;
+  }
+
+  inline size_t Size() const noexcept {
+    return size_;
+  }
+
+  void Swap(IntrusiveForwardList& a) noexcept {
+    std::swap(head_.next_, a.head_.next_);
+    std::swap(size_, a.size_);
+  }
+
+  IntrusiveForwardListIterator Find(const T& value) const {
+    for (auto it = Begin(); it != End(); ++it) {
+      if (*it == value) {
+        return it;
+      }
+    }
+    return End();
+  }
+
+  void EraseAfter(IntrusiveForwardListIterator pos) noexcept {
+    UnlinkAfter(pos.current);
+  }
+
+  void InsertAfter(IntrusiveForwardListIterator pos, T& element) noexcept {
+    LinkAfter(pos.current, &(element.*Member));
+  }
+
+  // Forgets all elements, their hooks are left as they are
+  void Clear() noexcept {
+    head_.next_ = nullptr;
+    size_ = 0;
+  }
+
+  void PushFront(T& element) noexcept {
+    LinkAfter(&head_, &(element.*Member));
+  }
+
+  void PopFront() {
+    if (IsEmpty()) {
+      throw ListIsEmptyException("PopFront from empty list");
+    }
+    UnlinkAfter(&head_);
+  }
+
+private:
+  void LinkAfter(Hook* pos, Hook* hook) noexcept {
+    hook->next_ = pos->next_;
+    pos->next_ = hook;
+    ++size_;
+  }
+
+  void UnlinkAfter(Hook* pos) noexcept {
+    Hook* hook = pos->next_;
+    pos->next_ = hook->next_;
+    hook->next_ = nullptr;
+    --size_;
+  }
+
+private:
+  Hook head_;
+  size_t size_ = 0;
+};
+
+
+namespace std {
+  // Global swap overloading
+  template <typename T, IntrusiveForwardListHook T::*Member>
+  void swap(IntrusiveForwardList<T, Member>& a, IntrusiveForwardList<T, Member>& b) {
+    a.Swap(b);
+  }
+}
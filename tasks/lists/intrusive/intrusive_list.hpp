@@ -0,0 +1,236 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+#include "../list/exceptions.hpp"
+#include "hooks.hpp"
+
+
+// Doubly linked list of elements which embed an IntrusiveListHook.
+//
+// The list doesn't own, copy or allocate elements: it only links their hooks,
+// so an element must outlive its membership in the list. Every operation is O(1)
+// except Find, Clear and the destructor, which unlink all elements.
+template <typename T, IntrusiveListHook T::*Member>
+class IntrusiveList{
+private:
+  using Hook = IntrusiveListHook;
+
+  static inline T* ElementOf(const Hook* hook) noexcept {
+    return detail::ElementOf<T, Hook, Member>(hook);
+  }
+
+public:
+  class IntrusiveListIterator{
+    friend class IntrusiveList;
+
+    public:
+      using value_type = T;
+      using reference_type = value_type&;
+      using pointer_type = value_type*;
+      using reference = reference_type;
+      using pointer = pointer_type;
+      using difference_type = std::ptrdiff_t;
+      using iterator_category = std::bidirectional_iterator_tag;
+
+      inline bool operator==(const IntrusiveListIterator& other) const {
+          return current == other.current;
+      };
+
+      inline bool operator!=(const IntrusiveListIterator& other) const {
+          return current != other.current;
+      };
+
+      inline reference_type operator*() const {
+          return *ElementOf(current);
+      };
+
+      IntrusiveListIterator& operator++() {
+          current = current->next_;
+          return *this;
+      };
+
+      IntrusiveListIterator operator++(int) {
+          IntrusiveListIterator old = *this;
+          current = current->next_;
+          return old;
+      };
+
+      IntrusiveListIterator& operator--() {
+          current = current->prev_;
+          return *this;
+      };
+
+      IntrusiveListIterator operator--(int) {
+          IntrusiveListIterator old = *this;
+          current = current->prev_;
+          return old;
+      };
+
+      inline pointer_type operator->() const {
+          return ElementOf(current);
+      };
+
+  private:
+      explicit IntrusiveListIterator(const Hook* hook) : current(const_cast<Hook*>(hook)) {
+      }
+  private:
+      Hook* current;
+  };
+
+public:
+  IntrusiveList() {
+    end_.prev_ = end_.next_ = &end_;
+  }
+
+  // Elements can't be in two lists through one hook
+  IntrusiveList(const IntrusiveList&) = delete;
+
+  IntrusiveList& operator=(const IntrusiveList&) = delete;
+
+  IntrusiveListIterator Begin() const noexcept {
+    return IntrusiveListIterator(end_.next_);
+  }
+
+  IntrusiveListIterator End() const noexcept {
+    return IntrusiveListIterator(&end_);
+  }
+
+  // Iterator to an element of this list
+  IntrusiveListIterator IteratorTo(T& element) const noexcept {
+    return IntrusiveListIterator(&(element.*Member));
+  }
+
+  inline T& Front() const {
+    return *Begin();
+  }
+
+  inline T& Back() const {
+    return *--End();
+  }
+
+  inline bool IsEmpty() const noexcept {
+    return size_ == 0;
+  }
+
+  inline size_t Size() const noexcept {
+    return size_;
+  }
+
+  void Swap(IntrusiveList& a) noexcept {
+    std::swap(end_.prev_, a.end_.prev_);
+    std::swap(end_.next_, a.end_.next_);
+    std::swap(size_, a.size_);
+    a.FixSentinel();
+    FixSentinel();
+  }
+
+  IntrusiveListIterator Find(const T& value) const {
+    for (auto it = Begin(); it != End(); ++it) {
+      if (*it == value) {
+        return it;
+      }
+    }
+    return End();
+  }
+
+  void Erase(IntrusiveListIterator pos) noexcept {
+    Unlink(pos.current);
+  }
+
+  // Unlinks an element of this list
+  void Erase(T& element) noexcept {
+    Unlink(&(element.*Member));
+  }
+
+  // Links element, which must not be in a list through this hook, before pos
+  void Insert(IntrusiveListIterator pos, T& element) noexcept {
+    Hook* hook = &(element.*Member);
+    Hook* next = pos.current;
+    hook->prev_ = next->prev_;
+    hook->next_ = next;
+    next->prev_->next_ = hook;
+    next->prev_ = hook;
+    ++size_;
+  }
+
+  void Clear() noexcept {
+    Hook* hook = end_.next_;
+    while (hook != &end_) {
+      Hook* next = hook->next_;
+      hook->prev_ = hook->next_ = nullptr;
+      hook = next;
+    }
+    end_.prev_ = end_.next_ = &end_;
+    size_ = 0;
+  }
+
+  void PushBack(T& element) noexcept {
+    Insert(End(), element);
+  }
+
+  void PushFront(T& element) noexcept {
+    Insert(Begin(), element);
+  }
+
+  void PopBack() {
+    if (IsEmpty()) {
+      throw ListIsEmptyException("PopBack from empty list");
+    }
+    Unlink(end_.prev_);
+  }
+
+  void PopFront() {
+    if (IsEmpty()) {
+      throw ListIsEmptyException("PopFront from empty list");
+    }
+    Unlink(end_.next_);
+  }
+
+  // Moves an element of this list before pos
+  void MoveBefore(IntrusiveListIterator pos, T& element) noexcept {
+    Hook* hook = &(element.*Member);
+    if (hook == pos.current) {
+      return;
+    }
+    Unlink(hook);
+    Insert(pos, element);
+  }
+
+  ~IntrusiveList() {
+    Clear();
+  }
+
+private:
+  void Unlink(Hook* hook) noexcept {
+    hook->prev_->next_ = hook->next_;
+    hook->next_->prev_ = hook->prev_;
+    hook->prev_ = hook->next_ = nullptr;
+    --size_;
+  }
+
+  // Neighbours of the sentinel still point to the other list
+  void FixSentinel() noexcept {
+    if (size_ == 0) {
+      end_.prev_ = end_.next_ = &end_;
+    } else {
+      end_.next_->prev_ = &end_;
+      end_.prev_->next_ = &end_;
+    }
+  }
+
+private:
+  Hook end_;
+  size_t size_ = 0;
+};
+
+
+namespace std {
+  // Global swap overloading
+  template <typename T, IntrusiveListHook T::*Member>
+  void swap(IntrusiveList<T, Member>& a, IntrusiveList<T, Member>& b) {
+    a.Swap(b);
+  }
+}
@@ -0,0 +1,161 @@
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <fmt/core.h>
+
+#include "../intrusive_list.hpp"
+#include "../intrusive_forward_list.hpp"
+#include "../../list/list.hpp"
+
+// Cache entry which already lives in a pool
+struct Entry {
+  int key = 0;
+  int payload[7] = {};
+  IntrusiveListHook hook;
+  IntrusiveForwardListHook forward_hook;
+};
+
+std::vector<Entry> ConstructPool(int sz) {
+  std::vector<Entry> pool(sz);
+  for (int i = 0; i < sz; ++i) {
+    pool[i].key = i;
+  }
+  return pool;
+}
+
+// Skewed accesses: most of them hit a small hot set, like real caches do
+std::vector<int> ConstructTrace(int sz) {
+  std::mt19937 mt(42);
+  std::uniform_int_distribution<int> hot(0, std::max(1, sz / 16) - 1);
+  std::uniform_int_distribution<int> any(0, sz - 1);
+  std::vector<int> trace(1 << 16);
+  for (auto& key : trace) {
+    key = mt() % 4 == 0 ? any(mt) : hot(mt);
+  }
+  return trace;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void BM_IntrusiveListMoveToFront(benchmark::State& state) {
+  auto pool = ConstructPool(state.range(0));
+  auto trace = ConstructTrace(state.range(0));
+  IntrusiveList<Entry, &Entry::hook> lru;
+  for (auto& entry : pool) {
+    lru.PushBack(entry);
+  }
+  for (auto _ : state) {
+    for (int key : trace) {
+      lru.MoveBefore(lru.Begin(), pool[key]);
+      benchmark::DoNotOptimize(lru.Back().key);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * trace.size());
+  state.SetComplexityN(state.range(0));
+}
+
+// List of pointers to the pooled entries, reinserted at the front on every access
+void BM_CustomListMoveToFront(benchmark::State& state) {
+  using Iterator = List<Entry*>::ListIterator;
+  auto pool = ConstructPool(state.range(0));
+  auto trace = ConstructTrace(state.range(0));
+  List<Entry*> lru;
+  std::vector<Iterator> position;
+  for (auto& entry : pool) {
+    lru.PushBack(&entry);
+    position.push_back(--lru.End());
+  }
+  for (auto _ : state) {
+    for (int key : trace) {
+      lru.Erase(position[key]);
+      lru.PushFront(&pool[key]);
+      position[key] = lru.Begin();
+      benchmark::DoNotOptimize(lru.Back()->key);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * trace.size());
+  state.SetComplexityN(state.range(0));
+}
+
+// Same, but the node is relinked with Splice instead of reallocated
+void BM_CustomListSpliceToFront(benchmark::State& state) {
+  using Iterator = List<Entry*>::ListIterator;
+  auto pool = ConstructPool(state.range(0));
+  auto trace = ConstructTrace(state.range(0));
+  List<Entry*> lru;
+  std::vector<Iterator> position;
+  for (auto& entry : pool) {
+    lru.PushBack(&entry);
+    position.push_back(--lru.End());
+  }
+  for (auto _ : state) {
+    for (int key : trace) {
+      lru.Splice(lru.Begin(), lru, position[key]);
+      benchmark::DoNotOptimize(lru.Back()->key);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * trace.size());
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_IntrusiveListTraverse(benchmark::State& state) {
+  auto pool = ConstructPool(state.range(0));
+  IntrusiveList<Entry, &Entry::hook> list;
+  for (auto& entry : pool) {
+    list.PushBack(entry);
+  }
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (auto it = list.Begin(); it != list.End(); ++it) {
+      sum += it->key;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_IntrusiveForwardListTraverse(benchmark::State& state) {
+  auto pool = ConstructPool(state.range(0));
+  IntrusiveForwardList<Entry, &Entry::forward_hook> list;
+  for (auto& entry : pool) {
+    list.PushFront(entry);
+  }
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (auto it = list.Begin(); it != list.End(); ++it) {
+      sum += it->key;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_CustomListTraverse(benchmark::State& state) {
+  auto pool = ConstructPool(state.range(0));
+  List<Entry*> list;
+  for (auto& entry : pool) {
+    list.PushBack(&entry);
+  }
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (auto it = list.Begin(); it != list.End(); ++it) {
+      sum += (*it)->key;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetComplexityN(state.range(0));
+}
+
+
+BENCHMARK(BM_IntrusiveListMoveToFront)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_CustomListMoveToFront)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_CustomListSpliceToFront)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_IntrusiveListTraverse)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_IntrusiveForwardListTraverse)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CustomListTraverse)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMillisecond);
+
+
+BENCHMARK_MAIN();
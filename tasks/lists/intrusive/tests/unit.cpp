@@ -0,0 +1,245 @@
+#include <list>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fmt/core.h>
+#include <gtest/gtest.h>
+
+#include "../intrusive_list.hpp"
+#include "../intrusive_forward_list.hpp"
+
+struct Item {
+  explicit Item(int v) : value(v) {
+  }
+
+  bool operator==(const Item& other) const {
+    return value == other.value;
+  }
+
+  int value;
+  IntrusiveListHook hook;
+  IntrusiveListHook other_hook;
+  IntrusiveForwardListHook forward_hook;
+};
+
+using ItemList = IntrusiveList<Item, &Item::hook>;
+using OtherItemList = IntrusiveList<Item, &Item::other_hook>;
+using ItemForwardList = IntrusiveForwardList<Item, &Item::forward_hook>;
+
+std::vector<int> Values(const ItemList& list) {
+  std::vector<int> values;
+  for (auto it = list.Begin(); it != list.End(); ++it) {
+    values.push_back(it->value);
+  }
+  return values;
+}
+
+
+TEST(IntrusiveListTest, PushAndPop) {
+  Item a(1), b(2), c(3);
+  ItemList list;
+  ASSERT_TRUE(list.IsEmpty());
+  list.PushBack(b);
+  list.PushBack(c);
+  list.PushFront(a);
+  ASSERT_EQ(list.Size(), 3);
+  ASSERT_EQ(&list.Front(), &a);
+  ASSERT_EQ(&list.Back(), &c);
+  ASSERT_TRUE(b.hook.IsLinked());
+
+  list.PopFront();
+  list.PopBack();
+  ASSERT_FALSE(a.hook.IsLinked());
+  ASSERT_FALSE(c.hook.IsLinked());
+  ASSERT_EQ(&list.Front(), &b);
+  list.PopBack();
+  EXPECT_THROW({
+    list.PopBack();
+  }, ListIsEmptyException);
+  EXPECT_THROW({
+    list.PopFront();
+  }, ListIsEmptyException);
+}
+
+TEST(IntrusiveListTest, EraseAnyElement) {
+  std::vector<Item> items;
+  for (int i = 0; i < 5; ++i) {
+    items.emplace_back(i);
+  }
+  ItemList list;
+  for (auto& item : items) {
+    list.PushBack(item);
+  }
+  list.Erase(items[2]);
+  list.Erase(list.IteratorTo(items[0]));
+  list.Erase(items[4]);
+  ASSERT_EQ(Values(list), (std::vector<int>{1, 3}));
+  ASSERT_EQ(list.Size(), 2);
+
+  auto it = list.End();
+  ASSERT_EQ((--it)->value, 3);
+  ASSERT_EQ((--it)->value, 1);
+  ASSERT_TRUE(it == list.Begin());
+}
+
+TEST(IntrusiveListTest, ElementInTwoLists) {
+  Item a(1), b(2), c(3);
+  ItemList list;
+  OtherItemList other;
+  list.PushBack(a);
+  list.PushBack(b);
+  list.PushBack(c);
+  other.PushBack(c);
+  other.PushBack(a);
+  list.Erase(a);
+  ASSERT_EQ(Values(list), (std::vector<int>{2, 3}));
+  ASSERT_EQ(&other.Back(), &a);
+  ASSERT_TRUE(a.other_hook.IsLinked());
+}
+
+TEST(IntrusiveListTest, MoveBeforeAndFind) {
+  std::vector<Item> items;
+  for (int i = 0; i < 4; ++i) {
+    items.emplace_back(i);
+  }
+  ItemList list;
+  for (auto& item : items) {
+    list.PushBack(item);
+  }
+  list.MoveBefore(list.Begin(), items[3]);
+  list.MoveBefore(list.End(), items[0]);
+  list.MoveBefore(list.IteratorTo(items[1]), items[1]);
+  ASSERT_EQ(Values(list), (std::vector<int>{3, 1, 2, 0}));
+  ASSERT_EQ(list.Find(Item(2)), list.IteratorTo(items[2]));
+  ASSERT_EQ(list.Find(Item(7)), list.End());
+}
+
+TEST(IntrusiveListTest, SwapAndClear) {
+  Item a(1), b(2), c(3);
+  ItemList list;
+  ItemList other;
+  list.PushBack(a);
+  list.PushBack(b);
+  other.PushBack(c);
+  std::swap(list, other);
+  ASSERT_EQ(Values(list), (std::vector<int>{3}));
+  ASSERT_EQ(Values(other), (std::vector<int>{1, 2}));
+  ASSERT_EQ(&(*--other.End()), &b);
+
+  other.Clear();
+  ASSERT_TRUE(other.IsEmpty());
+  ASSERT_FALSE(a.hook.IsLinked());
+  other.PushBack(a);
+  ASSERT_EQ(other.Size(), 1);
+}
+
+TEST(IntrusiveListTest, CopiedElementIsNotLinked) {
+  Item a(1);
+  ItemList list;
+  list.PushBack(a);
+  Item copy = a;
+  ASSERT_FALSE(copy.hook.IsLinked());
+  list.PushBack(copy);
+  ASSERT_EQ(list.Size(), 2);
+}
+
+// Hooks after non-trivial members, in a polymorphic type
+struct Named {
+  explicit Named(std::string n) : name(std::move(n)) {
+  }
+
+  virtual ~Named() = default;
+
+  std::string name;
+  IntrusiveListHook hook;
+  IntrusiveForwardListHook forward_hook;
+};
+
+TEST(IntrusiveListTest, NonTrivialElement) {
+  Named a("a"), b("b");
+  IntrusiveList<Named, &Named::hook> list;
+  IntrusiveForwardList<Named, &Named::forward_hook> forward;
+  list.PushBack(a);
+  list.PushBack(b);
+  forward.PushFront(a);
+  forward.PushFront(b);
+  ASSERT_EQ(&list.Front(), &a);
+  ASSERT_EQ(list.Begin()->name, "a");
+  ASSERT_EQ(&list.Back(), &b);
+  ASSERT_EQ(&forward.Front(), &b);
+  ASSERT_EQ(std::next(forward.Begin())->name, "a");
+}
+
+TEST(IntrusiveListTest, RandomOperationsMatchStdList) {
+  std::mt19937 mt(7);
+  std::vector<Item> items;
+  for (int i = 0; i < 200; ++i) {
+    items.emplace_back(i);
+  }
+  ItemList list;
+  std::list<int> expected;
+  for (int step = 0; step < 5000; ++step) {
+    auto& item = items[mt() % items.size()];
+    if (item.hook.IsLinked()) {
+      list.Erase(item);
+      expected.remove(item.value);
+    } else if (mt() % 2 == 0) {
+      list.PushFront(item);
+      expected.push_front(item.value);
+    } else {
+      list.PushBack(item);
+      expected.push_back(item.value);
+    }
+  }
+  ASSERT_EQ(list.Size(), expected.size());
+  ASSERT_EQ(Values(list), std::vector<int>(expected.begin(), expected.end()));
+}
+
+TEST(IntrusiveForwardListTest, PushPopAndInsert) {
+  Item a(1), b(2), c(3), d(4);
+  ItemForwardList list;
+  list.PushFront(c);
+  list.PushFront(a);
+  list.InsertAfter(list.Begin(), b);
+  list.InsertAfter(list.IteratorTo(c), d);
+  ASSERT_EQ(list.Size(), 4);
+  int expected = 1;
+  for (auto it = list.Begin(); it != list.End(); it++) {
+    ASSERT_EQ(it->value, expected++);
+  }
+
+  list.EraseAfter(list.IteratorTo(b));
+  list.PopFront();
+  ASSERT_EQ(&list.Front(), &b);
+  ASSERT_EQ(&*++list.Begin(), &d);
+  ASSERT_EQ(list.Find(Item(4)), list.IteratorTo(d));
+  ASSERT_EQ(list.Find(Item(3)), list.End());
+
+  list.PopFront();
+  list.PopFront();
+  EXPECT_THROW({
+    list.PopFront();
+  }, ListIsEmptyException);
+}
+
+TEST(IntrusiveForwardListTest, SwapAndClear) {
+  Item a(1), b(2);
+  ItemForwardList list;
+  ItemForwardList other;
+  list.PushFront(a);
+  other.PushFront(b);
+  std::swap(list, other);
+  ASSERT_EQ(&list.Front(), &b);
+  ASSERT_EQ(&other.Front(), &a);
+  list.Clear();
+  ASSERT_TRUE(list.IsEmpty());
+  ASSERT_EQ(list.Begin(), list.End());
+}
+
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
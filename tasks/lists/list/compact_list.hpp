@@ -0,0 +1,353 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include <fmt/core.h>
+
+#include "exceptions.hpp"
+
+// Doubly linked list which keeps all nodes in one growable array
+// and links them with 32-bit indices instead of pointers.
+//
+// A node of CompactList<int> takes 12 bytes instead of 32 in List (24 for the node
+// and 8 for the pointer to its slab), and all nodes stay in one block of memory
+// however long the list is churned. Erased nodes go to a free list and are reused first.
+//
+// Iterators are (list, index) pairs, so growing the array doesn't invalidate them:
+// only Erase invalidates iterators to the erased element, like in List.
+template <typename T>
+class CompactList{
+private:
+  using Index = uint32_t;
+
+  // Index of the sentinel. Nodes are numbered from 1
+  static constexpr Index END = 0;
+  // prev_ of a node in the free list
+  static constexpr Index FREE = std::numeric_limits<Index>::max();
+  static constexpr size_t MIN_CAPACITY = 16;
+
+  class Node{
+    friend class CompactList;
+
+    private:
+      inline T* Value() noexcept {
+        return std::launder(reinterpret_cast<T*>(storage_));
+      }
+
+      inline void* Storage() noexcept {
+        return storage_;
+      }
+
+    private:
+      Index prev_ = END;
+      Index next_ = END;
+      alignas(T) unsigned char storage_[sizeof(T)];
+  };
+
+public:
+  class CompactListIterator{
+    friend class CompactList;
+
+    public:
+      using value_type = T;
+      using reference_type = value_type&;
+      using pointer_type = value_type*;
+      using reference = reference_type;
+      using pointer = pointer_type;
+      using difference_type = std::ptrdiff_t;
+      using iterator_category = std::bidirectional_iterator_tag;
+
+      inline bool operator==(const CompactListIterator& other) const {
+          return current == other.current;
+      };
+
+      inline bool operator!=(const CompactListIterator& other) const {
+          return current != other.current;
+      };
+
+      inline reference_type operator*() const {
+          return *list->nodes_[current].Value();
+      };
+
+      CompactListIterator& operator++() {
+          current = list->nodes_[current].next_;
+          return *this;
+      };
+
+      CompactListIterator operator++(int) {
+          CompactListIterator old = *this;
+          ++*this;
+          return old;
+      };
+
+      CompactListIterator& operator--() {
+          current = list->nodes_[current].prev_;
+          return *this;
+      };
+
+      CompactListIterator operator--(int) {
+          CompactListIterator old = *this;
+          --*this;
+          return old;
+      };
+
+      inline pointer_type operator->() const {
+          return list->nodes_[current].Value();
+      };
+
+  private:
+      CompactListIterator(const CompactList* owner, Index index) : list(owner), current(index) {
+      }
+  private:
+      const CompactList* list;
+      Index current;
+  };
+
+public:
+  CompactList() {
+  }
+
+  explicit CompactList(size_t sz) {
+    Reserve(sz);
+    while (sz--) {
+      PushBack(T());
+    }
+  }
+
+  CompactList(const std::initializer_list<T>& values) {
+    Reserve(values.size());
+    for (const auto& value : values) {
+      PushBack(value);
+    }
+  }
+
+  // The copy is compact: its nodes go in list order
+  CompactList(const CompactList& other) {
+    Reserve(other.Size());
+    for (auto it = other.Begin(); it != other.End(); ++it) {
+      PushBack(*it);
+    }
+  }
+
+  CompactList& operator=(const CompactList& other) {
+    if (this != &other) {
+      CompactList copy(other);
+      Swap(copy);
+    }
+    return *this;
+  }
+
+  CompactListIterator Begin() const noexcept {
+    return CompactListIterator(this, size_ == 0 ? END : nodes_[END].next_);
+  }
+
+  CompactListIterator End() const noexcept {
+    return CompactListIterator(this, END);
+  }
+
+  inline T& Front() const {
+    return *Begin();
+  }
+
+  inline T& Back() const {
+    return *--End();
+  }
+
+  inline bool IsEmpty() const noexcept {
+    return size_ == 0;
+  }
+
+  inline size_t Size() const noexcept {
+    return size_;
+  }
+
+  // Elements the list can hold without growing the array
+  inline size_t Capacity() const noexcept {
+    return capacity_ == 0 ? 0 : capacity_ - 1;
+  }
+
+  void Reserve(size_t count) {
+    if (count >= MAX_CAPACITY) {
+      throw std::length_error("CompactList is too long");
+    }
+    if (count + 1 > capacity_) {
+      Reallocate(count + 1);
+    }
+  }
+
+  void Swap(CompactList& a) noexcept {
+    std::swap(nodes_, a.nodes_);
+    std::swap(capacity_, a.capacity_);
+    std::swap(used_, a.used_);
+    std::swap(free_, a.free_);
+    std::swap(size_, a.size_);
+  }
+
+  CompactListIterator Find(const T& value) const {
+    for (auto it = Begin(); it != End(); ++it) {
+      if (*it == value) {
+        return it;
+      }
+    }
+    return End();
+  }
+
+  void Erase(CompactListIterator pos) {
+    Index index = pos.current;
+    Node& node = nodes_[index];
+    nodes_[node.prev_].next_ = node.next_;
+    nodes_[node.next_].prev_ = node.prev_;
+    std::destroy_at(node.Value());
+    node.prev_ = FREE;
+    node.next_ = free_;
+    free_ = index;
+    --size_;
+  }
+
+  void Insert(CompactListIterator pos, const T& value) {
+    Index next = pos.current;
+    Index index = AcquireNode(value);
+    Node& node = nodes_[index];
+    node.prev_ = nodes_[next].prev_;
+    node.next_ = next;
+    nodes_[node.prev_].next_ = index;
+    nodes_[next].prev_ = index;
+    ++size_;
+  }
+
+  // Keeps the array for new elements
+  void Clear() noexcept {
+    DestroyValues();
+    if (nodes_ != nullptr) {
+      nodes_[END].prev_ = nodes_[END].next_ = END;
+    }
+    used_ = 1;
+    free_ = END;
+    size_ = 0;
+  }
+
+  void PushBack(const T& value) {
+    Insert(End(), value);
+  }
+
+  void PushFront(const T& value) {
+    Insert(Begin(), value);
+  }
+
+  void PopBack() {
+    if (IsEmpty()) {
+      throw ListIsEmptyException("PopBack from empty list");
+    }
+    Erase(--End());
+  }
+
+  void PopFront() {
+    if (IsEmpty()) {
+      throw ListIsEmptyException("PopFront from empty list");
+    }
+    Erase(Begin());
+  }
+
+  ~CompactList() {
+    DestroyValues();
+    ::operator delete(nodes_, std::align_val_t{alignof(Node)});
+  }
+
+private:
+  // Constructs value in a free node and returns its index, links are the caller's business
+  Index AcquireNode(const T& value) {
+    if (free_ != END) {
+      Index index = free_;
+      new (nodes_[index].Storage()) T(value);
+      free_ = nodes_[index].next_;
+      return index;
+    }
+    if (used_ >= capacity_) {
+      if (capacity_ == MAX_CAPACITY) {
+        throw std::length_error("CompactList is too long");
+      }
+      // value may refer to an element of this list, copy it before moving the array
+      T copy = value;
+      Reallocate(std::min(MAX_CAPACITY, std::max(MIN_CAPACITY, capacity_ * 2)));
+      new (nodes_[used_].Storage()) T(std::move(copy));
+    } else {
+      new (nodes_[used_].Storage()) T(value);
+    }
+    return static_cast<Index>(used_++);
+  }
+
+  // Moves nodes to a new array keeping their indices
+  void Reallocate(size_t capacity) {
+    auto* nodes = static_cast<Node*>(::operator new(capacity * sizeof(Node), std::align_val_t{alignof(Node)}));
+    if (nodes_ == nullptr) {
+      new (nodes) Node();
+      nodes_ = nodes;
+      capacity_ = capacity;
+      return;
+    }
+
+    new (nodes) Node();
+    size_t moved = 1;
+    try {
+      for (; moved < used_; ++moved) {
+        new (nodes + moved) Node();
+        if (nodes_[moved].prev_ != FREE) {
+          new (nodes[moved].Storage()) T(std::move_if_noexcept(*nodes_[moved].Value()));
+        }
+      }
+    } catch (...) {
+      for (size_t i = 1; i < moved; ++i) {
+        if (nodes_[i].prev_ != FREE) {
+          std::destroy_at(nodes[i].Value());
+        }
+      }
+      ::operator delete(nodes, std::align_val_t{alignof(Node)});
+      throw;
+    }
+
+    for (size_t i = 0; i < used_; ++i) {
+      nodes[i].prev_ = nodes_[i].prev_;
+      nodes[i].next_ = nodes_[i].next_;
+    }
+    DestroyValues();
+    ::operator delete(nodes_, std::align_val_t{alignof(Node)});
+    nodes_ = nodes;
+    capacity_ = capacity;
+  }
+
+  void DestroyValues() noexcept {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      for (Index index = Begin().current; index != END; index = nodes_[index].next_) {
+        std::destroy_at(nodes_[index].Value());
+      }
+    }
+  }
+
+private:
+  static constexpr size_t MAX_CAPACITY = size_t{FREE};
+
+  Node* nodes_ = nullptr;
+  // Nodes [0, used_) have been in use, the rest of capacity_ never were
+  size_t capacity_ = 0;
+  size_t used_ = 1;
+  Index free_ = END;
+  size_t size_ = 0;
+};
+
+
+namespace std {
+  // Global swap overloading
+  template <typename T>
+  void swap(CompactList<T>& a, CompactList<T>& b) {
+    a.Swap(b);
+  }
+}
@@ -9,9 +9,9 @@ public:
     }
 
     const char* what() const noexcept override {
-        return error_message_.data();
+        return error_message_.c_str();
     }
 
 private:
-    std::string_view error_message_;
+    std::string error_message_;
 };
\ No newline at end of file
@@ -0,0 +1,421 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#include <fmt/core.h>
+
+#include "exceptions.hpp"
+
+// Sequence on a skip list (W. Pugh, 1990) whose forward links also store their width:
+// how many positions they jump over. Summing widths on the way down gives the position,
+// so At, InsertAt, EraseAt, IteratorAt and IndexOf take O(log N) expected time.
+//
+// Level 0 is a doubly linked ring through a head sentinel, like in List: iterators
+// are bidirectional, ++ and -- are O(1), End() is the head. Links past the last node
+// at upper levels also point to the head.
+//
+// Positions in the public API are 0-based. Inside, the head has index 0,
+// the elements 1..Size() and the head, as the end of every level, Size() + 1.
+template <typename T>
+class IndexedSkipList{
+private:
+  static constexpr size_t MAX_HEIGHT = 32;
+
+  class BaseNode;
+
+  struct Link {
+    BaseNode* next;
+    size_t width;
+  };
+
+  class BaseNode{
+    friend class IndexedSkipList;
+
+    private:
+      BaseNode* prev_ = this;
+      // height_ links, stored right after the node
+      Link* links_ = nullptr;
+      size_t height_ = 0;
+  };
+
+  class Node : public BaseNode{
+    friend class IndexedSkipList;
+
+    public:
+      explicit Node(const T& value) : value_(value) {
+      }
+
+    private:
+      T value_;
+  };
+
+  static constexpr size_t LINKS_OFFSET = (sizeof(Node) + alignof(Link) - 1) / alignof(Link) * alignof(Link);
+  static constexpr size_t NODE_ALIGNMENT = std::max(alignof(Node), alignof(Link));
+
+public:
+  class IndexedSkipListIterator{
+    friend class IndexedSkipList;
+
+    public:
+      using value_type = T;
+      using reference_type = value_type&;
+      using pointer_type = value_type*;
+      using reference = reference_type;
+      using pointer = pointer_type;
+      using difference_type = std::ptrdiff_t;
+      using iterator_category = std::bidirectional_iterator_tag;
+
+      inline bool operator==(const IndexedSkipListIterator& other) const {
+          return current == other.current;
+      };
+
+      inline bool operator!=(const IndexedSkipListIterator& other) const {
+          return current != other.current;
+      };
+
+      inline reference_type operator*() const {
+          return static_cast<Node*>(current)->value_;
+      };
+
+      IndexedSkipListIterator& operator++() {
+          current = current->links_[0].next;
+          return *this;
+      };
+
+      IndexedSkipListIterator operator++(int) {
+          IndexedSkipListIterator old = *this;
+          ++*this;
+          return old;
+      };
+
+      IndexedSkipListIterator& operator--() {
+          current = current->prev_;
+          return *this;
+      };
+
+      IndexedSkipListIterator operator--(int) {
+          IndexedSkipListIterator old = *this;
+          --*this;
+          return old;
+      };
+
+      inline pointer_type operator->() const {
+          return &static_cast<Node*>(current)->value_;
+      };
+
+  private:
+      explicit IndexedSkipListIterator(const BaseNode* node) : current(const_cast<BaseNode*>(node)) {
+      }
+  private:
+      BaseNode* current;
+  };
+
+public:
+  IndexedSkipList() {
+  }
+
+  explicit IndexedSkipList(size_t sz) {
+    while (sz--) {
+      PushBack(T());
+    }
+  }
+
+  IndexedSkipList(const std::initializer_list<T>& values) {
+    for (const auto& value : values) {
+      PushBack(value);
+    }
+  }
+
+  IndexedSkipList(const IndexedSkipList& other) {
+    for (auto it = other.Begin(); it != other.End(); ++it) {
+      PushBack(*it);
+    }
+  }
+
+  IndexedSkipList& operator=(const IndexedSkipList& other) {
+    if (this != &other) {
+      IndexedSkipList copy(other);
+      Swap(copy);
+    }
+    return *this;
+  }
+
+  IndexedSkipListIterator Begin() const noexcept {
+    return IndexedSkipListIterator(head_->links_[0].next);
+  }
+
+  IndexedSkipListIterator End() const noexcept {
+    return IndexedSkipListIterator(head_);
+  }
+
+  inline T& Front() const {
+    return *Begin();
+  }
+
+  inline T& Back() const {
+    return *--End();
+  }
+
+  inline bool IsEmpty() const noexcept {
+    return size_ == 0;
+  }
+
+  inline size_t Size() const noexcept {
+    return size_;
+  }
+
+  void Swap(IndexedSkipList& a) noexcept {
+    std::swap(head_, a.head_);
+    std::swap(height_, a.height_);
+    std::swap(size_, a.size_);
+    std::swap(random_, a.random_);
+  }
+
+  T& At(size_t pos) const {
+    if (pos >= size_) {
+      throw std::out_of_range(fmt::format("Position {} is out of list of size {}", pos, size_));
+    }
+    return static_cast<Node*>(NodeAt(pos + 1))->value_;
+  }
+
+  // Iterator to the element at pos, End() for pos == Size()
+  IndexedSkipListIterator IteratorAt(size_t pos) const {
+    if (pos > size_) {
+      throw std::out_of_range(fmt::format("Position {} is out of list of size {}", pos, size_));
+    }
+    return IndexedSkipListIterator(pos == size_ ? head_ : NodeAt(pos + 1));
+  }
+
+  // Position of it, Size() for End()
+  size_t IndexOf(IndexedSkipListIterator it) const noexcept {
+    // Highest links of the nodes on the way lead to the head in O(log N) steps
+    size_t to_end = 0;
+    for (BaseNode* node = it.current; node != head_;) {
+      const Link& link = node->links_[node->height_ - 1];
+      to_end += link.width;
+      node = link.next;
+    }
+    return size_ - to_end;
+  }
+
+  IndexedSkipListIterator Find(const T& value) const {
+    for (auto it = Begin(); it != End(); ++it) {
+      if (*it == value) {
+        return it;
+      }
+    }
+    return End();
+  }
+
+  // Inserts value before position pos, pos == Size() appends
+  void InsertAt(size_t pos, const T& value) {
+    if (pos > size_) {
+      throw std::out_of_range(fmt::format("Position {} is out of list of size {}", pos, size_));
+    }
+    size_t index = pos + 1;
+    BaseNode* update[MAX_HEIGHT];
+    size_t update_index[MAX_HEIGHT];
+    FindPredecessors(index, update, update_index);
+
+    size_t height = RandomHeight();
+    Node* node = CreateNode(value, height);
+    if (height > height_) {
+      for (size_t level = height_; level < height; ++level) {
+        head_->links_[level] = {head_, size_ + 1};
+        update[level] = head_;
+        update_index[level] = 0;
+      }
+      height_ = height;
+    }
+
+    for (size_t level = 0; level < height_; ++level) {
+      Link& link = update[level]->links_[level];
+      if (level < height) {
+        // The node after the link moves one position right
+        node->links_[level] = {link.next, update_index[level] + link.width + 1 - index};
+        link = {node, index - update_index[level]};
+      } else {
+        ++link.width;
+      }
+    }
+
+    BaseNode* next = node->links_[0].next;
+    node->prev_ = update[0];
+    next->prev_ = node;
+    ++size_;
+  }
+
+  void EraseAt(size_t pos) {
+    if (pos >= size_) {
+      throw std::out_of_range(fmt::format("Position {} is out of list of size {}", pos, size_));
+    }
+    size_t index = pos + 1;
+    BaseNode* update[MAX_HEIGHT];
+    size_t update_index[MAX_HEIGHT];
+    FindPredecessors(index, update, update_index);
+
+    BaseNode* node = update[0]->links_[0].next;
+    for (size_t level = 0; level < height_; ++level) {
+      Link& link = update[level]->links_[level];
+      if (level < node->height_) {
+        link = {node->links_[level].next, link.width + node->links_[level].width - 1};
+      } else {
+        --link.width;
+      }
+    }
+    node->links_[0].next->prev_ = update[0];
+    while (height_ > 1 && head_->links_[height_ - 1].next == head_) {
+      --height_;
+    }
+    --size_;
+    DestroyNode(node);
+  }
+
+  void Erase(IndexedSkipListIterator pos) {
+    EraseAt(IndexOf(pos));
+  }
+
+  // Inserts value before pos
+  void Insert(IndexedSkipListIterator pos, const T& value) {
+    InsertAt(IndexOf(pos), value);
+  }
+
+  void Clear() noexcept {
+    BaseNode* node = head_->links_[0].next;
+    while (node != head_) {
+      BaseNode* next = node->links_[0].next;
+      DestroyNode(node);
+      node = next;
+    }
+    ResetHead();
+    size_ = 0;
+  }
+
+  void PushBack(const T& value) {
+    InsertAt(size_, value);
+  }
+
+  void PushFront(const T& value) {
+    InsertAt(0, value);
+  }
+
+  void PopBack() {
+    if (IsEmpty()) {
+      throw ListIsEmptyException("PopBack from empty list");
+    }
+    EraseAt(size_ - 1);
+  }
+
+  void PopFront() {
+    if (IsEmpty()) {
+      throw ListIsEmptyException("PopFront from empty list");
+    }
+    EraseAt(0);
+  }
+
+  ~IndexedSkipList() {
+    Clear();
+    head_->~BaseNode();
+    ::operator delete(head_, std::align_val_t{NODE_ALIGNMENT});
+  }
+
+private:
+  static BaseNode* CreateHead() {
+    void* memory = ::operator new(LINKS_OFFSET + MAX_HEIGHT * sizeof(Link), std::align_val_t{NODE_ALIGNMENT});
+    auto* head = new (memory) BaseNode();
+    head->links_ = reinterpret_cast<Link*>(static_cast<std::byte*>(memory) + LINKS_OFFSET);
+    head->height_ = MAX_HEIGHT;
+    return head;
+  }
+
+  static Node* CreateNode(const T& value, size_t height) {
+    void* memory = ::operator new(LINKS_OFFSET + height * sizeof(Link), std::align_val_t{NODE_ALIGNMENT});
+    Node* node;
+    try {
+      node = new (memory) Node(value);
+    } catch (...) {
+      ::operator delete(memory, std::align_val_t{NODE_ALIGNMENT});
+      throw;
+    }
+    node->links_ = reinterpret_cast<Link*>(static_cast<std::byte*>(memory) + LINKS_OFFSET);
+    node->height_ = height;
+    return node;
+  }
+
+  static void DestroyNode(BaseNode* node) noexcept {
+    static_cast<Node*>(node)->~Node();
+    ::operator delete(node, std::align_val_t{NODE_ALIGNMENT});
+  }
+
+  void ResetHead() noexcept {
+    head_->prev_ = head_;
+    head_->links_[0] = {head_, 1};
+    height_ = 1;
+  }
+
+  // Heights 1, 2, 3, ... with probabilities 3/4, 3/16, 3/64, ...
+  size_t RandomHeight() noexcept {
+    // xorshift64
+    random_ ^= random_ << 13;
+    random_ ^= random_ >> 7;
+    random_ ^= random_ << 17;
+    size_t height = 1 + std::countr_zero(random_ | (uint64_t{1} << 62)) / 2;
+    return std::min(height, MAX_HEIGHT);
+  }
+
+  // The node with the given index, 1 <= index <= Size()
+  BaseNode* NodeAt(size_t index) const noexcept {
+    BaseNode* node = head_;
+    size_t node_index = 0;
+    for (size_t level = height_; level-- > 0;) {
+      while (node_index + node->links_[level].width <= index) {
+        node_index += node->links_[level].width;
+        node = node->links_[level].next;
+      }
+      if (node_index == index) {
+        break;
+      }
+    }
+    return node;
+  }
+
+  // Fills update[level] with the last node before index on every level in use and its index
+  void FindPredecessors(size_t index, BaseNode** update, size_t* update_index) const noexcept {
+    BaseNode* node = head_;
+    size_t node_index = 0;
+    for (size_t level = height_; level-- > 0;) {
+      while (node_index + node->links_[level].width < index) {
+        node_index += node->links_[level].width;
+        node = node->links_[level].next;
+      }
+      update[level] = node;
+      update_index[level] = node_index;
+    }
+  }
+
+private:
+  BaseNode* head_ = [] {
+    BaseNode* head = CreateHead();
+    head->links_[0] = {head, 1};
+    return head;
+  }();
+  size_t height_ = 1;
+  size_t size_ = 0;
+  uint64_t random_ = 0x9E3779B97F4A7C15ull;
+};
+
+
+namespace std {
+  // Global swap overloading
+  template <typename T>
+  void swap(IndexedSkipList<T>& a, IndexedSkipList<T>& b) {
+    a.Swap(b);
+  }
+}
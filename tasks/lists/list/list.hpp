@@ -8,158 +8,544 @@
 
 #include <fmt/core.h>
 
+#include "exceptions.hpp"
+#include "node_cache.hpp"
+
 template <typename T>
 class List{
 private:
-  class Node{
-    friend class ListIterator;
+  // Links only. The list keeps one of them as a sentinel: End() points to it,
+  // so the list is a ring and Begin() == End() when it is empty.
+  class BaseNode{
     friend class List;
-    /*???*/
 
     private:
-      /*???*/
+      BaseNode* prev_ = this;
+      BaseNode* next_ = this;
+  };
+
+  class Node : public BaseNode{
+    friend class List;
+
+    public:
+      template <typename... Args>
+      explicit Node(Args&&... args) : value_(std::forward<Args>(args)...) {
+      }
 
+    private:
+      T value_;
   };
 
 public:
   class ListIterator{
+    friend class List;
+
     public:
       using value_type = T;
       using reference_type = value_type&;
       using pointer_type = value_type*;
+      using reference = reference_type;
+      using pointer = pointer_type;
       using difference_type = std::ptrdiff_t;
       using iterator_category = std::bidirectional_iterator_tag;
 
-      inline bool operator==(const ListIterator&) const {
-          std::abort(); // Not implemented
+      inline bool operator==(const ListIterator& other) const {
+          return current == other.current;
       };
 
-      inline bool operator!=(const ListIterator&) const {
-          std::abort(); // Not implemented
+      inline bool operator!=(const ListIterator& other) const {
+          return current != other.current;
       };
 
       inline reference_type operator*() const {
-          std::abort(); // Not implemented
+          return static_cast<Node*>(current)->value_;
       };
 
       ListIterator& operator++() {
-          std::abort(); // Not implemented
+          current = current->next_;
+          return *this;
       };
 
       ListIterator operator++(int) {
-          std::abort(); // Not implemented
+          ListIterator old = *this;
+          current = current->next_;
+          return old;
       };
 
       ListIterator& operator--() {
-          std::abort(); // Not implemented
+          current = current->prev_;
+          return *this;
       };
 
       ListIterator operator--(int) {
-          std::abort(); // Not implemented
+          ListIterator old = *this;
+          current = current->prev_;
+          return old;
       };
 
-      /*The overload of operator -> must either return a raw pointer, 
-      or return an object (by reference or by value) for which 
+      /*The overload of operator -> must either return a raw pointer,
+      or return an object (by reference or by value) for which
       operator -> is in turn overloaded.*/
       inline pointer_type operator->() const {
-          std::abort(); // Not implemented
+          return &static_cast<Node*>(current)->value_;
       };
 
   private:
-      ListIterator(const Node*) {
-          // Not implemented
+      explicit ListIterator(const BaseNode* node) : current(const_cast<BaseNode*>(node)) {
       }
   private:
-      Node* current;
+      BaseNode* current;
   };
 
 public:
   List() {
-    // Not implemented
   }
 
-  explicit List(size_t /*sz*/) {
-    // Not implemented
+  explicit List(size_t sz) {
+    while (sz--) {
+      PushBack(T());
+    }
   }
 
-  List(const std::initializer_list<T>& /*values*/) {
-    // Not implemented
+  List(const std::initializer_list<T>& values) {
+    for (const auto& value : values) {
+      PushBack(value);
+    }
   }
 
-  List(const List& /*other*/) {
-    // Not implemented
+  List(const List& other) {
+    for (auto it = other.Begin(); it != other.End(); ++it) {
+      PushBack(*it);
+    }
   }
 
-  List& operator=(const List& /*other*/) {
-    std::abort(); // Not implemented
+  // Reuses nodes of this list through the cache. The copies are made before
+  // the old elements are destroyed, so if copying throws, the list is left as it was
+  List& operator=(const List& other) {
+    if (this != &other) {
+      BaseNode copies;
+      BaseNode* tail = &copies;
+      try {
+        for (auto it = other.Begin(); it != other.End(); ++it) {
+          BaseNode* node = CreateNode(*it);
+          node->prev_ = tail;
+          tail->next_ = node;
+          tail = node;
+        }
+      } catch (...) {
+        while (tail != &copies) {
+          BaseNode* prev = tail->prev_;
+          DestroyNode(tail);
+          tail = prev;
+        }
+        throw;
+      }
+      Clear();
+      if (tail != &copies) {
+        end_.next_ = copies.next_;
+        end_.next_->prev_ = &end_;
+        end_.prev_ = tail;
+        tail->next_ = &end_;
+        size_ = other.size_;
+      }
+    }
+    return *this;
   }
 
   ListIterator Begin() const noexcept {
-    std::abort(); // Not implemented
+    return ListIterator(end_.next_);
   }
 
   ListIterator End() const noexcept {
-    std::abort(); // Not implemented
+    return ListIterator(&end_);
   }
 
   inline T& Front() const {
-    std::abort(); // Not implemented
+    return *Begin();
   }
 
   inline T& Back() const {
-    std::abort(); // Not implemented
+    return *--End();
   }
 
   inline bool IsEmpty() const noexcept {
-    std::abort(); // Not implemented
+    return size_ == 0;
   }
 
   inline size_t Size() const noexcept {
-    std::abort(); // Not implemented
+    return size_;
   }
 
-  void Swap(List& /*a*/) {
-    // Not implemented
+  void Swap(List& a) {
+    std::swap(end_, a.end_);
+    std::swap(size_, a.size_);
+    cache_.Swap(a.cache_);
+    a.FixSentinel();
+    FixSentinel();
+  }
+
+  ListIterator Find(const T& value) const {
+    for (auto it = Begin(); it != End(); ++it) {
+      if (*it == value) {
+        return it;
+      }
+    }
+    return End();
   }
 
-  ListIterator Find(const T& /*value*/) const {
-    std::abort(); // Not implemented
+  void Erase(ListIterator pos) {
+    BaseNode* node = pos.current;
+    Unlink(node);
+    DestroyNode(node);
   }
 
-  void Erase(ListIterator /*pos*/) {
-    // Not implemented
+  void Insert(ListIterator pos, const T& value) {
+    Emplace(pos, value);
   }
 
-  void Insert(ListIterator /*pos*/, const T& /*value*/) {
-    // Not implemented
+  void Insert(ListIterator pos, T&& value) {
+    Emplace(pos, std::move(value));
+  }
+
+  // Constructs the element from args right in its node before pos
+  template <typename... Args>
+  ListIterator Emplace(ListIterator pos, Args&&... args) {
+    Node* node = CreateNode(std::forward<Args>(args)...);
+    LinkBefore(pos.current, node);
+    return ListIterator(node);
   }
 
   void Clear() noexcept {
-    // Not implemented
+    BaseNode* node = end_.next_;
+    while (node != &end_) {
+      BaseNode* next = node->next_;
+      DestroyNode(node);
+      node = next;
+    }
+    end_.prev_ = end_.next_ = &end_;
+    size_ = 0;
+  }
+
+  void PushBack(const T& value) {
+    Emplace(End(), value);
   }
 
-  void PushBack(const T& /*value*/) {
-    // Not implemented
+  void PushBack(T&& value) {
+    Emplace(End(), std::move(value));
   }
 
-  void PushFront(const T& /*value*/) {
-    // Not implemented
+  void PushFront(const T& value) {
+    Emplace(Begin(), value);
+  }
+
+  void PushFront(T&& value) {
+    Emplace(Begin(), std::move(value));
+  }
+
+  template <typename... Args>
+  T& EmplaceBack(Args&&... args) {
+    return *Emplace(End(), std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  T& EmplaceFront(Args&&... args) {
+    return *Emplace(Begin(), std::forward<Args>(args)...);
   }
 
   void PopBack() {
-    // Not implemented
+    if (IsEmpty()) {
+      throw ListIsEmptyException("PopBack from empty list");
+    }
+    Erase(--End());
   }
 
   void PopFront() {
-    // Not implemented
+    if (IsEmpty()) {
+      throw ListIsEmptyException("PopFront from empty list");
+    }
+    Erase(Begin());
+  }
+
+  // Moves all elements of other before pos
+  void Splice(ListIterator pos, List& other) {
+    if (this == &other || other.IsEmpty()) {
+      return;
+    }
+    size_t count = other.size_;
+    Transfer(pos.current, other.end_.next_, &other.end_);
+    size_ += count;
+    other.size_ = 0;
+  }
+
+  // Moves the element at it from other before pos
+  void Splice(ListIterator pos, List& other, ListIterator it) {
+    BaseNode* node = it.current;
+    if (pos.current == node || pos.current == node->next_) {
+      return;
+    }
+    Transfer(pos.current, node, node->next_);
+    ++size_;
+    --other.size_;
+  }
+
+  // Moves [first, last) from other before pos. Relinking is O(1),
+  // but splicing from another list walks the range once to keep both sizes right
+  void Splice(ListIterator pos, List& other, ListIterator first, ListIterator last) {
+    if (first == last) {
+      return;
+    }
+    if (this != &other) {
+      size_t count = std::distance(first, last);
+      size_ += count;
+      other.size_ -= count;
+    }
+    Transfer(pos.current, first.current, last.current);
+  }
+
+  // Merges sorted other into this sorted list. Stable: equal elements of this go first
+  void Merge(List& other) {
+    Merge(other, std::less<T>());
+  }
+
+  template <typename Compare>
+  void Merge(List& other, Compare comp) {
+    if (this == &other) {
+      return;
+    }
+    BaseNode* node = end_.next_;
+    BaseNode* other_node = other.end_.next_;
+    while (node != &end_ && other_node != &other.end_) {
+      if (comp(ValueOf(other_node), ValueOf(node))) {
+        // Take the whole run of other which goes before node
+        BaseNode* run_end = other_node->next_;
+        while (run_end != &other.end_ && comp(ValueOf(run_end), ValueOf(node))) {
+          run_end = run_end->next_;
+        }
+        Transfer(node, other_node, run_end);
+        other_node = run_end;
+      } else {
+        node = node->next_;
+      }
+    }
+    if (other_node != &other.end_) {
+      Transfer(&end_, other_node, &other.end_);
+    }
+    size_ += other.size_;
+    other.size_ = 0;
+  }
+
+  // Stable bottom-up merge sort which relinks nodes and doesn't allocate
+  void Sort() {
+    Sort(std::less<T>());
+  }
+
+  template <typename Compare>
+  void Sort(Compare comp) {
+    if (size_ < 2) {
+      return;
+    }
+    // Work on a null-terminated chain of next_ links, prev_ links are restored at the end
+    BaseNode* rest = end_.next_;
+    end_.prev_->next_ = nullptr;
+
+    // sorted[i] holds a sorted chain of 2^i nodes, older chains in higher slots
+    BaseNode* sorted[SORT_SLOTS] = {};
+    while (rest != nullptr) {
+      BaseNode* carry = rest;
+      rest = rest->next_;
+      carry->next_ = nullptr;
+      size_t slot = 0;
+      while (sorted[slot] != nullptr) {
+        carry = MergeChains(sorted[slot], carry, comp);
+        sorted[slot++] = nullptr;
+      }
+      sorted[slot] = carry;
+    }
+
+    BaseNode* result = nullptr;
+    for (auto* chain : sorted) {
+      if (chain != nullptr) {
+        result = result == nullptr ? chain : MergeChains(chain, result, comp);
+      }
+    }
+
+    BaseNode* prev = &end_;
+    for (BaseNode* node = result; node != nullptr; node = node->next_) {
+      node->prev_ = prev;
+      prev->next_ = node;
+      prev = node;
+    }
+    prev->next_ = &end_;
+    end_.prev_ = prev;
+  }
+
+  // Erased nodes are kept for reuse: up to CacheLimit() of them,
+  // and all of those preallocated by Reserve
+  void SetCacheLimit(size_t limit) noexcept {
+    cache_.SetLimit(limit);
+  }
+
+  inline size_t CacheLimit() const noexcept {
+    return cache_.Limit();
+  }
+
+  // Elements the list can hold without allocating
+  inline size_t Capacity() const noexcept {
+    return size_ + cache_.CachedCount();
+  }
+
+  // Preallocates nodes for count elements in one slab
+  void Reserve(size_t count) {
+    if (count > size_) {
+      cache_.Reserve(count - size_);
+    }
+  }
+
+  // Returns cached nodes to the heap
+  void ShrinkToFit() noexcept {
+    cache_.ShrinkToFit();
+  }
+
+  // Moves all elements into one new slab in list order, so that traversal
+  // walks memory sequentially again. spare more nodes of the slab are cached
+  // for future inserts. Iterators are invalidated. If copying an element throws,
+  // the list is left as it was
+  void Compact(size_t spare = 0) {
+    if (size_ + spare == 0) {
+      return;
+    }
+    void* first = cache_.AllocateSlab(size_ + spare);
+    auto slab_node = [first](size_t index) {
+      return static_cast<Node*>(NodeCache<Node>::SlabNode(first, index));
+    };
+    size_t built = 0;
+    try {
+      for (BaseNode* node = end_.next_; node != &end_; node = node->next_, ++built) {
+        new (slab_node(built)) Node(std::move_if_noexcept(static_cast<Node*>(node)->value_));
+      }
+    } catch (...) {
+      for (size_t i = 0; i < built; ++i) {
+        slab_node(i)->~Node();
+      }
+      cache_.DeallocateSlab(first);
+      throw;
+    }
+
+    // The old nodes are freed: those allocated alone right away, slabs once they held only old nodes.
+    // Other cached nodes and reserved slabs stay
+    for (BaseNode* node = end_.next_; node != &end_;) {
+      BaseNode* next = node->next_;
+      static_cast<Node*>(node)->~Node();
+      cache_.Release(node);
+      node = next;
+    }
+    cache_.ReleaseEmptiedSlabs();
+
+    BaseNode* prev = &end_;
+    for (size_t i = 0; i < built; ++i) {
+      Node* node = slab_node(i);
+      node->prev_ = prev;
+      prev->next_ = node;
+      prev = node;
+    }
+    prev->next_ = &end_;
+    end_.prev_ = prev;
+    size_ = built;
+
+    for (size_t i = size_ + spare; i-- > size_;) {
+      cache_.Deallocate(slab_node(i));
+    }
   }
 
   ~List() {
-    // Not implemented
+    Clear();
+  }
+
+private:
+  static constexpr size_t SORT_SLOTS = 64;
+
+  template <typename... Args>
+  Node* CreateNode(Args&&... args) {
+    void* memory = cache_.Allocate();
+    try {
+      return new (memory) Node(std::forward<Args>(args)...);
+    } catch (...) {
+      cache_.Deallocate(memory);
+      throw;
+    }
+  }
+
+  void DestroyNode(BaseNode* node) noexcept {
+    static_cast<Node*>(node)->~Node();
+    cache_.Deallocate(node);
+  }
+
+  static inline const T& ValueOf(const BaseNode* node) noexcept {
+    return static_cast<const Node*>(node)->value_;
+  }
+
+  // Relinks [first, last) before pos. Sizes are the caller's business
+  static void Transfer(BaseNode* pos, BaseNode* first, BaseNode* last) noexcept {
+    if (pos == last) {
+      return;
+    }
+    BaseNode* before_last = last->prev_;
+    first->prev_->next_ = last;
+    last->prev_ = first->prev_;
+
+    first->prev_ = pos->prev_;
+    before_last->next_ = pos;
+    pos->prev_->next_ = first;
+    pos->prev_ = before_last;
+  }
+
+  // Merges two null-terminated chains, taking from first on ties
+  template <typename Compare>
+  static BaseNode* MergeChains(BaseNode* first, BaseNode* second, Compare& comp) {
+    BaseNode head;
+    BaseNode* tail = &head;
+    while (first != nullptr && second != nullptr) {
+      if (comp(ValueOf(second), ValueOf(first))) {
+        tail->next_ = second;
+        second = second->next_;
+      } else {
+        tail->next_ = first;
+        first = first->next_;
+      }
+      tail = tail->next_;
+    }
+    tail->next_ = first != nullptr ? first : second;
+    return head.next_;
+  }
+
+  void LinkBefore(BaseNode* pos, BaseNode* node) noexcept {
+    node->prev_ = pos->prev_;
+    node->next_ = pos;
+    pos->prev_->next_ = node;
+    pos->prev_ = node;
+    ++size_;
+  }
+
+  void Unlink(BaseNode* node) noexcept {
+    node->prev_->next_ = node->next_;
+    node->next_->prev_ = node->prev_;
+    --size_;
+  }
+
+  // Neighbours of a moved sentinel still point to its old address
+  void FixSentinel() noexcept {
+    if (size_ == 0) {
+      end_.prev_ = end_.next_ = &end_;
+    } else {
+      end_.next_->prev_ = &end_;
+      end_.prev_->next_ = &end_;
+    }
   }
 
 private:
-  /*???*/
+  BaseNode end_;
+  size_t size_ = 0;
+  NodeCache<Node> cache_;
 };
 
 
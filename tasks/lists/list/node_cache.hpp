@@ -0,0 +1,327 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+// Memory of freed list nodes kept for reuse.
+//
+// Up to Limit() freed nodes are cached, the rest go back to the heap.
+// Reserve() allocates the missing nodes in one slab. Slab nodes can't be freed
+// one by one, so they always return to the cache which created the slab, and the
+// slab itself is freed by ShrinkToFit() or the destructor once none of its nodes is in use.
+//
+// Every node is preceded by a pointer to its slab (nullptr for nodes allocated alone),
+// so a node is recognised in O(1) whichever list frees it. Lists exchange nodes
+// (Splice, Merge) without telling their caches: a slab counts its nodes in use, and
+// a node freed by another list is only uncounted. The count is atomic, so lists which
+// exchanged nodes may be used from different threads afterwards.
+template <typename Node>
+class NodeCache{
+public:
+  static constexpr size_t DEFAULT_LIMIT = 64;
+
+  NodeCache() {
+  }
+
+  NodeCache(const NodeCache&) = delete;
+
+  NodeCache& operator=(const NodeCache&) = delete;
+
+  // Memory for one node, not constructed
+  void* Allocate() {
+    if (slab_free_ != nullptr) {
+      FreeNode* node = slab_free_;
+      slab_free_ = node->next;
+      Slab* slab = SlabOf(node);
+      --slab->cached;
+      slab->refs.fetch_add(1, std::memory_order_relaxed);
+      --cached_;
+      return node;
+    }
+    if (heap_free_ != nullptr) {
+      FreeNode* node = heap_free_;
+      heap_free_ = node->next;
+      --heap_cached_;
+      --cached_;
+      return node;
+    }
+    auto* cell = static_cast<std::byte*>(CELL_ALIGNMENT > __STDCPP_DEFAULT_NEW_ALIGNMENT__
+        ? ::operator new(CELL_SIZE, std::align_val_t{CELL_ALIGNMENT})
+        : ::operator new(CELL_SIZE));
+    new (cell) Slab*(nullptr);
+    return cell + NODE_OFFSET;
+  }
+
+  // Takes memory of an already destroyed node
+  void Deallocate(void* memory) noexcept {
+    Slab* slab = SlabOf(memory);
+    if (slab == nullptr) {
+      if (heap_cached_ < limit_) {
+        Push(heap_free_, memory);
+        ++heap_cached_;
+        ++cached_;
+      } else {
+        FreeHeapNode(memory);
+      }
+    } else if (slab->owner == id_) {
+      Push(slab_free_, memory);
+      ++slab->cached;
+      ++cached_;
+      slab->refs.fetch_sub(1, std::memory_order_relaxed);
+    } else {
+      // A node of another list's slab is never reused, the last one frees the slab
+      Unref(slab);
+    }
+  }
+
+  // Like Deallocate, but a node allocated alone goes back to the heap, and the slab
+  // of a node is counted for ReleaseEmptiedSlabs()
+  void Release(void* memory) noexcept {
+    Slab* slab = SlabOf(memory);
+    if (slab == nullptr) {
+      FreeHeapNode(memory);
+      return;
+    }
+    if (slab->owner == id_) {
+      ++slab->released;
+    }
+    Deallocate(memory);
+  }
+
+  // Frees slabs which have no node in use and whose cached nodes all came through Release(),
+  // other slabs keep their nodes cached
+  void ReleaseEmptiedSlabs() noexcept {
+    for (Slab* slab = slabs_; slab != nullptr; slab = slab->next) {
+      slab->releasable = IsUnused(slab) && slab->cached == slab->released;
+      slab->released = 0;
+    }
+    FreeReleasableSlabs();
+  }
+
+  // Makes sure at least count nodes are cached
+  void Reserve(size_t count) {
+    if (count <= cached_) {
+      return;
+    }
+    size_t missing = count - cached_;
+    Slab* slab = CreateSlab(missing, 0);
+    for (size_t i = missing; i-- > 0;) {
+      Push(slab_free_, NodeAt(slab, i));
+    }
+    slab->cached = missing;
+    cached_ += missing;
+  }
+
+  // Memory for count consecutive nodes in a new slab, not constructed and not cached.
+  // Each of them goes back through Deallocate like any other node
+  void* AllocateSlab(size_t count) {
+    return NodeAt(CreateSlab(count, count), 0);
+  }
+
+  // Node index of the slab which starts with first, nodes are padded with slab pointers
+  static inline void* SlabNode(void* first, size_t index) noexcept {
+    return static_cast<std::byte*>(first) + index * CELL_SIZE;
+  }
+
+  // Frees a slab from AllocateSlab whose nodes were never constructed or handed out
+  void DeallocateSlab(void* first) noexcept {
+    Slab* slab = SlabOf(first);
+    Unlink(slab);
+    FreeSlab(slab);
+  }
+
+  // Frees cached nodes allocated alone and slabs which have no node in use
+  void ShrinkToFit() noexcept {
+    while (heap_free_ != nullptr) {
+      FreeNode* next = heap_free_->next;
+      FreeHeapNode(heap_free_);
+      heap_free_ = next;
+    }
+    cached_ -= heap_cached_;
+    heap_cached_ = 0;
+
+    for (Slab* slab = slabs_; slab != nullptr; slab = slab->next) {
+      slab->releasable = IsUnused(slab);
+    }
+    FreeReleasableSlabs();
+  }
+
+  void SetLimit(size_t limit) noexcept {
+    limit_ = limit;
+    while (heap_cached_ > limit_) {
+      FreeNode* node = heap_free_;
+      heap_free_ = node->next;
+      --heap_cached_;
+      --cached_;
+      FreeHeapNode(node);
+    }
+  }
+
+  inline size_t Limit() const noexcept {
+    return limit_;
+  }
+
+  inline size_t CachedCount() const noexcept {
+    return cached_;
+  }
+
+  void Swap(NodeCache& other) noexcept {
+    std::swap(heap_free_, other.heap_free_);
+    std::swap(slab_free_, other.slab_free_);
+    std::swap(cached_, other.cached_);
+    std::swap(heap_cached_, other.heap_cached_);
+    std::swap(limit_, other.limit_);
+    std::swap(slabs_, other.slabs_);
+    std::swap(id_, other.id_);
+  }
+
+  ~NodeCache() {
+    while (heap_free_ != nullptr) {
+      FreeNode* next = heap_free_->next;
+      FreeHeapNode(heap_free_);
+      heap_free_ = next;
+    }
+    // Cached slab nodes are dropped with their slabs, nodes held by other lists keep them alive
+    while (slabs_ != nullptr) {
+      Slab* next = slabs_->next;
+      Unref(slabs_);
+      slabs_ = next;
+    }
+  }
+
+private:
+  struct FreeNode {
+    FreeNode* next;
+  };
+
+  // Header followed by count cells
+  struct Slab {
+    // Nodes in use by any list, plus one while the creating cache is alive
+    std::atomic<size_t> refs;
+    size_t count;
+    // Id of the creating cache, only it reuses the nodes
+    uint64_t owner;
+    // The rest is used by the creating cache only
+    Slab* prev;
+    Slab* next;
+    // Nodes in its free list
+    size_t cached;
+    // Nodes which came through Release since the last ReleaseEmptiedSlabs
+    size_t released;
+    bool releasable;
+  };
+
+  static_assert(sizeof(Node) >= sizeof(FreeNode), "Node is too small to be cached");
+
+  // A cell is the slab pointer followed by the node
+  static constexpr size_t CELL_ALIGNMENT = std::max(alignof(Node), alignof(Slab*));
+  static constexpr size_t NODE_OFFSET = (sizeof(Slab*) + alignof(Node) - 1) / alignof(Node) * alignof(Node);
+  static constexpr size_t CELL_SIZE = (NODE_OFFSET + sizeof(Node) + CELL_ALIGNMENT - 1) / CELL_ALIGNMENT * CELL_ALIGNMENT;
+  static constexpr size_t SLAB_ALIGNMENT = std::max(CELL_ALIGNMENT, alignof(Slab));
+  static constexpr size_t SLAB_CELLS_OFFSET = (sizeof(Slab) + CELL_ALIGNMENT - 1) / CELL_ALIGNMENT * CELL_ALIGNMENT;
+
+  static inline uint64_t NextId() noexcept {
+    static std::atomic<uint64_t> next_id{0};
+    return next_id.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  static inline Slab* SlabOf(const void* memory) noexcept {
+    return *reinterpret_cast<Slab* const*>(static_cast<const std::byte*>(memory) - NODE_OFFSET);
+  }
+
+  static inline void* NodeAt(Slab* slab, size_t index) noexcept {
+    return reinterpret_cast<std::byte*>(slab) + SLAB_CELLS_OFFSET + index * CELL_SIZE + NODE_OFFSET;
+  }
+
+  // in_use nodes are handed out right away
+  Slab* CreateSlab(size_t count, size_t in_use) {
+    void* memory = ::operator new(SLAB_CELLS_OFFSET + count * CELL_SIZE, std::align_val_t{SLAB_ALIGNMENT});
+    auto* slab = new (memory) Slab{{in_use + 1}, count, id_, nullptr, slabs_, 0, 0, false};
+    if (slabs_ != nullptr) {
+      slabs_->prev = slab;
+    }
+    slabs_ = slab;
+    for (size_t i = 0; i < count; ++i) {
+      new (static_cast<std::byte*>(NodeAt(slab, i)) - NODE_OFFSET) Slab*(slab);
+    }
+    return slab;
+  }
+
+  static void FreeSlab(Slab* slab) noexcept {
+    slab->~Slab();
+    ::operator delete(slab, std::align_val_t{SLAB_ALIGNMENT});
+  }
+
+  static void Unref(Slab* slab) noexcept {
+    if (slab->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      FreeSlab(slab);
+    }
+  }
+
+  static inline bool IsUnused(const Slab* slab) noexcept {
+    return slab->refs.load(std::memory_order_acquire) == 1;
+  }
+
+  void Unlink(Slab* slab) noexcept {
+    if (slab->prev != nullptr) {
+      slab->prev->next = slab->next;
+    } else {
+      slabs_ = slab->next;
+    }
+    if (slab->next != nullptr) {
+      slab->next->prev = slab->prev;
+    }
+  }
+
+  // Frees the slabs marked releasable, dropping their nodes from the free list
+  void FreeReleasableSlabs() noexcept {
+    FreeNode** link = &slab_free_;
+    while (*link != nullptr) {
+      FreeNode* node = *link;
+      if (SlabOf(node)->releasable) {
+        *link = node->next;
+        --cached_;
+      } else {
+        link = &node->next;
+      }
+    }
+    for (Slab* slab = slabs_; slab != nullptr;) {
+      Slab* next = slab->next;
+      if (slab->releasable) {
+        Unlink(slab);
+        FreeSlab(slab);
+      }
+      slab = next;
+    }
+  }
+
+  static inline void Push(FreeNode*& list, void* memory) noexcept {
+    auto* node = static_cast<FreeNode*>(memory);
+    node->next = list;
+    list = node;
+  }
+
+  static inline void FreeHeapNode(void* memory) noexcept {
+    void* cell = static_cast<std::byte*>(memory) - NODE_OFFSET;
+    if constexpr (CELL_ALIGNMENT > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+      ::operator delete(cell, std::align_val_t{CELL_ALIGNMENT});
+    } else {
+      ::operator delete(cell);
+    }
+  }
+
+private:
+  // Cached nodes allocated alone, at most limit_ of them
+  FreeNode* heap_free_ = nullptr;
+  // Cached nodes of own slabs
+  FreeNode* slab_free_ = nullptr;
+  size_t cached_ = 0;
+  size_t heap_cached_ = 0;
+  size_t limit_ = DEFAULT_LIMIT;
+  Slab* slabs_ = nullptr;
+  uint64_t id_ = NextId();
+};
@@ -1,11 +1,19 @@
 #include <random>
 #include <list>
 #include <string>
+#include <vector>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
 
 #include <benchmark/benchmark.h>
 #include <fmt/core.h>
 
 #include "../list.hpp"
+#include "../unrolled_list.hpp"
+#include "../compact_list.hpp"
+#include "../indexed_skip_list.hpp"
 
 void ConstructRandomList(List<int>& list, int sz) {
   std::random_device rd;
@@ -31,6 +39,101 @@ void ConstructRandomList(std::list<int>& list, int sz) {
   }
 }
 
+void ConstructRandomList(UnrolledList<int>& list, int sz) {
+  std::random_device rd;
+  std::mt19937 mt(rd());
+  std::uniform_int_distribution<int> dist(INT_MIN, INT_MAX);
+  int random_key;
+  while(sz) {
+    random_key = dist(mt);
+    list.PushBack(random_key);
+    --sz;
+  }
+}
+
+void ConstructRandomList(CompactList<int>& list, int sz) {
+  std::random_device rd;
+  std::mt19937 mt(rd());
+  std::uniform_int_distribution<int> dist(INT_MIN, INT_MAX);
+  int random_key;
+  while(sz) {
+    random_key = dist(mt);
+    list.PushBack(random_key);
+    --sz;
+  }
+}
+
+void ConstructRandomList(IndexedSkipList<int>& list, int sz) {
+  std::random_device rd;
+  std::mt19937 mt(rd());
+  std::uniform_int_distribution<int> dist(INT_MIN, INT_MAX);
+  int random_key;
+  while(sz) {
+    random_key = dist(mt);
+    list.PushBack(random_key);
+    --sz;
+  }
+}
+
+// Replaces random elements with new ones at random positions, rounds times per element,
+// so that neighbours in the list are no longer neighbours in memory
+template <typename ListType>
+void ChurnList(ListType& list, int sz, int rounds) {
+  using Iterator = decltype(list.Begin());
+  std::mt19937 mt(17);
+  std::vector<Iterator> elements;
+  for (int i = 0; i < sz; ++i) {
+    list.PushBack(i);
+    elements.push_back(--list.End());
+  }
+  for (int64_t step = 0; step < int64_t{sz} * rounds; ++step) {
+    size_t victim = mt() % elements.size();
+    auto pos = elements[mt() % elements.size()];
+    if (pos == elements[victim]) {
+      continue;
+    }
+    list.Erase(elements[victim]);
+    list.Insert(pos, static_cast<int>(step));
+    elements[victim] = --pos;
+  }
+}
+
+void ChurnList(std::list<int>& list, int sz, int rounds) {
+  std::mt19937 mt(17);
+  std::vector<std::list<int>::iterator> elements;
+  for (int i = 0; i < sz; ++i) {
+    elements.push_back(list.insert(list.end(), i));
+  }
+  for (int64_t step = 0; step < int64_t{sz} * rounds; ++step) {
+    size_t victim = mt() % elements.size();
+    auto pos = elements[mt() % elements.size()];
+    if (pos == elements[victim]) {
+      continue;
+    }
+    list.erase(elements[victim]);
+    elements[victim] = list.insert(pos, static_cast<int>(step));
+  }
+}
+
+// Bytes taken from malloc, including its own headers and blocks it maps directly
+size_t HeapInUse() {
+#if defined(__GLIBC__)
+  auto info = mallinfo2();
+  return info.uordblks + info.hblkhd;
+#else
+  return 0;
+#endif
+}
+
+// Payloads which are expensive to copy but cheap to move
+constexpr size_t STRING_LENGTH = 64;
+constexpr size_t HEAVY_LENGTH = 256;
+using Heavy = std::vector<int>;
+
+std::string MakeString(int i) {
+  return std::string(STRING_LENGTH, static_cast<char>('a' + i % 26));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void BM_CustomListPushBack(benchmark::State& state) {
   List<int> list;
@@ -74,6 +177,144 @@ void BM_StdListMiddleInsert(benchmark::State& state) {
   state.SetComplexityN(state.range(0));
 }
 
+void BM_CustomListRandomMiddleInsert(benchmark::State& state) {
+  std::mt19937 mt(17);
+  for (auto _ : state) {
+    List<int> list;
+    ConstructRandomList(list, 100);
+    for (int i = 0; i < state.range(0); ++i){
+      auto it = list.Begin();
+      std::advance(it, mt() % (list.Size() + 1));
+      list.Insert(it, 50);
+    }
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_StdListRandomMiddleInsert(benchmark::State& state) {
+  std::mt19937 mt(17);
+  for (auto _ : state) {
+    std::list<int> list;
+    ConstructRandomList(list, 100);
+    for (int i = 0; i < state.range(0); ++i){
+      auto it = list.begin();
+      std::advance(it, mt() % (list.size() + 1));
+      list.insert(it, 50);
+    }
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_IndexedSkipListRandomMiddleInsert(benchmark::State& state) {
+  std::mt19937 mt(17);
+  for (auto _ : state) {
+    IndexedSkipList<int> list;
+    ConstructRandomList(list, 100);
+    for (int i = 0; i < state.range(0); ++i){
+      list.InsertAt(mt() % (list.Size() + 1), 50);
+    }
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_CustomListCopyString(benchmark::State& state) {
+  List<std::string> list;
+  for (auto _ : state) {
+    for (int i = 0; i < state.range(0); ++i) {
+      std::string value = MakeString(i);
+      list.PushBack(value);
+    }
+    list.Clear();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_CustomListMoveString(benchmark::State& state) {
+  List<std::string> list;
+  for (auto _ : state) {
+    for (int i = 0; i < state.range(0); ++i) {
+      list.PushBack(MakeString(i));
+    }
+    list.Clear();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_CustomListEmplaceString(benchmark::State& state) {
+  List<std::string> list;
+  for (auto _ : state) {
+    for (int i = 0; i < state.range(0); ++i) {
+      list.EmplaceBack(STRING_LENGTH, static_cast<char>('a' + i % 26));
+    }
+    list.Clear();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_StdListEmplaceString(benchmark::State& state) {
+  std::list<std::string> list;
+  for (auto _ : state) {
+    for (int i = 0; i < state.range(0); ++i) {
+      list.emplace_back(STRING_LENGTH, static_cast<char>('a' + i % 26));
+    }
+    list.clear();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_CustomListCopyHeavy(benchmark::State& state) {
+  List<Heavy> list;
+  for (auto _ : state) {
+    for (int i = 0; i < state.range(0); ++i) {
+      Heavy value = Heavy(HEAVY_LENGTH, i);
+      list.PushBack(value);
+    }
+    list.Clear();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_CustomListMoveHeavy(benchmark::State& state) {
+  List<Heavy> list;
+  for (auto _ : state) {
+    for (int i = 0; i < state.range(0); ++i) {
+      list.PushBack(Heavy(HEAVY_LENGTH, i));
+    }
+    list.Clear();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_CustomListEmplaceHeavy(benchmark::State& state) {
+  List<Heavy> list;
+  for (auto _ : state) {
+    for (int i = 0; i < state.range(0); ++i) {
+      list.EmplaceBack(HEAVY_LENGTH, i);
+    }
+    list.Clear();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_StdListEmplaceHeavy(benchmark::State& state) {
+  std::list<Heavy> list;
+  for (auto _ : state) {
+    for (int i = 0; i < state.range(0); ++i) {
+      list.emplace_back(HEAVY_LENGTH, i);
+    }
+    list.clear();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetComplexityN(state.range(0));
+}
+
 void BM_CustomListErase(benchmark::State& state) {
   List<int> list;
   for (auto _ : state) {
@@ -135,7 +376,7 @@ void BM_CustomListFind(benchmark::State& state) {
     state.PauseTiming();
     random_key = dist(mt);
     state.ResumeTiming();
-    list.Find(random_key);
+    benchmark::DoNotOptimize(list.Find(random_key));
   }
   state.SetComplexityN(state.range(0));
 }
@@ -153,22 +394,367 @@ void BM_StdListFind(benchmark::State& state) {
     state.PauseTiming();
     random_key = dist(mt);
     state.ResumeTiming();
-    std::find(list.begin(), list.end(), random_key);
+    benchmark::DoNotOptimize(std::find(list.begin(), list.end(), random_key));
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_UnrolledListFind(benchmark::State& state) {
+  UnrolledList<int> list;
+  std::random_device rd;
+  std::mt19937 mt(rd());
+  std::uniform_int_distribution<int> dist(INT_MIN, INT_MAX);
+  int random_key;
+  for (auto _ : state) {
+    state.PauseTiming();
+    ConstructRandomList(list, state.range(0));
+    state.ResumeTiming();
+    state.PauseTiming();
+    random_key = dist(mt);
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(list.Find(random_key));
   }
   state.SetComplexityN(state.range(0));
 }
 
+void BM_CustomListTraverse(benchmark::State& state) {
+  List<int> list;
+  ConstructRandomList(list, state.range(0));
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (auto it = list.Begin(); it != list.End(); ++it) {
+      sum += *it;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_StdListTraverse(benchmark::State& state) {
+  std::list<int> list;
+  ConstructRandomList(list, state.range(0));
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (auto it = list.begin(); it != list.end(); ++it) {
+      sum += *it;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_UnrolledListTraverse(benchmark::State& state) {
+  UnrolledList<int> list;
+  ConstructRandomList(list, state.range(0));
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (auto it = list.Begin(); it != list.End(); ++it) {
+      sum += *it;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_CustomListSplice(benchmark::State& state) {
+  List<int> list;
+  List<int> other;
+  ConstructRandomList(list, state.range(0));
+  for (auto _ : state) {
+    // Move the whole list back and forth, then one element and a range of it
+    other.Splice(other.End(), list);
+    list.Splice(list.Begin(), other);
+    list.Splice(list.End(), list, list.Begin());
+    list.Splice(list.End(), list, list.Begin(), ++++list.Begin());
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_StdListSplice(benchmark::State& state) {
+  std::list<int> list;
+  std::list<int> other;
+  ConstructRandomList(list, state.range(0));
+  for (auto _ : state) {
+    other.splice(other.end(), list);
+    list.splice(list.begin(), other);
+    list.splice(list.end(), list, list.begin());
+    list.splice(list.end(), list, list.begin(), ++++list.begin());
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_CustomListMerge(benchmark::State& state) {
+  List<int> list;
+  List<int> other;
+  for (auto _ : state) {
+    state.PauseTiming();
+    list.Clear();
+    ConstructRandomList(list, state.range(0) / 2);
+    ConstructRandomList(other, state.range(0) / 2);
+    list.Sort();
+    other.Sort();
+    state.ResumeTiming();
+    list.Merge(other);
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_StdListMerge(benchmark::State& state) {
+  std::list<int> list;
+  std::list<int> other;
+  for (auto _ : state) {
+    state.PauseTiming();
+    list.clear();
+    ConstructRandomList(list, state.range(0) / 2);
+    ConstructRandomList(other, state.range(0) / 2);
+    list.sort();
+    other.sort();
+    state.ResumeTiming();
+    list.merge(other);
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_CustomListSort(benchmark::State& state) {
+  List<int> list;
+  for (auto _ : state) {
+    state.PauseTiming();
+    list.Clear();
+    ConstructRandomList(list, state.range(0));
+    state.ResumeTiming();
+    list.Sort();
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_StdListSort(benchmark::State& state) {
+  std::list<int> list;
+  for (auto _ : state) {
+    state.PauseTiming();
+    list.clear();
+    ConstructRandomList(list, state.range(0));
+    state.ResumeTiming();
+    list.sort();
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+
+// A queue of fixed length: every iteration moves all its elements through the nodes
+void BM_CustomListChurn(benchmark::State& state) {
+  List<int> list;
+  ConstructRandomList(list, state.range(0));
+  for (auto _ : state) {
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      list.PushBack(list.Front());
+      list.PopFront();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_CustomListChurnNoCache(benchmark::State& state) {
+  List<int> list;
+  list.SetCacheLimit(0);
+  ConstructRandomList(list, state.range(0));
+  for (auto _ : state) {
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      list.PushBack(list.Front());
+      list.PopFront();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_StdListChurn(benchmark::State& state) {
+  std::list<int> list;
+  ConstructRandomList(list, state.range(0));
+  for (auto _ : state) {
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      list.push_back(list.front());
+      list.pop_front();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_CustomListReservedPushBack(benchmark::State& state) {
+  List<int> list;
+  for (auto _ : state) {
+    state.PauseTiming();
+    list.Clear();
+    list.ShrinkToFit();
+    state.ResumeTiming();
+    list.Reserve(state.range(0));
+    ConstructRandomList(list, state.range(0));
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+template <typename ListType>
+void ListMemory(benchmark::State& state) {
+  double bytes_per_element = 0;
+  for (auto _ : state) {
+    size_t before = HeapInUse();
+    ListType list;
+    ConstructRandomList(list, state.range(0));
+    bytes_per_element = static_cast<double>(HeapInUse() - before) / state.range(0);
+  }
+  state.counters["bytes_per_element"] = bytes_per_element;
+}
+
+void BM_CustomListMemory(benchmark::State& state) {
+  ListMemory<List<int>>(state);
+}
+
+void BM_CompactListMemory(benchmark::State& state) {
+  ListMemory<CompactList<int>>(state);
+}
+
+void BM_StdListMemory(benchmark::State& state) {
+  ListMemory<std::list<int>>(state);
+}
+
+void BM_CustomListTraverseAfterChurn(benchmark::State& state) {
+  List<int> list;
+  ChurnList(list, state.range(0), 4);
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (auto it = list.Begin(); it != list.End(); ++it) {
+      sum += *it;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_CustomListTraverseAfterCompact(benchmark::State& state) {
+  List<int> list;
+  ChurnList(list, state.range(0), 4);
+  list.Compact();
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (auto it = list.Begin(); it != list.End(); ++it) {
+      sum += *it;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetComplexityN(state.range(0));
+}
+
+// Looks for a missing value, so Find walks the whole list
+void BM_CustomListFindAfterChurn(benchmark::State& state) {
+  List<int> list;
+  ChurnList(list, state.range(0), 4);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(list.Find(-1));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_CustomListFindAfterCompact(benchmark::State& state) {
+  List<int> list;
+  ChurnList(list, state.range(0), 4);
+  list.Compact();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(list.Find(-1));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_CustomListCompact(benchmark::State& state) {
+  List<int> list;
+  ChurnList(list, state.range(0), 4);
+  for (auto _ : state) {
+    list.Compact();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_CompactListTraverseAfterChurn(benchmark::State& state) {
+  CompactList<int> list;
+  ChurnList(list, state.range(0), 4);
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (auto it = list.Begin(); it != list.End(); ++it) {
+      sum += *it;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_StdListTraverseAfterChurn(benchmark::State& state) {
+  std::list<int> list;
+  ChurnList(list, state.range(0), 4);
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (auto value : list) {
+      sum += value;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetComplexityN(state.range(0));
+}
 
 BENCHMARK(BM_CustomListPushBack)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMillisecond);
 BENCHMARK(BM_StdListPushBack)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMillisecond);
 BENCHMARK(BM_CustomListMiddleInsert)->Range(1<<10, 1<<15)->Complexity()->Unit(benchmark::kMillisecond);
 BENCHMARK(BM_StdListMiddleInsert)->Range(1<<10, 1<<15)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CustomListRandomMiddleInsert)->Range(1<<10, 1<<15)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StdListRandomMiddleInsert)->Range(1<<10, 1<<15)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_IndexedSkipListRandomMiddleInsert)->Range(1<<10, 1<<15)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CustomListCopyString)->Range(1<<10, 1<<16)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CustomListMoveString)->Range(1<<10, 1<<16)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CustomListEmplaceString)->Range(1<<10, 1<<16)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StdListEmplaceString)->Range(1<<10, 1<<16)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CustomListCopyHeavy)->Range(1<<10, 1<<16)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CustomListMoveHeavy)->Range(1<<10, 1<<16)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CustomListEmplaceHeavy)->Range(1<<10, 1<<16)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StdListEmplaceHeavy)->Range(1<<10, 1<<16)->Complexity()->Unit(benchmark::kMillisecond);
 BENCHMARK(BM_CustomListErase)->Range(1<<10, 1<<17)->Complexity()->Unit(benchmark::kMillisecond);
 BENCHMARK(BM_StdListErase)->Range(1<<10, 1<<17)->Complexity()->Unit(benchmark::kMillisecond);
 BENCHMARK(BM_CustomListClear)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMillisecond);
 BENCHMARK(BM_StdListClear)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMillisecond);
 BENCHMARK(BM_CustomListFind)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMillisecond);
 BENCHMARK(BM_StdListFind)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_UnrolledListFind)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CustomListTraverse)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StdListTraverse)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_UnrolledListTraverse)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CustomListSplice)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_StdListSplice)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_CustomListMerge)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StdListMerge)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CustomListSort)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StdListSort)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CustomListChurn)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CustomListChurnNoCache)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StdListChurn)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CustomListReservedPushBack)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CustomListMemory)->Range(1<<10, 1<<20)->Iterations(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CompactListMemory)->Range(1<<10, 1<<20)->Iterations(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StdListMemory)->Range(1<<10, 1<<20)->Iterations(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CustomListTraverseAfterChurn)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CustomListTraverseAfterCompact)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CustomListFindAfterChurn)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CustomListFindAfterCompact)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CustomListCompact)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CompactListTraverseAfterChurn)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StdListTraverseAfterChurn)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMillisecond);
 
 
 BENCHMARK_MAIN();
\ No newline at end of file
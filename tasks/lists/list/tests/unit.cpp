@@ -1,11 +1,17 @@
 #include <list>
+#include <random>
+#include <string>
 #include <thread>
+#include <vector>
 #include <future>
 
 #include <fmt/core.h>
 #include <gtest/gtest.h>
 
 #include "../list.hpp"
+#include "../unrolled_list.hpp"
+#include "../compact_list.hpp"
+#include "../indexed_skip_list.hpp"
 
 class ListTest: public testing::Test {
   protected:
@@ -252,6 +258,754 @@ TEST_F(ListTest, Clear) {
   ASSERT_EQ(list.Size(), 0);
 }
 
+TEST(UnrolledListTest, PushAndPop) {
+  UnrolledList<int, 4> list;
+  for (int i = 0; i < 10; ++i) {
+    list.PushBack(i);
+  }
+  list.PushFront(-1);
+  ASSERT_EQ(list.Size(), 11);
+  ASSERT_EQ(list.Front(), -1);
+  ASSERT_EQ(list.Back(), 9);
+
+  list.PopFront();
+  list.PopBack();
+  ASSERT_EQ(list.Size(), 9);
+  ASSERT_EQ(list.Front(), 0);
+  ASSERT_EQ(list.Back(), 8);
+
+  while (!list.IsEmpty()) {
+    list.PopBack();
+  }
+  EXPECT_THROW({
+    list.PopFront();
+  }, ListIsEmptyException);
+}
+
+TEST(UnrolledListTest, BidirectionalIterators) {
+  UnrolledList<int, 3> list{1, 2, 3, 4, 5, 6, 7};
+  ASSERT_EQ(std::distance(list.Begin(), list.End()), 7);
+  int iter = 1;
+  for (auto it = list.Begin(); it != list.End(); ++it) {
+    ASSERT_EQ(*it, iter++);
+  }
+  auto it = list.End();
+  for (int i = 7; i > 0; --i) {
+    --it;
+    ASSERT_EQ(*it, i);
+  }
+  ASSERT_TRUE(it == list.Begin());
+}
+
+TEST(UnrolledListTest, InsertSplitsFullNode) {
+  UnrolledList<int, 4> list{0, 1, 2, 3};
+  auto it = list.Begin();
+  std::advance(it, 2);
+  list.Insert(it, 100);
+  list.Insert(list.End(), 200);
+  list.Insert(list.Begin(), -100);
+
+  std::list<int> expected{-100, 0, 1, 100, 2, 3, 200};
+  ASSERT_EQ(list.Size(), expected.size());
+  ASSERT_TRUE(std::equal(expected.begin(), expected.end(), list.Begin()));
+}
+
+TEST(UnrolledListTest, InsertElementOfSplitNode) {
+  // Long strings, so that reading a moved-from one gives a wrong value
+  std::vector<std::string> values;
+  for (char c = 'a'; c < 'e'; ++c) {
+    values.emplace_back(40, c);
+  }
+  UnrolledList<std::string, 4> list;
+  for (const auto& value : values) {
+    list.PushBack(value);
+  }
+  auto source = list.Begin();
+  std::advance(source, 2);
+  list.Insert(list.Begin(), *source);
+
+  std::list<std::string> expected{values[2], values[0], values[1], values[2], values[3]};
+  ASSERT_EQ(list.Size(), expected.size());
+  ASSERT_TRUE(std::equal(expected.begin(), expected.end(), list.Begin()));
+}
+
+TEST(UnrolledListTest, FindAndErase) {
+  UnrolledList<std::string, 4> list;
+  for (int i = 0; i < 20; ++i) {
+    list.PushBack(std::to_string(i));
+  }
+  ASSERT_TRUE(list.Find("42") == list.End());
+  auto it = list.Find("13");
+  ASSERT_EQ(*it, "13");
+  list.Erase(it);
+  ASSERT_TRUE(list.Find("13") == list.End());
+  ASSERT_EQ(list.Size(), 19);
+  ASSERT_EQ(*list.Find("14"), "14");
+}
+
+TEST(UnrolledListTest, CopyAndSwap) {
+  UnrolledList<int, 4> list{1, 2, 3, 4, 5};
+  UnrolledList<int, 4> copy = list;
+  copy.PushBack(6);
+  ASSERT_EQ(list.Size(), 5);
+  ASSERT_EQ(copy.Size(), 6);
+
+  UnrolledList<int, 4> empty;
+  std::swap(empty, copy);
+  ASSERT_TRUE(copy.IsEmpty());
+  ASSERT_TRUE(copy.Begin() == copy.End());
+  ASSERT_EQ(empty.Back(), 6);
+  ASSERT_EQ(std::distance(empty.Begin(), empty.End()), 6);
+
+  list = list;
+  list = empty;
+  ASSERT_EQ(list.Size(), 6);
+}
+
+TEST(UnrolledListTest, RandomOperationsMatchStdList) {
+  std::mt19937 mt(17);
+  UnrolledList<int, 5> list;
+  std::list<int> expected;
+  for (int step = 0; step < 5000; ++step) {
+    size_t pos = expected.empty() ? 0 : mt() % (expected.size() + 1);
+    auto it = list.Begin();
+    auto expected_it = expected.begin();
+    std::advance(it, pos);
+    std::advance(expected_it, pos);
+    if (mt() % 3 != 0 || expected_it == expected.end()) {
+      list.Insert(it, step);
+      expected.insert(expected_it, step);
+    } else {
+      list.Erase(it);
+      expected.erase(expected_it);
+    }
+    ASSERT_EQ(list.Size(), expected.size());
+  }
+  ASSERT_TRUE(std::equal(expected.begin(), expected.end(), list.Begin()));
+}
+
+TEST(ListSpliceTest, WholeList) {
+  List<int> list{1, 2, 5};
+  List<int> other{3, 4};
+  auto pos = list.Begin();
+  std::advance(pos, 2);
+  list.Splice(pos, other);
+
+  ASSERT_TRUE(other.IsEmpty());
+  ASSERT_TRUE(other.Begin() == other.End());
+  ASSERT_EQ(list.Size(), 5);
+  int iter = 1;
+  for (auto it = list.Begin(); it != list.End(); ++it) {
+    ASSERT_EQ(*it, iter++);
+  }
+  ASSERT_EQ(list.Back(), 5);
+}
+
+TEST(ListSpliceTest, SingleElementKeepsIterator) {
+  List<int> list{1, 2, 3};
+  List<int> other{10, 20};
+  auto moved = other.Begin();
+  list.Splice(list.End(), other, moved);
+
+  ASSERT_EQ(list.Size(), 4);
+  ASSERT_EQ(other.Size(), 1);
+  ASSERT_EQ(list.Back(), 10);
+  ASSERT_EQ(other.Front(), 20);
+  // The node moved, the iterator still points to it
+  ASSERT_TRUE(moved == --list.End());
+
+  // Inside one list
+  list.Splice(list.Begin(), list, moved);
+  ASSERT_EQ(list.Front(), 10);
+  ASSERT_EQ(list.Back(), 3);
+  ASSERT_EQ(list.Size(), 4);
+}
+
+TEST(ListSpliceTest, Range) {
+  List<int> list{1, 5};
+  List<int> other{0, 2, 3, 4, 6};
+  auto first = ++other.Begin();
+  auto last = first;
+  std::advance(last, 3);
+  list.Splice(--list.End(), other, first, last);
+
+  ASSERT_EQ(list.Size(), 5);
+  ASSERT_EQ(other.Size(), 2);
+  int iter = 1;
+  for (auto it = list.Begin(); it != list.End(); ++it) {
+    ASSERT_EQ(*it, iter++);
+  }
+  ASSERT_EQ(other.Front(), 0);
+  ASSERT_EQ(other.Back(), 6);
+
+  // Rotate inside one list
+  list.Splice(list.Begin(), list, ++++list.Begin(), list.End());
+  std::list<int> expected{3, 4, 5, 1, 2};
+  ASSERT_TRUE(std::equal(expected.begin(), expected.end(), list.Begin()));
+  ASSERT_EQ(list.Size(), 5);
+}
+
+TEST(ListMergeTest, MergeSorted) {
+  List<int> list{1, 3, 5, 7};
+  List<int> other{0, 2, 3, 8, 9};
+  list.Merge(other);
+
+  ASSERT_TRUE(other.IsEmpty());
+  std::list<int> expected{0, 1, 2, 3, 3, 5, 7, 8, 9};
+  ASSERT_EQ(list.Size(), expected.size());
+  ASSERT_TRUE(std::equal(expected.begin(), expected.end(), list.Begin()));
+  ASSERT_EQ(*--list.End(), 9);
+}
+
+TEST(ListMergeTest, MergeIsStable) {
+  using Item = std::pair<int, char>;
+  auto by_key = [](const Item& a, const Item& b) {
+    return a.first < b.first;
+  };
+  List<Item> list{{1, 'a'}, {2, 'a'}, {2, 'b'}};
+  List<Item> other{{1, 'c'}, {2, 'c'}, {3, 'c'}};
+  list.Merge(other, by_key);
+
+  std::list<Item> expected{{1, 'a'}, {1, 'c'}, {2, 'a'}, {2, 'b'}, {2, 'c'}, {3, 'c'}};
+  ASSERT_TRUE(std::equal(expected.begin(), expected.end(), list.Begin()));
+}
+
+TEST(ListSortTest, RandomValues) {
+  std::mt19937 mt(5);
+  List<int> list;
+  std::list<int> expected;
+  for (int i = 0; i < 1000; ++i) {
+    int value = static_cast<int>(mt() % 100);
+    list.PushBack(value);
+    expected.push_back(value);
+  }
+  auto first_node = list.Begin();
+  int first_value = *first_node;
+
+  list.Sort();
+  expected.sort();
+  ASSERT_EQ(list.Size(), expected.size());
+  ASSERT_TRUE(std::equal(expected.begin(), expected.end(), list.Begin()));
+  // Nodes are relinked, not copied
+  ASSERT_EQ(*first_node, first_value);
+
+  // prev links are consistent
+  auto it = list.End();
+  for (auto expected_it = expected.rbegin(); expected_it != expected.rend(); ++expected_it) {
+    ASSERT_EQ(*--it, *expected_it);
+  }
+  ASSERT_TRUE(it == list.Begin());
+}
+
+TEST(ListSortTest, StableWithComparator) {
+  using Item = std::pair<int, int>;
+  List<Item> list;
+  for (int i = 0; i < 100; ++i) {
+    list.PushBack({i % 7, i});
+  }
+  list.Sort([](const Item& a, const Item& b) {
+    return a.first > b.first;
+  });
+  auto prev = list.Begin();
+  for (auto it = ++list.Begin(); it != list.End(); ++it, ++prev) {
+    ASSERT_GE(prev->first, it->first);
+    if (prev->first == it->first) {
+      ASSERT_LT(prev->second, it->second);
+    }
+  }
+
+  List<int> empty;
+  empty.Sort();
+  ASSERT_TRUE(empty.IsEmpty());
+}
+
+
+TEST(ListCacheTest, ReusesErasedNodes) {
+  List<int> list{1, 2, 3};
+  const int* first = &list.Front();
+  list.PopFront();
+  ASSERT_EQ(list.Capacity(), 3);
+  list.PushBack(4);
+  ASSERT_EQ(&list.Back(), first);
+  ASSERT_EQ(list.Capacity(), 3);
+}
+
+TEST(ListCacheTest, LimitIsRespected) {
+  List<int> list;
+  list.SetCacheLimit(2);
+  for (int i = 0; i < 10; ++i) {
+    list.PushBack(i);
+  }
+  list.Clear();
+  ASSERT_EQ(list.Capacity(), 2);
+
+  list.SetCacheLimit(0);
+  ASSERT_EQ(list.Capacity(), 0);
+  ASSERT_EQ(list.CacheLimit(), 0);
+}
+
+TEST(ListCacheTest, ReserveAndShrinkToFit) {
+  List<std::string> list{"a"};
+  list.SetCacheLimit(0);
+  list.Reserve(100);
+  ASSERT_EQ(list.Capacity(), 100);
+  for (int i = 0; i < 99; ++i) {
+    list.PushBack(std::to_string(i));
+  }
+  ASSERT_EQ(list.Capacity(), 100);
+
+  // Reserved nodes are cached regardless of the limit, the first one was allocated alone
+  list.Clear();
+  ASSERT_EQ(list.Capacity(), 99);
+  list.ShrinkToFit();
+  ASSERT_EQ(list.Capacity(), 0);
+
+  // The slab stays while some of its nodes are in use
+  list.Reserve(10);
+  list.PushBack("x");
+  list.ShrinkToFit();
+  ASSERT_EQ(list.Capacity(), 10);
+  ASSERT_EQ(list.Front(), "x");
+}
+
+TEST(ListCacheTest, SplicedNodesOutliveSource) {
+  List<std::string> list;
+  {
+    List<std::string> other;
+    other.Reserve(64);
+    for (int i = 0; i < 64; ++i) {
+      other.PushBack(std::to_string(i));
+    }
+    list.Splice(list.End(), other, other.Begin(), std::next(other.Begin(), 32));
+    list.Splice(list.End(), other, other.Begin());
+    list.SetCacheLimit(0);
+    list.PopFront();
+    other.ShrinkToFit();
+  }
+  ASSERT_EQ(list.Size(), 32);
+  ASSERT_EQ(list.Front(), "1");
+  ASSERT_EQ(list.Back(), "32");
+  list.Clear();
+  list.ShrinkToFit();
+  ASSERT_EQ(list.Capacity(), 0);
+}
+
+TEST(ListCacheTest, SplicedSlabsAreReleased) {
+  List<int> first;
+  List<int> second;
+  first.Reserve(4);
+  second.Reserve(4);
+  for (int i = 0; i < 4; ++i) {
+    first.PushBack(i);
+    second.PushBack(i + 4);
+  }
+  first.Splice(first.End(), second);
+  second.PushBack(8);
+  second.Merge(first);
+  ASSERT_EQ(second.Size(), 9);
+
+  // The second list caches its own nodes only, nodes of the first slab are just let go.
+  // Both slabs are unused now and nothing pins them
+  second.Clear();
+  ASSERT_EQ(first.Capacity(), 0);
+  ASSERT_EQ(second.Capacity(), 5);
+  first.ShrinkToFit();
+  second.ShrinkToFit();
+  ASSERT_EQ(first.Capacity(), 0);
+  ASSERT_EQ(second.Capacity(), 0);
+}
+
+TEST(ListCacheTest, AssignmentKeepsCache) {
+  List<int> list{1, 2, 3, 4};
+  List<int> other{5, 6};
+  list.Reserve(10);
+  list = other;
+  ASSERT_EQ(list.Size(), 2);
+  ASSERT_EQ(list.Capacity(), 10);
+  ASSERT_EQ(list.Front(), 5);
+}
+
+TEST(ListCompactTest, KeepsOrderAndPlacesNodesInOrder) {
+  std::mt19937 mt(5);
+  List<int> list;
+  std::list<int> expected;
+  for (int i = 0; i < 1000; ++i) {
+    auto it = list.Begin();
+    auto expected_it = expected.begin();
+    size_t pos = mt() % (expected.size() + 1);
+    std::advance(it, pos);
+    std::advance(expected_it, pos);
+    list.Insert(it, i);
+    expected.insert(expected_it, i);
+  }
+  list.Compact();
+  ASSERT_EQ(list.Size(), expected.size());
+  ASSERT_TRUE(std::equal(expected.begin(), expected.end(), list.Begin()));
+  ASSERT_TRUE(std::equal(expected.rbegin(), expected.rend(), std::make_reverse_iterator(list.End())));
+  auto prev = list.Begin();
+  auto stride = reinterpret_cast<char*>(&*++list.Begin()) - reinterpret_cast<char*>(&*prev);
+  ASSERT_GT(stride, 0);
+  for (auto it = ++list.Begin(); it != list.End(); prev = it++) {
+    ASSERT_EQ(reinterpret_cast<char*>(&*it) - reinterpret_cast<char*>(&*prev), stride);
+  }
+}
+
+TEST(ListCompactTest, SpareNodesAreCached) {
+  List<std::string> list{"a", "b", "c"};
+  list.SetCacheLimit(0);
+  list.Compact(5);
+  ASSERT_EQ(list.Size(), 3);
+  ASSERT_EQ(list.Capacity(), 8);
+
+  // The old slab still has the spare nodes, so it stays until ShrinkToFit
+  list.Compact();
+  ASSERT_EQ(list.Capacity(), 11);
+  list.ShrinkToFit();
+  ASSERT_EQ(list.Capacity(), 3);
+  list.PushBack("d");
+  list.PopFront();
+  ASSERT_EQ(list.Front(), "b");
+  ASSERT_EQ(list.Back(), "d");
+}
+
+TEST(ListCompactTest, KeepsReservedAndCachedNodes) {
+  List<int> list{1, 2, 3};
+  list.Reserve(10);
+  list.PushBack(4);
+  list.PopBack();
+  ASSERT_EQ(list.Capacity(), 10);
+  list.Compact();
+  ASSERT_EQ(list.Capacity(), 10);
+
+  // The old nodes allocated alone are freed, not cached
+  List<int> other{1, 2, 3, 4};
+  other.PopBack();
+  other.Compact();
+  ASSERT_EQ(other.Capacity(), 4);
+}
+
+TEST(ListCompactTest, SplicedNodes) {
+  List<int> first{1, 2};
+  List<int> second;
+  second.Reserve(4);
+  second.PushBack(3);
+  second.PushBack(4);
+  first.Splice(first.End(), second);
+  first.Compact();
+  second.PushBack(5);
+  ASSERT_EQ(first.Size(), 4);
+  ASSERT_EQ(first.Back(), 4);
+  ASSERT_EQ(second.Front(), 5);
+}
+
+struct ThrowingCopy {
+  static inline int copies_left = 0;
+  int value;
+
+  ThrowingCopy(int v) : value(v) {
+  }
+
+  ThrowingCopy(const ThrowingCopy& other) : value(other.value) {
+    if (copies_left-- == 0) {
+      throw std::runtime_error("copy failed");
+    }
+  }
+};
+
+TEST(ListCompactTest, ThrowingCopyLeavesListIntact) {
+  List<ThrowingCopy> list;
+  ThrowingCopy::copies_left = 10;
+  for (int i = 0; i < 10; ++i) {
+    list.PushBack(ThrowingCopy(i));
+  }
+  ThrowingCopy::copies_left = 5;
+  ASSERT_THROW(list.Compact(), std::runtime_error);
+  ASSERT_EQ(list.Size(), 10);
+  int expected = 0;
+  for (auto it = list.Begin(); it != list.End(); ++it) {
+    ASSERT_EQ(it->value, expected++);
+  }
+}
+
+TEST(ListAssignmentTest, ThrowingCopyLeavesListIntact) {
+  List<ThrowingCopy> list;
+  List<ThrowingCopy> other;
+  ThrowingCopy::copies_left = 20;
+  for (int i = 0; i < 10; ++i) {
+    list.PushBack(ThrowingCopy(i));
+    other.PushBack(ThrowingCopy(i + 10));
+  }
+  ThrowingCopy::copies_left = 5;
+  ASSERT_THROW(list = other, std::runtime_error);
+  ASSERT_EQ(list.Size(), 10);
+  int expected = 0;
+  for (auto it = list.Begin(); it != list.End(); ++it) {
+    ASSERT_EQ(it->value, expected++);
+  }
+}
+
+// Counts copies and moves of values
+struct Tracked {
+  static inline int copies = 0;
+  static inline int moves = 0;
+  std::string value;
+
+  Tracked(std::string v) : value(std::move(v)) {
+  }
+
+  Tracked(const std::string& prefix, int number) : value(prefix + std::to_string(number)) {
+  }
+
+  Tracked(const Tracked& other) : value(other.value) {
+    ++copies;
+  }
+
+  Tracked(Tracked&& other) noexcept : value(std::move(other.value)) {
+    ++moves;
+  }
+
+  static void Reset() {
+    copies = moves = 0;
+  }
+};
+
+TEST(ListEmplaceTest, MoveOverloadsDontCopy) {
+  List<Tracked> list;
+  Tracked::Reset();
+  Tracked value("b");
+  list.PushBack(std::move(value));
+  list.PushFront(Tracked("a"));
+  list.Insert(list.End(), Tracked("c"));
+  ASSERT_EQ(Tracked::copies, 0);
+  ASSERT_EQ(Tracked::moves, 3);
+  ASSERT_EQ(list.Front().value, "a");
+  ASSERT_EQ((++list.Begin())->value, "b");
+  ASSERT_EQ(list.Back().value, "c");
+}
+
+TEST(ListEmplaceTest, ConstructsInPlace) {
+  List<Tracked> list;
+  Tracked::Reset();
+  list.EmplaceBack("x", 2).value += "!";
+  list.EmplaceFront("x", 1);
+  auto it = list.Emplace(list.End(), "x", 3);
+  ASSERT_EQ(Tracked::copies, 0);
+  ASSERT_EQ(Tracked::moves, 0);
+  ASSERT_EQ(it->value, "x3");
+  ASSERT_EQ(list.Front().value, "x1");
+  ASSERT_EQ((++list.Begin())->value, "x2!");
+  ASSERT_EQ(list.Size(), 3);
+}
+
+TEST(ListEmplaceTest, LvaluesAreStillCopied) {
+  List<std::string> list;
+  std::string value(100, 'a');
+  list.PushBack(value);
+  list.Insert(list.Begin(), value);
+  ASSERT_EQ(value.size(), 100);
+  list.PushBack(std::move(value));
+  ASSERT_EQ(list.Size(), 3);
+  ASSERT_EQ(list.Back(), std::string(100, 'a'));
+}
+
+TEST(CompactListTest, PushAndPop) {
+  CompactList<int> list;
+  list.PushBack(2);
+  list.PushFront(1);
+  list.PushBack(3);
+  ASSERT_EQ(list.Size(), 3);
+  ASSERT_EQ(list.Front(), 1);
+  ASSERT_EQ(list.Back(), 3);
+  list.PopFront();
+  list.PopBack();
+  ASSERT_EQ(list.Front(), 2);
+  list.PopBack();
+  ASSERT_TRUE(list.IsEmpty());
+  EXPECT_THROW({
+    list.PopBack();
+  }, ListIsEmptyException);
+  EXPECT_THROW({
+    list.PopFront();
+  }, ListIsEmptyException);
+}
+
+TEST(CompactListTest, IteratorsSurviveGrowth) {
+  CompactList<std::string> list{"first"};
+  auto first = list.Begin();
+  for (int i = 0; i < 1000; ++i) {
+    list.PushBack(std::to_string(i));
+  }
+  ASSERT_GE(list.Capacity(), 1001);
+  ASSERT_EQ(*first, "first");
+  ASSERT_EQ(first->size(), 5);
+  ASSERT_EQ(*--list.End(), "999");
+  ASSERT_TRUE(first == list.Begin());
+}
+
+TEST(CompactListTest, ErasedNodesAreReused) {
+  CompactList<int> list;
+  for (int i = 0; i < 10; ++i) {
+    list.PushBack(i);
+  }
+  size_t capacity = list.Capacity();
+  for (int round = 0; round < 100; ++round) {
+    list.PopFront();
+    list.PushBack(round);
+  }
+  ASSERT_EQ(list.Capacity(), capacity);
+  ASSERT_EQ(list.Front(), 90);
+}
+
+TEST(CompactListTest, CopyAndSwap) {
+  CompactList<std::string> list{"a", "b", "c"};
+  list.Erase(list.Find("b"));
+  CompactList<std::string> copy = list;
+  list.PushFront("z");
+  ASSERT_EQ(copy.Size(), 2);
+  ASSERT_EQ(copy.Front(), "a");
+  ASSERT_EQ(copy.Back(), "c");
+
+  CompactList<std::string> other;
+  other = list;
+  std::swap(other, copy);
+  ASSERT_EQ(other.Size(), 2);
+  ASSERT_EQ(copy.Front(), "z");
+  copy.Clear();
+  ASSERT_TRUE(copy.IsEmpty());
+  copy.PushBack("y");
+  ASSERT_EQ(copy.Front(), "y");
+}
+
+TEST(CompactListTest, PushBackOwnElement) {
+  CompactList<std::string> list{"value"};
+  for (int i = 0; i < 100; ++i) {
+    list.PushBack(list.Front());
+  }
+  for (auto it = list.Begin(); it != list.End(); ++it) {
+    ASSERT_EQ(*it, "value");
+  }
+}
+
+TEST(CompactListTest, RandomOperationsMatchStdList) {
+  std::mt19937 mt(11);
+  CompactList<int> list;
+  std::list<int> expected;
+  for (int step = 0; step < 10000; ++step) {
+    size_t pos = expected.empty() ? 0 : mt() % (expected.size() + 1);
+    auto it = list.Begin();
+    auto expected_it = expected.begin();
+    std::advance(it, pos);
+    std::advance(expected_it, pos);
+    if (mt() % 3 != 0 || expected_it == expected.end()) {
+      int value = static_cast<int>(mt() % 1000);
+      list.Insert(it, value);
+      expected.insert(expected_it, value);
+    } else {
+      list.Erase(it);
+      expected.erase(expected_it);
+    }
+  }
+  ASSERT_EQ(list.Size(), expected.size());
+  ASSERT_TRUE(std::equal(expected.begin(), expected.end(), list.Begin()));
+  ASSERT_TRUE(std::equal(expected.rbegin(), expected.rend(), std::make_reverse_iterator(list.End())));
+}
+
+TEST(IndexedSkipListTest, PushAndPop) {
+  IndexedSkipList<int> list;
+  ASSERT_THROW(list.PopBack(), ListIsEmptyException);
+  ASSERT_THROW(list.PopFront(), ListIsEmptyException);
+  for (int i = 0; i < 100; ++i) {
+    list.PushBack(i);
+    list.PushFront(-i);
+  }
+  ASSERT_EQ(list.Size(), 200);
+  ASSERT_EQ(list.Front(), -99);
+  ASSERT_EQ(list.Back(), 99);
+  list.PopFront();
+  list.PopBack();
+  ASSERT_EQ(list.Front(), -98);
+  ASSERT_EQ(list.Back(), 98);
+}
+
+TEST(IndexedSkipListTest, AtAndOutOfRange) {
+  IndexedSkipList<int> list;
+  ASSERT_THROW(list.At(0), std::out_of_range);
+  for (int i = 0; i < 1000; ++i) {
+    list.PushBack(i);
+  }
+  for (size_t i = 0; i < 1000; ++i) {
+    ASSERT_EQ(list.At(i), static_cast<int>(i));
+  }
+  ASSERT_THROW(list.At(1000), std::out_of_range);
+  ASSERT_THROW(list.InsertAt(1001, 0), std::out_of_range);
+  ASSERT_THROW(list.EraseAt(1000), std::out_of_range);
+}
+
+TEST(IndexedSkipListTest, IteratorAtAndIndexOf) {
+  IndexedSkipList<int> list;
+  for (int i = 0; i < 500; ++i) {
+    list.InsertAt(list.Size() / 2, i);
+  }
+  size_t index = 0;
+  for (auto it = list.Begin(); it != list.End(); ++it, ++index) {
+    ASSERT_EQ(list.IndexOf(it), index);
+    ASSERT_EQ(list.IteratorAt(index), it);
+  }
+  ASSERT_EQ(list.IteratorAt(list.Size()), list.End());
+  ASSERT_EQ(list.IndexOf(list.End()), list.Size());
+}
+
+TEST(IndexedSkipListTest, CopyAndSwap) {
+  IndexedSkipList<std::string> first{"a", "b", "c"};
+  IndexedSkipList<std::string> second(first);
+  second.InsertAt(1, "d");
+  ASSERT_EQ(first.Size(), 3);
+  ASSERT_EQ(second.At(1), "d");
+  std::swap(first, second);
+  ASSERT_EQ(first.Size(), 4);
+  ASSERT_EQ(second.At(1), "b");
+  first = second;
+  ASSERT_EQ(first.Size(), 3);
+  first.Clear();
+  ASSERT_TRUE(first.IsEmpty());
+  first.PushBack("e");
+  ASSERT_EQ(first.At(0), "e");
+}
+
+TEST(IndexedSkipListTest, RandomOperationsMatchStdList) {
+  std::mt19937 mt(13);
+  IndexedSkipList<int> list;
+  std::list<int> expected;
+  for (int step = 0; step < 10000; ++step) {
+    size_t pos = expected.empty() ? 0 : mt() % (expected.size() + 1);
+    auto expected_it = expected.begin();
+    std::advance(expected_it, pos);
+    switch (mt() % 4) {
+      case 0:
+      case 1: {
+        int value = static_cast<int>(mt() % 1000);
+        list.InsertAt(pos, value);
+        expected.insert(expected_it, value);
+        break;
+      }
+      case 2:
+        if (expected_it != expected.end()) {
+          list.EraseAt(pos);
+          expected.erase(expected_it);
+        }
+        break;
+      default:
+        if (expected_it != expected.end()) {
+          ASSERT_EQ(list.At(pos), *expected_it);
+          list.Erase(list.IteratorAt(pos));
+          expected.erase(expected_it);
+        }
+    }
+  }
+  ASSERT_EQ(list.Size(), expected.size());
+  ASSERT_TRUE(std::equal(expected.begin(), expected.end(), list.Begin()));
+  ASSERT_TRUE(std::equal(expected.rbegin(), expected.rend(), std::make_reverse_iterator(list.End())));
+}
 
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,345 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include <fmt/core.h>
+
+#include "exceptions.hpp"
+
+// Doubly linked list which keeps up to K elements in every node.
+//
+// Elements of a node lie in one contiguous array, so traversal and Find touch
+// K times fewer nodes than List does. A full node is split in two halves on Insert,
+// a node which became less than half full is merged with the next one on Erase.
+//
+// Iterator stability: Insert and Erase invalidate iterators to the elements of the node
+// they modify and of its neighbour involved in a split or merge. Iterators to
+// elements of other nodes, including End(), stay valid.
+template <typename T, size_t K = std::max<size_t>(8, 256 / sizeof(T))>
+class UnrolledList{
+  static_assert(K >= 2, "Node must hold at least two elements");
+
+private:
+  class BaseNode{
+    friend class UnrolledList;
+
+    private:
+      BaseNode* prev_ = this;
+      BaseNode* next_ = this;
+      size_t count_ = 0;
+  };
+
+  class Node : public BaseNode{
+    friend class UnrolledList;
+
+    public:
+      Node() {
+      }
+
+      inline T* Values() noexcept {
+        return std::launder(reinterpret_cast<T*>(storage_));
+      }
+
+      ~Node() {
+        std::destroy_n(Values(), this->count_);
+      }
+
+    private:
+      alignas(T) unsigned char storage_[K * sizeof(T)];
+  };
+
+public:
+  class UnrolledListIterator{
+    friend class UnrolledList;
+
+    public:
+      using value_type = T;
+      using reference_type = value_type&;
+      using pointer_type = value_type*;
+      using reference = reference_type;
+      using pointer = pointer_type;
+      using difference_type = std::ptrdiff_t;
+      using iterator_category = std::bidirectional_iterator_tag;
+
+      inline bool operator==(const UnrolledListIterator& other) const {
+          return current == other.current && index == other.index;
+      };
+
+      inline bool operator!=(const UnrolledListIterator& other) const {
+          return !(*this == other);
+      };
+
+      inline reference_type operator*() const {
+          return static_cast<Node*>(current)->Values()[index];
+      };
+
+      UnrolledListIterator& operator++() {
+          if (++index == current->count_) {
+            current = current->next_;
+            index = 0;
+          }
+          return *this;
+      };
+
+      UnrolledListIterator operator++(int) {
+          UnrolledListIterator old = *this;
+          ++*this;
+          return old;
+      };
+
+      UnrolledListIterator& operator--() {
+          if (index == 0) {
+            current = current->prev_;
+            index = current->count_;
+          }
+          --index;
+          return *this;
+      };
+
+      UnrolledListIterator operator--(int) {
+          UnrolledListIterator old = *this;
+          --*this;
+          return old;
+      };
+
+      inline pointer_type operator->() const {
+          return &**this;
+      };
+
+  private:
+      UnrolledListIterator(const BaseNode* node, size_t pos) : current(const_cast<BaseNode*>(node)), index(pos) {
+      }
+  private:
+      BaseNode* current;
+      size_t index;
+  };
+
+public:
+  UnrolledList() {
+  }
+
+  explicit UnrolledList(size_t sz) {
+    while (sz--) {
+      PushBack(T());
+    }
+  }
+
+  UnrolledList(const std::initializer_list<T>& values) {
+    for (const auto& value : values) {
+      PushBack(value);
+    }
+  }
+
+  UnrolledList(const UnrolledList& other) {
+    for (auto it = other.Begin(); it != other.End(); ++it) {
+      PushBack(*it);
+    }
+  }
+
+  UnrolledList& operator=(const UnrolledList& other) {
+    if (this != &other) {
+      UnrolledList copy(other);
+      Swap(copy);
+    }
+    return *this;
+  }
+
+  UnrolledListIterator Begin() const noexcept {
+    return UnrolledListIterator(end_.next_, 0);
+  }
+
+  UnrolledListIterator End() const noexcept {
+    return UnrolledListIterator(&end_, 0);
+  }
+
+  inline T& Front() const {
+    return *Begin();
+  }
+
+  inline T& Back() const {
+    return *--End();
+  }
+
+  inline bool IsEmpty() const noexcept {
+    return size_ == 0;
+  }
+
+  inline size_t Size() const noexcept {
+    return size_;
+  }
+
+  static constexpr size_t NodeCapacity() noexcept {
+    return K;
+  }
+
+  void Swap(UnrolledList& a) {
+    std::swap(end_, a.end_);
+    std::swap(size_, a.size_);
+    a.FixSentinel();
+    FixSentinel();
+  }
+
+  UnrolledListIterator Find(const T& value) const {
+    for (BaseNode* node = end_.next_; node != &end_; node = node->next_) {
+      T* values = static_cast<Node*>(node)->Values();
+      for (size_t i = 0; i < node->count_; ++i) {
+        if (values[i] == value) {
+          return UnrolledListIterator(node, i);
+        }
+      }
+    }
+    return End();
+  }
+
+  void Erase(UnrolledListIterator pos) {
+    auto* node = static_cast<Node*>(pos.current);
+    T* values = node->Values();
+    std::move(values + pos.index + 1, values + node->count_, values + pos.index);
+    std::destroy_at(values + --node->count_);
+    --size_;
+
+    if (node->count_ == 0) {
+      UnlinkNode(node);
+    } else if (node->count_ < K / 2 && node->next_ != &end_ && node->count_ + node->next_->count_ <= K) {
+      auto* next = static_cast<Node*>(node->next_);
+      MoveValues(next, 0, next->count_, node);
+      UnlinkNode(next);
+    }
+  }
+
+  // Inserts before pos
+  void Insert(UnrolledListIterator pos, const T& value) {
+    BaseNode* node = pos.current;
+    size_t index = pos.index;
+    if (node == &end_) {
+      // Append to the last node
+      node = end_.prev_;
+      index = node->count_;
+      if (node == &end_ || node->count_ == K) {
+        node = LinkNodeBefore(&end_);
+        index = 0;
+      }
+    } else if (node->count_ == K) {
+      // value may refer to an element of the moved half, copy it before splitting
+      T copy = value;
+      // Split: upper half goes to a new node
+      auto* upper = LinkNodeBefore(node->next_);
+      size_t half = K / 2;
+      MoveValues(static_cast<Node*>(node), half, K, upper);
+      if (index > half) {
+        node = upper;
+        index -= half;
+      }
+      InsertIntoNode(static_cast<Node*>(node), index, copy);
+      return;
+    }
+    InsertIntoNode(static_cast<Node*>(node), index, value);
+  }
+
+  void Clear() noexcept {
+    BaseNode* node = end_.next_;
+    while (node != &end_) {
+      BaseNode* next = node->next_;
+      delete static_cast<Node*>(node);
+      node = next;
+    }
+    end_.prev_ = end_.next_ = &end_;
+    size_ = 0;
+  }
+
+  void PushBack(const T& value) {
+    Insert(End(), value);
+  }
+
+  void PushFront(const T& value) {
+    Insert(Begin(), value);
+  }
+
+  void PopBack() {
+    if (IsEmpty()) {
+      throw ListIsEmptyException("PopBack from empty list");
+    }
+    Erase(--End());
+  }
+
+  void PopFront() {
+    if (IsEmpty()) {
+      throw ListIsEmptyException("PopFront from empty list");
+    }
+    Erase(Begin());
+  }
+
+  ~UnrolledList() {
+    Clear();
+  }
+
+private:
+  Node* LinkNodeBefore(BaseNode* pos) {
+    auto* node = new Node();
+    node->prev_ = pos->prev_;
+    node->next_ = pos;
+    pos->prev_->next_ = node;
+    pos->prev_ = node;
+    return node;
+  }
+
+  void UnlinkNode(Node* node) noexcept {
+    node->prev_->next_ = node->next_;
+    node->next_->prev_ = node->prev_;
+    delete node;
+  }
+
+  void InsertIntoNode(Node* node, size_t index, const T& value) {
+    T* values = node->Values();
+    if (index == node->count_) {
+      new (values + index) T(value);
+    } else {
+      // value may refer to an element of this node
+      T copy = value;
+      new (values + node->count_) T(std::move(values[node->count_ - 1]));
+      std::move_backward(values + index, values + node->count_ - 1, values + node->count_);
+      values[index] = std::move(copy);
+    }
+    ++node->count_;
+    ++size_;
+  }
+
+  // Appends from->[begin, end) to the end of to and removes them from from
+  static void MoveValues(Node* from, size_t begin, size_t end, Node* to) {
+    T* source = from->Values();
+    T* target = to->Values() + to->count_;
+    std::uninitialized_move(source + begin, source + end, target);
+    to->count_ += end - begin;
+    std::move(source + end, source + from->count_, source + begin);
+    std::destroy(source + from->count_ - (end - begin), source + from->count_);
+    from->count_ -= end - begin;
+  }
+
+  void FixSentinel() noexcept {
+    if (size_ == 0) {
+      end_.prev_ = end_.next_ = &end_;
+    } else {
+      end_.next_->prev_ = &end_;
+      end_.prev_->next_ = &end_;
+    }
+  }
+
+private:
+  BaseNode end_;
+  size_t size_ = 0;
+};
+
+
+namespace std {
+  // Global swap overloading
+  template <typename T, size_t K>
+  void swap(UnrolledList<T, K>& a, UnrolledList<T, K>& b) {
+    a.Swap(b);
+  }
+}
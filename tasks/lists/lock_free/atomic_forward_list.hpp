@@ -0,0 +1,184 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
+#include <utility>
+
+
+// Concurrent LIFO on a singly linked list: the Treiber stack (R. K. Treiber, 1986).
+//
+// PushFront and PopFront are one compare_exchange on the head each. The head keeps
+// a 16-bit tag in the unused upper bits of the pointer and every change bumps it,
+// so a PopFront which read the head before the node was popped and pushed again
+// fails its compare_exchange (the ABA problem).
+//
+// A PopFront may still read next_ of a node which another thread has just popped.
+// That's why popped nodes are never freed while the list lives: they go to
+// a second tagged stack and are reused by the next pushes. The list takes as much
+// memory as it held at its peak.
+template <typename T>
+class AtomicForwardList{
+private:
+  class Node{
+    friend class AtomicForwardList;
+
+    private:
+      inline T* Value() noexcept {
+        return std::launder(reinterpret_cast<T*>(storage_));
+      }
+
+    private:
+      // Plain Node*, but read concurrently by PopFront of other threads
+      std::atomic<Node*> next_{nullptr};
+      alignas(T) unsigned char storage_[sizeof(T)];
+  };
+
+  // Node* in the lower 48 bits, tag in the upper 16
+  using Tagged = uint64_t;
+
+  static_assert(sizeof(Node*) == sizeof(Tagged), "Tagged pointers need a 64-bit platform");
+
+  static constexpr unsigned POINTER_BITS = 48;
+  static constexpr Tagged POINTER_MASK = (Tagged{1} << POINTER_BITS) - 1;
+
+  static inline Node* NodeOf(Tagged head) noexcept {
+    return reinterpret_cast<Node*>(head & POINTER_MASK);
+  }
+
+  // head with node instead of its pointer and the next tag
+  static inline Tagged Replace(Tagged head, const Node* node) noexcept {
+    return ((head & ~POINTER_MASK) + (Tagged{1} << POINTER_BITS)) | reinterpret_cast<Tagged>(node);
+  }
+
+public:
+  AtomicForwardList() {
+  }
+
+  AtomicForwardList(const AtomicForwardList&) = delete;
+
+  AtomicForwardList& operator=(const AtomicForwardList&) = delete;
+
+  void PushFront(const T& value) {
+    EmplaceFront(value);
+  }
+
+  void PushFront(T&& value) {
+    EmplaceFront(std::move(value));
+  }
+
+  template <typename... Args>
+  void EmplaceFront(Args&&... args) {
+    Node* node = AcquireNode();
+    try {
+      new (node->storage_) T(std::forward<Args>(args)...);
+    } catch (...) {
+      Push(free_, node, node);
+      throw;
+    }
+    Push(head_, node, node);
+  }
+
+  // The front element, nullopt if the list is empty
+  std::optional<T> PopFront() {
+    Node* node = Pop(head_);
+    if (node == nullptr) {
+      return std::nullopt;
+    }
+    std::optional<T> value(std::move(*node->Value()));
+    std::destroy_at(node->Value());
+    Push(free_, node, node);
+    return value;
+  }
+
+  // Takes all elements with one exchange of the head and calls func(T&&) for each,
+  // front first. Returns how many there were. If func throws, the rest are dropped
+  template <typename Func>
+  size_t PopAll(Func func) {
+    Tagged head = head_.load(std::memory_order_relaxed);
+    while (NodeOf(head) != nullptr &&
+           !head_.compare_exchange_weak(head, Replace(head, nullptr), std::memory_order_acquire, std::memory_order_relaxed)) {
+    }
+    Node* first = NodeOf(head);
+    if (first == nullptr) {
+      return 0;
+    }
+
+    // The chain is ours now
+    size_t count = 0;
+    Node* last = first;
+    try {
+      for (Node* node = first; node != nullptr; node = node->next_.load(std::memory_order_relaxed)) {
+        last = node;
+        ++count;
+        func(std::move(*node->Value()));
+        std::destroy_at(node->Value());
+      }
+    } catch (...) {
+      std::destroy_at(last->Value());
+      for (Node* node = last->next_.load(std::memory_order_relaxed); node != nullptr;
+           node = node->next_.load(std::memory_order_relaxed)) {
+        std::destroy_at(node->Value());
+        last = node;
+      }
+      Push(free_, first, last);
+      throw;
+    }
+    Push(free_, first, last);
+    return count;
+  }
+
+  // A snapshot: another thread may change it right away
+  inline bool IsEmpty() const noexcept {
+    return NodeOf(head_.load(std::memory_order_acquire)) == nullptr;
+  }
+
+  // No other thread may use the list
+  ~AtomicForwardList() {
+    for (Node* node = NodeOf(head_.load(std::memory_order_relaxed)); node != nullptr;) {
+      Node* next = node->next_.load(std::memory_order_relaxed);
+      std::destroy_at(node->Value());
+      delete node;
+      node = next;
+    }
+    for (Node* node = NodeOf(free_.load(std::memory_order_relaxed)); node != nullptr;) {
+      Node* next = node->next_.load(std::memory_order_relaxed);
+      delete node;
+      node = next;
+    }
+  }
+
+private:
+  Node* AcquireNode() {
+    Node* node = Pop(free_);
+    return node != nullptr ? node : new Node();
+  }
+
+  // Links the chain first..last in front of stack
+  static void Push(std::atomic<Tagged>& stack, Node* first, Node* last) noexcept {
+    Tagged head = stack.load(std::memory_order_relaxed);
+    do {
+      last->next_.store(NodeOf(head), std::memory_order_relaxed);
+    } while (!stack.compare_exchange_weak(head, Replace(head, first), std::memory_order_release, std::memory_order_relaxed));
+  }
+
+  static Node* Pop(std::atomic<Tagged>& stack) noexcept {
+    Tagged head = stack.load(std::memory_order_acquire);
+    while (NodeOf(head) != nullptr) {
+      // The node may be popped and reused meanwhile, then the tag has changed and the exchange fails
+      Node* next = NodeOf(head)->next_.load(std::memory_order_relaxed);
+      if (stack.compare_exchange_weak(head, Replace(head, next), std::memory_order_acquire, std::memory_order_acquire)) {
+        return NodeOf(head);
+      }
+    }
+    return nullptr;
+  }
+
+private:
+  alignas(64) std::atomic<Tagged> head_{0};
+  // Popped nodes, reused by pushes
+  alignas(64) std::atomic<Tagged> free_{0};
+};
@@ -0,0 +1,190 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+
+
+// Hazard pointers (M. Michael, 2004): safe memory reclamation for lock-free structures.
+//
+// Before dereferencing a shared node a thread publishes it in one of its SLOTS
+// and checks that the node is still reachable. A removed node is Retire()d instead
+// of deleted and is freed by a later scan once no slot holds it.
+//
+// One process-wide domain serves all structures. Each thread takes a record
+// on first use and returns it on exit, so at most MAX_THREADS threads may use
+// hazard pointers at once.
+class HazardPointers{
+public:
+  static constexpr size_t MAX_THREADS = 128;
+  static constexpr size_t SLOTS = 2;
+  // A thread scans once it has this many retired nodes. It's larger than the number
+  // of slots, so every scan frees at least half of them
+  static constexpr size_t RETIRE_THRESHOLD = 2 * MAX_THREADS * SLOTS;
+
+  using Slot = std::atomic<const void*>;
+
+  // SLOTS slots of the calling thread. The thread publishes a pointer with
+  // a seq_cst store and clears it with a release store of nullptr
+  static inline Slot* Slots() noexcept {
+    return Local().record->slots;
+  }
+
+  // ptr is unreachable for new readers; deletes it once no thread protects it
+  template <typename T>
+  static void Retire(T* ptr) {
+    ThreadState& local = Local();
+    local.retired[local.retired_count++] = {ptr, [](void* p) {
+      delete static_cast<T*>(p);
+    }};
+    if (local.retired_count == RETIRE_THRESHOLD) {
+      Instance().Scan(local.retired, local.retired_count);
+    }
+  }
+
+  ~HazardPointers() {
+    // All threads have exited: nothing is protected anymore
+    for (Orphans* batch = orphans_; batch != nullptr;) {
+      Orphans* next = batch->next;
+      for (size_t i = 0; i < batch->count; ++i) {
+        batch->retired[i].deleter(batch->retired[i].ptr);
+      }
+      delete batch;
+      batch = next;
+    }
+  }
+
+private:
+  struct alignas(64) Record {
+    std::atomic<bool> active{false};
+    Slot slots[SLOTS] = {};
+  };
+
+  struct Retired {
+    void* ptr;
+    void (*deleter)(void*);
+  };
+
+  // Nodes left by exited threads which were still protected
+  struct Orphans {
+    Orphans* next;
+    size_t count;
+    Retired retired[RETIRE_THRESHOLD];
+  };
+
+  struct ThreadState {
+    Record* record;
+    Retired retired[RETIRE_THRESHOLD];
+    size_t retired_count = 0;
+
+    ThreadState() : record(Instance().Acquire()) {
+    }
+
+    ~ThreadState() {
+      HazardPointers& domain = Instance();
+      for (auto& slot : record->slots) {
+        slot.store(nullptr, std::memory_order_release);
+      }
+      domain.Scan(retired, retired_count);
+      if (retired_count != 0) {
+        domain.Adopt(retired, retired_count);
+      }
+      record->active.store(false, std::memory_order_release);
+    }
+  };
+
+  static HazardPointers& Instance() {
+    static HazardPointers domain;
+    return domain;
+  }
+
+  static ThreadState& Local() {
+    thread_local ThreadState state;
+    return state;
+  }
+
+  Record* Acquire() {
+    for (auto& record : records_) {
+      bool expected = false;
+      if (!record.active.load(std::memory_order_relaxed) &&
+          record.active.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+        return &record;
+      }
+    }
+    throw std::runtime_error("Too many threads use hazard pointers");
+  }
+
+  // Frees retired nodes which no slot holds and compacts the rest to the front
+  void Scan(Retired* retired, size_t& count) {
+    const void* hazards[MAX_THREADS * SLOTS];
+    size_t hazard_count = 0;
+    for (auto& record : records_) {
+      for (auto& slot : record.slots) {
+        if (const void* ptr = slot.load(std::memory_order_seq_cst); ptr != nullptr) {
+          hazards[hazard_count++] = ptr;
+        }
+      }
+    }
+    std::sort(hazards, hazards + hazard_count);
+
+    size_t kept = 0;
+    for (size_t i = 0; i < count; ++i) {
+      if (std::binary_search(hazards, hazards + hazard_count, static_cast<const void*>(retired[i].ptr))) {
+        retired[kept++] = retired[i];
+      } else {
+        retired[i].deleter(retired[i].ptr);
+      }
+    }
+    count = kept;
+
+    if (has_orphans_.load(std::memory_order_acquire)) {
+      ScanOrphans(hazards, hazard_count);
+    }
+  }
+
+  void ScanOrphans(const void** hazards, size_t hazard_count) {
+    std::unique_lock lock(orphans_mutex_, std::try_to_lock);
+    if (!lock.owns_lock()) {
+      return;
+    }
+    Orphans** link = &orphans_;
+    while (*link != nullptr) {
+      Orphans* batch = *link;
+      size_t kept = 0;
+      for (size_t i = 0; i < batch->count; ++i) {
+        auto* ptr = static_cast<const void*>(batch->retired[i].ptr);
+        if (std::binary_search(hazards, hazards + hazard_count, ptr)) {
+          batch->retired[kept++] = batch->retired[i];
+        } else {
+          batch->retired[i].deleter(batch->retired[i].ptr);
+        }
+      }
+      batch->count = kept;
+      if (kept == 0) {
+        *link = batch->next;
+        delete batch;
+      } else {
+        link = &batch->next;
+      }
+    }
+    has_orphans_.store(orphans_ != nullptr, std::memory_order_release);
+  }
+
+  void Adopt(Retired* retired, size_t count) {
+    auto* batch = new Orphans{nullptr, count, {}};
+    std::copy(retired, retired + count, batch->retired);
+    std::lock_guard lock(orphans_mutex_);
+    batch->next = orphans_;
+    orphans_ = batch;
+    has_orphans_.store(true, std::memory_order_release);
+  }
+
+private:
+  Record records_[MAX_THREADS];
+  std::mutex orphans_mutex_;
+  Orphans* orphans_ = nullptr;
+  std::atomic<bool> has_orphans_{false};
+};
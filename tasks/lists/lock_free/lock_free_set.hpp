@@ -0,0 +1,217 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+
+#include "hazard_pointers.hpp"
+
+
+// Lock-free sorted set on a singly linked list (T. Harris, 2001; M. Michael, 2002).
+//
+// Erase first marks the lowest bit of the victim's next link, which freezes it:
+// a CAS expecting an unmarked link fails, so nobody can insert after the victim.
+// Then the victim is unlinked, by Erase itself or by any thread which walks past it.
+// Unlinked nodes are retired to HazardPointers, so a thread still reading them
+// never sees freed memory.
+//
+// Insert, Erase and Contains are lock-free and O(N). Size() is exact only when
+// no operation is in progress.
+template <typename T, typename Compare = std::less<T>>
+class LockFreeSet{
+private:
+  class Node{
+    friend class LockFreeSet;
+
+    public:
+      explicit Node(const T& value) : value_(value) {
+      }
+
+    private:
+      const T value_;
+      // Node* with the deletion mark in the lowest bit
+      std::atomic<uintptr_t> next_{0};
+  };
+
+  static constexpr uintptr_t MARK = 1;
+
+  static inline Node* ToNode(uintptr_t link) noexcept {
+    return reinterpret_cast<Node*>(link & ~MARK);
+  }
+
+  static inline uintptr_t ToLink(const Node* node) noexcept {
+    return reinterpret_cast<uintptr_t>(node);
+  }
+
+  static inline bool IsMarked(uintptr_t link) noexcept {
+    return (link & MARK) != 0;
+  }
+
+  // Result of Search: prev holds the unmarked link to current,
+  // current is the first node not less than the value or nullptr
+  struct Position {
+    std::atomic<uintptr_t>* prev;
+    Node* current;
+    uintptr_t next;
+    HazardPointers::Slot* slots;
+  };
+
+public:
+  LockFreeSet() {
+  }
+
+  explicit LockFreeSet(Compare comp) : comp_(comp) {
+  }
+
+  LockFreeSet(const LockFreeSet&) = delete;
+
+  LockFreeSet& operator=(const LockFreeSet&) = delete;
+
+  // Returns false if value is already in the set
+  bool Insert(const T& value) {
+    Node* node = new Node(value);
+    Position pos{nullptr, nullptr, 0, HazardPointers::Slots()};
+    while (true) {
+      if (Search(value, pos)) {
+        ReleaseHazards(pos);
+        delete node;
+        return false;
+      }
+      node->next_.store(ToLink(pos.current), std::memory_order_relaxed);
+      uintptr_t expected = ToLink(pos.current);
+      if (pos.prev->compare_exchange_strong(expected, ToLink(node), std::memory_order_release, std::memory_order_relaxed)) {
+        ReleaseHazards(pos);
+        size_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+      }
+    }
+  }
+
+  // Returns false if value isn't in the set
+  bool Erase(const T& value) {
+    Position pos{nullptr, nullptr, 0, HazardPointers::Slots()};
+    while (true) {
+      if (!Search(value, pos)) {
+        ReleaseHazards(pos);
+        return false;
+      }
+      // Logical deletion: whoever marks the link owns the erase
+      uintptr_t next = pos.next;
+      if (!pos.current->next_.compare_exchange_strong(next, next | MARK, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+        continue;
+      }
+      uintptr_t expected = ToLink(pos.current);
+      if (pos.prev->compare_exchange_strong(expected, next, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        ReleaseHazards(pos);
+        HazardPointers::Retire(pos.current);
+      } else {
+        // Someone changed prev: let Search unlink the node
+        Search(value, pos);
+        ReleaseHazards(pos);
+      }
+      size_.fetch_sub(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+
+  bool Contains(const T& value) const {
+    Position pos{nullptr, nullptr, 0, HazardPointers::Slots()};
+    bool found = Search(value, pos);
+    ReleaseHazards(pos);
+    return found;
+  }
+
+  inline size_t Size() const noexcept {
+    return size_.load(std::memory_order_relaxed);
+  }
+
+  inline bool IsEmpty() const noexcept {
+    return Size() == 0;
+  }
+
+  // Calls func for every value in order. Not safe concurrently with Erase
+  template <typename Func>
+  void ForEach(Func func) const {
+    for (Node* node = ToNode(head_.load(std::memory_order_acquire)); node != nullptr;) {
+      uintptr_t next = node->next_.load(std::memory_order_acquire);
+      if (!IsMarked(next)) {
+        func(node->value_);
+      }
+      node = ToNode(next);
+    }
+  }
+
+  // No other thread may use the set
+  ~LockFreeSet() {
+    Node* node = ToNode(head_.load(std::memory_order_relaxed));
+    while (node != nullptr) {
+      Node* next = ToNode(node->next_.load(std::memory_order_relaxed));
+      delete node;
+      node = next;
+    }
+  }
+
+private:
+  // Finds the first node not less than value, unlinking marked nodes on the way.
+  // Leaves pos.current and the node owning pos.prev protected in pos.slots
+  bool Search(const T& value, Position& pos) const {
+    while (true) {
+      if (auto found = TrySearch(value, pos); found.has_value()) {
+        return *found;
+      }
+    }
+  }
+
+  // One pass of Search from the head, nullopt if it has to start over
+  std::optional<bool> TrySearch(const T& value, Position& pos) const {
+    // The two slots take turns: one holds current, the other the node owning prev
+    size_t current_slot = 0;
+    std::atomic<uintptr_t>* prev = &head_;
+    Node* current = ToNode(prev->load(std::memory_order_acquire));
+    while (true) {
+      if (current == nullptr) {
+        pos.prev = prev;
+        pos.current = nullptr;
+        pos.next = 0;
+        return false;
+      }
+      pos.slots[current_slot].store(current, std::memory_order_seq_cst);
+      // current could have been unlinked and freed before it was protected
+      if (prev->load(std::memory_order_seq_cst) != ToLink(current)) {
+        return std::nullopt;
+      }
+      uintptr_t next = current->next_.load(std::memory_order_acquire);
+      if (IsMarked(next)) {
+        uintptr_t expected = ToLink(current);
+        if (!prev->compare_exchange_strong(expected, next & ~MARK, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+          return std::nullopt;
+        }
+        HazardPointers::Retire(current);
+        current = ToNode(next);
+        continue;
+      }
+      if (!comp_(current->value_, value)) {
+        pos.prev = prev;
+        pos.current = current;
+        pos.next = next;
+        return !comp_(value, current->value_);
+      }
+      // current becomes the owner of prev and keeps its slot, the next node takes the other one
+      current_slot ^= 1;
+      prev = &current->next_;
+      current = ToNode(next);
+    }
+  }
+
+  static void ReleaseHazards(Position& pos) noexcept {
+    pos.slots[0].store(nullptr, std::memory_order_release);
+    pos.slots[1].store(nullptr, std::memory_order_release);
+  }
+
+private:
+  mutable std::atomic<uintptr_t> head_{0};
+  std::atomic<size_t> size_{0};
+  Compare comp_;
+};
@@ -0,0 +1,172 @@
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+
+#include <benchmark/benchmark.h>
+#include <fmt/core.h>
+
+#include "../atomic_forward_list.hpp"
+#include "../lock_free_set.hpp"
+#include "../../forward/forward_list.hpp"
+#include "../../list/list.hpp"
+
+// Sorted List under one mutex: the baseline for LockFreeSet
+class LockedListSet {
+public:
+  bool Insert(int value) {
+    std::lock_guard lock(mutex_);
+    auto it = LowerBound(value);
+    if (it != list_.End() && *it == value) {
+      return false;
+    }
+    list_.Insert(it, value);
+    return true;
+  }
+
+  bool Erase(int value) {
+    std::lock_guard lock(mutex_);
+    auto it = LowerBound(value);
+    if (it == list_.End() || *it != value) {
+      return false;
+    }
+    list_.Erase(it);
+    return true;
+  }
+
+  bool Contains(int value) {
+    std::lock_guard lock(mutex_);
+    auto it = LowerBound(value);
+    return it != list_.End() && *it == value;
+  }
+
+private:
+  List<int>::ListIterator LowerBound(int value) const {
+    auto it = list_.Begin();
+    while (it != list_.End() && *it < value) {
+      ++it;
+    }
+    return it;
+  }
+
+private:
+  std::mutex mutex_;
+  List<int> list_;
+};
+
+const int KEYS = 256;
+
+template <typename Set>
+void FillHalf(Set& set) {
+  for (int key = 0; key < KEYS; key += 2) {
+    set.Insert(key);
+  }
+}
+
+// update_percent of operations are inserts and erases in equal parts, the rest are lookups.
+// Thread 0 creates the set before the loop, other threads may only touch it inside
+template <typename Set>
+void RunMixed(benchmark::State& state, const std::unique_ptr<Set>& set, unsigned update_percent) {
+  std::mt19937 mt(state.thread_index());
+  for (auto _ : state) {
+    int key = static_cast<int>(mt() % KEYS);
+    unsigned dice = mt() % 100;
+    if (dice < update_percent / 2) {
+      benchmark::DoNotOptimize(set->Insert(key));
+    } else if (dice < update_percent) {
+      benchmark::DoNotOptimize(set->Erase(key));
+    } else {
+      benchmark::DoNotOptimize(set->Contains(key));
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// ForwardList under one mutex: the baseline for AtomicForwardList
+class LockedForwardList {
+public:
+  void PushFront(int value) {
+    std::lock_guard lock(mutex_);
+    list_.PushFront(value);
+  }
+
+  std::optional<int> PopFront() {
+    std::lock_guard lock(mutex_);
+    if (list_.IsEmpty()) {
+      return std::nullopt;
+    }
+    int value = list_.Front();
+    list_.PopFront();
+    return value;
+  }
+
+private:
+  std::mutex mutex_;
+  ForwardList<int> list_;
+};
+
+const int STACK_SIZE = 64;
+
+// Every thread pushes a value and pops one, like threads sharing a free stack.
+// Thread 0 creates the stack before the loop, other threads may only touch it inside
+template <typename Stack>
+void RunPushPop(benchmark::State& state, const std::unique_ptr<Stack>& stack) {
+  int value = state.thread_index();
+  for (auto _ : state) {
+    stack->PushFront(value++);
+    benchmark::DoNotOptimize(stack->PopFront());
+  }
+  state.SetItemsProcessed(state.iterations() * 2);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::unique_ptr<LockFreeSet<int>> lock_free_set;
+std::unique_ptr<LockedListSet> locked_set;
+std::unique_ptr<AtomicForwardList<int>> atomic_stack;
+std::unique_ptr<LockedForwardList> locked_stack;
+
+void BM_LockFreeSetMixed(benchmark::State& state) {
+  if (state.thread_index() == 0) {
+    lock_free_set = std::make_unique<LockFreeSet<int>>();
+    FillHalf(*lock_free_set);
+  }
+  RunMixed(state, lock_free_set, state.range(0));
+}
+
+void BM_LockedListSetMixed(benchmark::State& state) {
+  if (state.thread_index() == 0) {
+    locked_set = std::make_unique<LockedListSet>();
+    FillHalf(*locked_set);
+  }
+  RunMixed(state, locked_set, state.range(0));
+}
+
+void BM_AtomicForwardListPushPop(benchmark::State& state) {
+  if (state.thread_index() == 0) {
+    atomic_stack = std::make_unique<AtomicForwardList<int>>();
+    for (int i = 0; i < STACK_SIZE; ++i) {
+      atomic_stack->PushFront(i);
+    }
+  }
+  RunPushPop(state, atomic_stack);
+}
+
+void BM_LockedForwardListPushPop(benchmark::State& state) {
+  if (state.thread_index() == 0) {
+    locked_stack = std::make_unique<LockedForwardList>();
+    for (int i = 0; i < STACK_SIZE; ++i) {
+      locked_stack->PushFront(i);
+    }
+  }
+  RunPushPop(state, locked_stack);
+}
+
+
+// Argument: percent of updates
+BENCHMARK(BM_LockFreeSetMixed)->Arg(10)->Arg(50)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_LockedListSetMixed)->Arg(10)->Arg(50)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_AtomicForwardListPushPop)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_LockedForwardListPushPop)->ThreadRange(1, 16)->UseRealTime();
+
+
+BENCHMARK_MAIN();
@@ -0,0 +1,243 @@
+#include <atomic>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fmt/core.h>
+#include <gtest/gtest.h>
+
+#include "../atomic_forward_list.hpp"
+#include "../lock_free_set.hpp"
+
+template <typename T, typename Compare>
+std::vector<T> Values(const LockFreeSet<T, Compare>& set) {
+  std::vector<T> values;
+  set.ForEach([&](const T& value) {
+    values.push_back(value);
+  });
+  return values;
+}
+
+template <typename Func>
+void RunThreads(size_t count, Func func) {
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < count; ++i) {
+    threads.emplace_back(func, i);
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+const size_t THREADS = 8;
+
+
+TEST(LockFreeSetTest, InsertEraseContains) {
+  LockFreeSet<int> set;
+  ASSERT_TRUE(set.IsEmpty());
+  ASSERT_TRUE(set.Insert(5));
+  ASSERT_TRUE(set.Insert(1));
+  ASSERT_TRUE(set.Insert(3));
+  ASSERT_FALSE(set.Insert(3));
+  ASSERT_EQ(set.Size(), 3);
+  ASSERT_TRUE(set.Contains(1));
+  ASSERT_FALSE(set.Contains(2));
+  ASSERT_EQ(Values(set), (std::vector<int>{1, 3, 5}));
+
+  ASSERT_TRUE(set.Erase(3));
+  ASSERT_FALSE(set.Erase(3));
+  ASSERT_FALSE(set.Erase(4));
+  ASSERT_FALSE(set.Contains(3));
+  ASSERT_EQ(Values(set), (std::vector<int>{1, 5}));
+  ASSERT_EQ(set.Size(), 2);
+}
+
+TEST(LockFreeSetTest, CustomComparator) {
+  LockFreeSet<std::string, std::greater<std::string>> set;
+  for (const char* value : {"b", "d", "a", "c"}) {
+    set.Insert(value);
+  }
+  ASSERT_EQ(Values(set), (std::vector<std::string>{"d", "c", "b", "a"}));
+  ASSERT_TRUE(set.Erase("d"));
+  ASSERT_EQ(Values(set).front(), "c");
+}
+
+TEST(LockFreeSetTest, RandomOperationsMatchStdSet) {
+  std::mt19937 mt(3);
+  LockFreeSet<int> set;
+  std::set<int> expected;
+  for (int step = 0; step < 20000; ++step) {
+    int value = static_cast<int>(mt() % 500);
+    switch (mt() % 3) {
+      case 0:
+        ASSERT_EQ(set.Insert(value), expected.insert(value).second);
+        break;
+      case 1:
+        ASSERT_EQ(set.Erase(value), expected.erase(value) == 1);
+        break;
+      default:
+        ASSERT_EQ(set.Contains(value), expected.count(value) == 1);
+    }
+  }
+  ASSERT_EQ(Values(set), std::vector<int>(expected.begin(), expected.end()));
+}
+
+TEST(LockFreeSetStressTest, DisjointInserts) {
+  const int per_thread = 500;
+  LockFreeSet<int> set;
+  RunThreads(THREADS, [&](size_t thread) {
+    for (int i = 0; i < per_thread; ++i) {
+      ASSERT_TRUE(set.Insert(i * static_cast<int>(THREADS) + static_cast<int>(thread)));
+    }
+  });
+  ASSERT_EQ(set.Size(), THREADS * per_thread);
+  auto values = Values(set);
+  ASSERT_EQ(values.size(), THREADS * per_thread);
+  for (size_t i = 0; i < values.size(); ++i) {
+    ASSERT_EQ(values[i], static_cast<int>(i));
+  }
+}
+
+TEST(LockFreeSetStressTest, SameKeysInsertedAndErasedOnce) {
+  const int keys = 1000;
+  LockFreeSet<int> set;
+  std::atomic<int> inserted = 0;
+  RunThreads(THREADS, [&](size_t) {
+    for (int i = 0; i < keys; ++i) {
+      if (set.Insert(i)) {
+        inserted.fetch_add(1);
+      }
+    }
+  });
+  ASSERT_EQ(inserted.load(), keys);
+  ASSERT_EQ(set.Size(), keys);
+
+  std::atomic<int> erased = 0;
+  RunThreads(THREADS, [&](size_t thread) {
+    for (int i = 0; i < keys; ++i) {
+      // Opposite directions collide in the middle
+      int key = thread % 2 == 0 ? i : keys - 1 - i;
+      if (set.Erase(key)) {
+        erased.fetch_add(1);
+      }
+    }
+  });
+  ASSERT_EQ(erased.load(), keys);
+  ASSERT_TRUE(set.IsEmpty());
+  ASSERT_TRUE(Values(set).empty());
+}
+
+TEST(LockFreeSetStressTest, MixedOperationsKeepOwnedKeys) {
+  // Thread t alone inserts and erases keys equal to t modulo THREADS, and reads all keys
+  const int keys = 512;
+  LockFreeSet<int> set;
+  std::vector<std::set<int>> owned(THREADS);
+  RunThreads(THREADS, [&](size_t thread) {
+    std::mt19937 mt(static_cast<unsigned>(thread));
+    auto& model = owned[thread];
+    for (int step = 0; step < 5000; ++step) {
+      int key = static_cast<int>(mt() % keys);
+      if (static_cast<size_t>(key) % THREADS != thread) {
+        set.Contains(key);
+      } else if (mt() % 2 == 0) {
+        ASSERT_EQ(set.Insert(key), model.insert(key).second);
+      } else {
+        ASSERT_EQ(set.Erase(key), model.erase(key) == 1);
+      }
+    }
+  });
+  std::set<int> expected;
+  for (auto& model : owned) {
+    expected.insert(model.begin(), model.end());
+  }
+  ASSERT_EQ(Values(set), std::vector<int>(expected.begin(), expected.end()));
+  ASSERT_EQ(set.Size(), expected.size());
+}
+
+
+TEST(AtomicForwardListTest, LastInFirstOut) {
+  AtomicForwardList<std::string> list;
+  ASSERT_TRUE(list.IsEmpty());
+  ASSERT_FALSE(list.PopFront().has_value());
+  std::string value = "a";
+  list.PushFront(value);
+  list.PushFront(std::string("b"));
+  list.EmplaceFront(3, 'c');
+  ASSERT_FALSE(list.IsEmpty());
+  ASSERT_EQ(list.PopFront(), "ccc");
+  ASSERT_EQ(list.PopFront(), "b");
+  list.PushFront("d");
+  ASSERT_EQ(list.PopFront(), "d");
+  ASSERT_EQ(list.PopFront(), "a");
+  ASSERT_FALSE(list.PopFront().has_value());
+}
+
+TEST(AtomicForwardListTest, PopAllTakesEverything) {
+  AtomicForwardList<int> list;
+  ASSERT_EQ(list.PopAll([](int) {}), 0);
+  for (int i = 0; i < 5; ++i) {
+    list.PushFront(i);
+  }
+  std::vector<int> values;
+  ASSERT_EQ(list.PopAll([&](int value) {
+    values.push_back(value);
+  }), 5);
+  ASSERT_EQ(values, std::vector<int>({4, 3, 2, 1, 0}));
+  ASSERT_TRUE(list.IsEmpty());
+  // Nodes are reused
+  list.PushFront(7);
+  ASSERT_EQ(list.PopFront(), 7);
+}
+
+TEST(AtomicForwardListTest, PopAllRethrows) {
+  AtomicForwardList<std::string> list;
+  for (int i = 0; i < 5; ++i) {
+    list.PushFront(std::to_string(i));
+  }
+  int calls = 0;
+  ASSERT_THROW(list.PopAll([&](std::string) {
+    if (++calls == 2) {
+      throw std::runtime_error("stop");
+    }
+  }), std::runtime_error);
+  ASSERT_TRUE(list.IsEmpty());
+  list.PushFront("x");
+  ASSERT_EQ(list.PopFront(), "x");
+}
+
+TEST(AtomicForwardListStressTest, EveryValuePoppedOnce) {
+  const int per_thread = 20000;
+  AtomicForwardList<int> list;
+  std::vector<std::atomic<int>> seen(THREADS * per_thread);
+  RunThreads(THREADS, [&](size_t thread) {
+    for (int i = 0; i < per_thread; ++i) {
+      list.PushFront(static_cast<int>(thread) * per_thread + i);
+      if (i % 2 == 1) {
+        for (int pops = 0; pops < 2; ++pops) {
+          if (auto value = list.PopFront(); value.has_value()) {
+            seen[*value].fetch_add(1);
+          }
+        }
+      }
+    }
+    if (thread == 0) {
+      list.PopAll([&](int value) {
+        seen[value].fetch_add(1);
+      });
+    }
+  });
+  list.PopAll([&](int value) {
+    seen[value].fetch_add(1);
+  });
+  for (auto& count : seen) {
+    ASSERT_EQ(count.load(), 1);
+  }
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
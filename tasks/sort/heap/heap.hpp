@@ -0,0 +1,290 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "../../vector/vector/vector.hpp"
+
+// Priority queue on a d-ary heap in one array (Vector).
+//
+// Node i has children Arity * i + 1, ..., Arity * i + Arity. A wider node makes the heap
+// log2(Arity) times lower: Push compares with fewer parents and children of a node
+// are next to each other in memory, so Pop reads Arity of them from one or two cache
+// lines instead of jumping between log2(N) levels. Pop compares more per level, so
+// Arity 4 is usually the best, 8 pays off for big heaps and cheap comparisons.
+//
+// Like std::priority_queue, Top() is the greatest element by Compare.
+template <typename T, size_t Arity = 4, typename Compare = std::less<T>>
+class DaryHeap{
+  static_assert(Arity >= 2, "Heap nodes need at least two children");
+
+public:
+  DaryHeap() {
+  }
+
+  explicit DaryHeap(Compare comp) : comp_(std::move(comp)) {
+  }
+
+  // O(N)
+  template <typename Iterator>
+  DaryHeap(Iterator first, Iterator last, Compare comp = Compare()) : comp_(std::move(comp)) {
+    Heapify(first, last);
+  }
+
+  inline const T& Top() const {
+    if (IsEmpty()) {
+      throw std::underflow_error("Top of empty heap");
+    }
+    return values_[0];
+  }
+
+  inline bool IsEmpty() const noexcept {
+    return values_.IsEmpty();
+  }
+
+  inline size_t Size() const noexcept {
+    return values_.Size();
+  }
+
+  void Reserve(size_t count) {
+    values_.Reserve(count);
+  }
+
+  void Clear() noexcept {
+    values_.Clear();
+  }
+
+  void Push(const T& value) {
+    values_.PushBack(value);
+    SiftUp(values_.Size() - 1);
+  }
+
+  void Push(T&& value) {
+    values_.PushBack(std::move(value));
+    SiftUp(values_.Size() - 1);
+  }
+
+  template <typename... Args>
+  void Emplace(Args&&... args) {
+    values_.EmplaceBack(std::forward<Args>(args)...);
+    SiftUp(values_.Size() - 1);
+  }
+
+  // Pushes [first, last). A range at least 1/8 of the heap is appended and the heap order
+  // is restored bottom-up over the subtrees it went to, O(count + log^2 N),
+  // a smaller one is pushed element by element
+  template <typename Iterator>
+  void PushRange(Iterator first, Iterator last) {
+    size_t old_size = values_.Size();
+    for (; first != last; ++first) {
+      values_.PushBack(*first);
+    }
+    size_t count = values_.Size() - old_size;
+    if (count == 0) {
+      return;
+    }
+    if (count * 8 < old_size) {
+      for (size_t i = old_size; i < values_.Size(); ++i) {
+        SiftUp(i);
+      }
+      return;
+    }
+
+    // Subtrees rooted at [low, high] of each level are heaps once their roots are sifted down
+    size_t low = old_size;
+    size_t high = values_.Size() - 1;
+    while (high > 0) {
+      low = low == 0 ? 0 : Parent(low);
+      high = Parent(high);
+      for (size_t i = high + 1; i-- > low;) {
+        SiftDown(i);
+      }
+    }
+  }
+
+  // Moves all elements of other here by PushRange, i.e. rebuilds the heap if other
+  // isn't small, O(N + M)
+  void Meld(DaryHeap& other) {
+    if (this == &other) {
+      return;
+    }
+    if (values_.Size() < other.values_.Size()) {
+      values_.Swap(other.values_);
+    }
+    PushRange(std::make_move_iterator(other.values_.Data()),
+              std::make_move_iterator(other.values_.Data() + other.values_.Size()));
+    other.values_.Clear();
+  }
+
+  // Replaces the contents with [first, last) in O(N)
+  template <typename Iterator>
+  void Heapify(Iterator first, Iterator last) {
+    values_.Clear();
+    if constexpr (std::is_base_of_v<std::random_access_iterator_tag,
+                                    typename std::iterator_traits<Iterator>::iterator_category>) {
+      values_.Reserve(last - first);
+    }
+    for (; first != last; ++first) {
+      values_.PushBack(*first);
+    }
+    MakeHeap();
+  }
+
+  void Pop() {
+    if (IsEmpty()) {
+      throw std::underflow_error("Pop from empty heap");
+    }
+    T last(std::move(values_.Back()));
+    values_.PopBack();
+    if (!values_.IsEmpty()) {
+      ReplaceTop(values_.Data(), values_.Size(), std::move(last), comp_);
+    }
+  }
+
+  // Pops the top and returns it
+  T Extract() {
+    if (IsEmpty()) {
+      throw std::underflow_error("Pop from empty heap");
+    }
+    T top(std::move(values_[0]));
+    Pop();
+    return top;
+  }
+
+  void Swap(DaryHeap& other) noexcept {
+    values_.Swap(other.values_);
+    std::swap(comp_, other.comp_);
+  }
+
+  // Heap operations on a range, used by HeapSort
+
+  static void MakeHeap(T* values, size_t size, Compare& comp) {
+    // Floyd: sift down every parent, bottom up
+    if (size < 2) {
+      return;
+    }
+    for (size_t i = Parent(size - 1) + 1; i-- > 0;) {
+      SiftDown(values, size, i, comp);
+    }
+  }
+
+  static void SiftUp(T* values, size_t index, Compare& comp) {
+    T value(std::move(values[index]));
+    while (index > 0) {
+      size_t parent = Parent(index);
+      if (!comp(values[parent], value)) {
+        break;
+      }
+      values[index] = std::move(values[parent]);
+      index = parent;
+    }
+    values[index] = std::move(value);
+  }
+
+  static void SiftDown(T* values, size_t size, size_t index, Compare& comp) {
+    T value(std::move(values[index]));
+    while (true) {
+      size_t first_child = Arity * index + 1;
+      if (first_child >= size) {
+        break;
+      }
+      size_t best = BestChild(values, size, first_child, comp);
+      if (!comp(value, values[best])) {
+        break;
+      }
+      values[index] = std::move(values[best]);
+      index = best;
+    }
+    values[index] = std::move(value);
+  }
+
+  // Puts value in place of the root. The last element, which Pop and HeapSort move to the root,
+  // mostly belongs near the leaves, so the hole goes down to a leaf without comparing with value
+  // (one comparison per level instead of two) and value is sifted up from there
+  static void ReplaceTop(T* values, size_t size, T value, Compare& comp) {
+    size_t index = 0;
+    while (true) {
+      size_t first_child = Arity * index + 1;
+      if (first_child >= size) {
+        break;
+      }
+      size_t best = BestChild(values, size, first_child, comp);
+      values[index] = std::move(values[best]);
+      index = best;
+    }
+    while (index > 0) {
+      size_t parent = Parent(index);
+      if (!comp(values[parent], value)) {
+        break;
+      }
+      values[index] = std::move(values[parent]);
+      index = parent;
+    }
+    values[index] = std::move(value);
+  }
+
+private:
+  static inline size_t Parent(size_t index) noexcept {
+    return (index - 1) / Arity;
+  }
+
+  // The greatest of the children starting at first_child
+  static inline size_t BestChild(const T* values, size_t size, size_t first_child, Compare& comp) {
+    size_t best = first_child;
+    if (first_child + Arity <= size) {
+      // A full node, the loop is unrolled
+      for (size_t child = first_child + 1; child < first_child + Arity; ++child) {
+        best = comp(values[best], values[child]) ? child : best;
+      }
+    } else {
+      for (size_t child = first_child + 1; child < size; ++child) {
+        best = comp(values[best], values[child]) ? child : best;
+      }
+    }
+    return best;
+  }
+
+  void SiftUp(size_t index) {
+    SiftUp(values_.Data(), index, comp_);
+  }
+
+  void SiftDown(size_t index) {
+    SiftDown(values_.Data(), values_.Size(), index, comp_);
+  }
+
+  void MakeHeap() {
+    MakeHeap(values_.Data(), values_.Size(), comp_);
+  }
+
+private:
+  Vector<T> values_;
+  Compare comp_;
+};
+
+// In-place heapsort on a d-ary heap, not stable
+template <size_t Arity = 4, typename T, typename Compare = std::less<T>>
+void HeapSort(Vector<T>& values, Compare comp = Compare()) {
+  using Heap = DaryHeap<T, Arity, Compare>;
+  T* data = values.Data();
+  size_t size = values.Size();
+  Heap::MakeHeap(data, size, comp);
+  for (size_t end = size; end > 1; --end) {
+    // The greatest goes to the end, the last one takes its place
+    T last(std::move(data[end - 1]));
+    data[end - 1] = std::move(data[0]);
+    Heap::ReplaceTop(data, end - 1, std::move(last), comp);
+  }
+}
+
+
+namespace std {
+  // Global swap overloading
+  template <typename T, size_t Arity, typename Compare>
+  void swap(DaryHeap<T, Arity, Compare>& a, DaryHeap<T, Arity, Compare>& b) {
+    a.Swap(b);
+  }
+}
@@ -0,0 +1,265 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include <fmt/core.h>
+
+#include "../../vector/vector/vector.hpp"
+
+// Priority queue whose elements can be changed and erased in place by handles.
+//
+// Push returns a handle of the element, which stays valid until the element is popped
+// or erased, then the handle may be given to a new element. Elements live in a d-ary
+// heap of (value, handle) entries and positions_[handle] is the index of the entry
+// in the heap: every move of an entry updates it, so DecreaseKey, IncreaseKey and Erase
+// find the element in O(1) and fix the heap in O(log N). A lazy-deletion heap instead
+// pushes a new copy and skips stale ones on Pop, growing up to the number of updates.
+//
+// Unlike DaryHeap, Top() is the smallest element by Compare: the queue is made for
+// distances of Dijkstra and deadlines of schedulers, where keys decrease.
+template <typename T, size_t Arity = 4, typename Compare = std::less<T>>
+class IndexedHeap{
+  static_assert(Arity >= 2, "Heap nodes need at least two children");
+
+public:
+  using Handle = size_t;
+
+  IndexedHeap() {
+  }
+
+  explicit IndexedHeap(Compare comp) : comp_(std::move(comp)) {
+  }
+
+  inline bool IsEmpty() const noexcept {
+    return heap_.IsEmpty();
+  }
+
+  inline size_t Size() const noexcept {
+    return heap_.Size();
+  }
+
+  // Reserves space for count elements and handles below count
+  void Reserve(size_t count) {
+    heap_.Reserve(count);
+    positions_.Reserve(count);
+  }
+
+  void Clear() noexcept {
+    heap_.Clear();
+    positions_.Clear();
+    free_handles_.Clear();
+  }
+
+  inline const T& Top() const {
+    if (IsEmpty()) {
+      throw std::underflow_error("Top of empty heap");
+    }
+    return heap_[0].value;
+  }
+
+  inline Handle TopHandle() const {
+    if (IsEmpty()) {
+      throw std::underflow_error("Top of empty heap");
+    }
+    return heap_[0].handle;
+  }
+
+  inline bool Contains(Handle handle) const noexcept {
+    return handle < positions_.Size() && positions_[handle] != NONE;
+  }
+
+  inline const T& Get(Handle handle) const {
+    return heap_[PositionOf(handle)].value;
+  }
+
+  Handle Push(const T& value) {
+    return Emplace(value);
+  }
+
+  Handle Push(T&& value) {
+    return Emplace(std::move(value));
+  }
+
+  template <typename... Args>
+  Handle Emplace(Args&&... args) {
+    Handle handle;
+    if (!free_handles_.IsEmpty()) {
+      handle = free_handles_.Back();
+      free_handles_.PopBack();
+    } else {
+      handle = positions_.Size();
+      positions_.PushBack(NONE);
+    }
+    try {
+      heap_.EmplaceBack(Entry{T(std::forward<Args>(args)...), handle});
+    } catch (...) {
+      free_handles_.PushBack(handle);
+      throw;
+    }
+    positions_[handle] = heap_.Size() - 1;
+    SiftUp(heap_.Size() - 1);
+    return handle;
+  }
+
+  void Pop() {
+    if (IsEmpty()) {
+      throw std::underflow_error("Pop from empty heap");
+    }
+    EraseAt(0);
+  }
+
+  // Pops the top and returns it
+  T Extract() {
+    if (IsEmpty()) {
+      throw std::underflow_error("Pop from empty heap");
+    }
+    T top(std::move(heap_[0].value));
+    EraseAt(0);
+    return top;
+  }
+
+  void Erase(Handle handle) {
+    EraseAt(PositionOf(handle));
+  }
+
+  // value must not be greater than the current one
+  void DecreaseKey(Handle handle, T value) {
+    size_t index = PositionOf(handle);
+    if (comp_(heap_[index].value, value)) {
+      throw std::invalid_argument("DecreaseKey to a greater value");
+    }
+    heap_[index].value = std::move(value);
+    SiftUp(index);
+  }
+
+  // value must not be less than the current one
+  void IncreaseKey(Handle handle, T value) {
+    size_t index = PositionOf(handle);
+    if (comp_(value, heap_[index].value)) {
+      throw std::invalid_argument("IncreaseKey to a less value");
+    }
+    heap_[index].value = std::move(value);
+    SiftDown(index);
+  }
+
+  // Sets any value
+  void Update(Handle handle, T value) {
+    size_t index = PositionOf(handle);
+    bool decreased = comp_(value, heap_[index].value);
+    heap_[index].value = std::move(value);
+    if (decreased) {
+      SiftUp(index);
+    } else {
+      SiftDown(index);
+    }
+  }
+
+  void Swap(IndexedHeap& other) noexcept {
+    heap_.Swap(other.heap_);
+    positions_.Swap(other.positions_);
+    free_handles_.Swap(other.free_handles_);
+    std::swap(comp_, other.comp_);
+  }
+
+private:
+  struct Entry{
+    T value;
+    Handle handle;
+  };
+
+  static constexpr size_t NONE = std::numeric_limits<size_t>::max();
+
+  static inline size_t Parent(size_t index) noexcept {
+    return (index - 1) / Arity;
+  }
+
+  size_t PositionOf(Handle handle) const {
+    if (!Contains(handle)) {
+      throw std::out_of_range(fmt::format("Handle {} isn't in the heap", handle));
+    }
+    return positions_[handle];
+  }
+
+  // Moves the entry into heap_[index] and updates its position
+  inline void Place(size_t index, Entry&& entry) {
+    positions_[entry.handle] = index;
+    heap_[index] = std::move(entry);
+  }
+
+  void SiftUp(size_t index) {
+    Entry entry(std::move(heap_[index]));
+    while (index > 0) {
+      size_t parent = Parent(index);
+      if (!comp_(entry.value, heap_[parent].value)) {
+        break;
+      }
+      Place(index, std::move(heap_[parent]));
+      index = parent;
+    }
+    Place(index, std::move(entry));
+  }
+
+  void SiftDown(size_t index) {
+    size_t size = heap_.Size();
+    Entry entry(std::move(heap_[index]));
+    while (true) {
+      size_t first_child = Arity * index + 1;
+      if (first_child >= size) {
+        break;
+      }
+      size_t last_child = std::min(first_child + Arity, size);
+      size_t best = first_child;
+      for (size_t child = first_child + 1; child < last_child; ++child) {
+        best = comp_(heap_[child].value, heap_[best].value) ? child : best;
+      }
+      if (!comp_(heap_[best].value, entry.value)) {
+        break;
+      }
+      Place(index, std::move(heap_[best]));
+      index = best;
+    }
+    Place(index, std::move(entry));
+  }
+
+  // The last entry takes the place of the erased one and goes up or down.
+  // The root is never compared: Extract has already moved its value out
+  void EraseAt(size_t index) {
+    Handle handle = heap_[index].handle;
+    size_t last = heap_.Size() - 1;
+    if (index != last) {
+      bool up = index != 0 && comp_(heap_[last].value, heap_[index].value);
+      Place(index, std::move(heap_[last]));
+      heap_.PopBack();
+      if (up) {
+        SiftUp(index);
+      } else {
+        SiftDown(index);
+      }
+    } else {
+      heap_.PopBack();
+    }
+    positions_[handle] = NONE;
+    free_handles_.PushBack(handle);
+  }
+
+private:
+  Vector<Entry> heap_;
+  // Index in heap_ by handle, NONE for free handles
+  Vector<size_t> positions_;
+  Vector<Handle> free_handles_;
+  Compare comp_;
+};
+
+
+namespace std {
+  // Global swap overloading
+  template <typename T, size_t Arity, typename Compare>
+  void swap(IndexedHeap<T, Arity, Compare>& a, IndexedHeap<T, Arity, Compare>& b) {
+    a.Swap(b);
+  }
+}
@@ -0,0 +1,277 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "../../vector/vector/vector.hpp"
+
+// Double-ended priority queue on a min-max heap (Atkinson et al.) in one array.
+//
+// A binary heap whose even levels (the root is level 0) are min levels and odd levels
+// are max levels: an element on a min level is not greater than all of its descendants,
+// on a max level not less. So the minimum is the root and the maximum is one of its
+// children, and PopMin, PopMax and Push are O(log N) with one array for both ends
+// instead of two heaps cross-linked by handles.
+//
+// Elements move down comparing with children and grandchildren and move up
+// comparing with grandparents, keeping their kind of level.
+template <typename T, typename Compare = std::less<T>>
+class MinMaxHeap{
+public:
+  MinMaxHeap() {
+  }
+
+  explicit MinMaxHeap(Compare comp) : comp_(std::move(comp)) {
+  }
+
+  // O(N)
+  template <typename Iterator>
+  MinMaxHeap(Iterator first, Iterator last, Compare comp = Compare()) : comp_(std::move(comp)) {
+    Heapify(first, last);
+  }
+
+  inline bool IsEmpty() const noexcept {
+    return values_.IsEmpty();
+  }
+
+  inline size_t Size() const noexcept {
+    return values_.Size();
+  }
+
+  void Reserve(size_t count) {
+    values_.Reserve(count);
+  }
+
+  void Clear() noexcept {
+    values_.Clear();
+  }
+
+  inline const T& PeekMin() const {
+    if (IsEmpty()) {
+      throw std::underflow_error("PeekMin of empty heap");
+    }
+    return values_[0];
+  }
+
+  inline const T& PeekMax() const {
+    if (IsEmpty()) {
+      throw std::underflow_error("PeekMax of empty heap");
+    }
+    return values_[MaxIndex()];
+  }
+
+  void Push(const T& value) {
+    values_.PushBack(value);
+    BubbleUp(values_.Size() - 1);
+  }
+
+  void Push(T&& value) {
+    values_.PushBack(std::move(value));
+    BubbleUp(values_.Size() - 1);
+  }
+
+  template <typename... Args>
+  void Emplace(Args&&... args) {
+    values_.EmplaceBack(std::forward<Args>(args)...);
+    BubbleUp(values_.Size() - 1);
+  }
+
+  void PopMin() {
+    if (IsEmpty()) {
+      throw std::underflow_error("PopMin from empty heap");
+    }
+    EraseAt(0);
+  }
+
+  void PopMax() {
+    if (IsEmpty()) {
+      throw std::underflow_error("PopMax from empty heap");
+    }
+    EraseAt(MaxIndex());
+  }
+
+  T ExtractMin() {
+    if (IsEmpty()) {
+      throw std::underflow_error("PopMin from empty heap");
+    }
+    T min(std::move(values_[0]));
+    EraseAt(0);
+    return min;
+  }
+
+  T ExtractMax() {
+    if (IsEmpty()) {
+      throw std::underflow_error("PopMax from empty heap");
+    }
+    size_t index = MaxIndex();
+    T max(std::move(values_[index]));
+    EraseAt(index);
+    return max;
+  }
+
+  // Replaces the contents with [first, last) in O(N)
+  template <typename Iterator>
+  void Heapify(Iterator first, Iterator last) {
+    values_.Clear();
+    if constexpr (std::is_base_of_v<std::random_access_iterator_tag,
+                                    typename std::iterator_traits<Iterator>::iterator_category>) {
+      values_.Reserve(last - first);
+    }
+    for (; first != last; ++first) {
+      values_.PushBack(*first);
+    }
+    // Floyd: trickle down every parent, bottom up
+    if (values_.Size() > 1) {
+      for (size_t i = Parent(values_.Size() - 1) + 1; i-- > 0;) {
+        TrickleDown(i);
+      }
+    }
+  }
+
+  void Swap(MinMaxHeap& other) noexcept {
+    values_.Swap(other.values_);
+    std::swap(comp_, other.comp_);
+  }
+
+private:
+  static inline size_t Parent(size_t index) noexcept {
+    return (index - 1) / 2;
+  }
+
+  static inline bool IsMinLevel(size_t index) noexcept {
+    return std::bit_width(index + 1) % 2 == 1;
+  }
+
+  // Whether a goes above b on a min level (Max = false) or on a max level (Max = true)
+  template <bool Max>
+  inline bool Before(const T& a, const T& b) {
+    if constexpr (Max) {
+      return comp_(b, a);
+    } else {
+      return comp_(a, b);
+    }
+  }
+
+  size_t MaxIndex() const noexcept {
+    size_t size = values_.Size();
+    if (size <= 2) {
+      return size - 1;
+    }
+    return comp_(values_[1], values_[2]) ? 2 : 1;
+  }
+
+  // The last element takes the place of the erased one. Only the root and its children
+  // are erased, and there it only has to go down
+  void EraseAt(size_t index) {
+    size_t last = values_.Size() - 1;
+    if (index != last) {
+      values_[index] = std::move(values_[last]);
+    }
+    values_.PopBack();
+    if (index < values_.Size()) {
+      TrickleDown(index);
+    }
+  }
+
+  void TrickleDown(size_t index) {
+    if (IsMinLevel(index)) {
+      TrickleDown<false>(index);
+    } else {
+      TrickleDown<true>(index);
+    }
+  }
+
+  template <bool Max>
+  void TrickleDown(size_t index) {
+    size_t size = values_.Size();
+    T value(std::move(values_[index]));
+    while (true) {
+      size_t first_child = 2 * index + 1;
+      if (first_child >= size) {
+        break;
+      }
+      // The first among the children and the grandchildren
+      size_t best = first_child;
+      size_t last = std::min(4 * index + 7, size);
+      for (size_t i : {first_child + 1, 4 * index + 3, 4 * index + 4, 4 * index + 5, 4 * index + 6}) {
+        if (i < last && Before<Max>(values_[i], values_[best])) {
+          best = i;
+        }
+      }
+      if (!Before<Max>(values_[best], value)) {
+        break;
+      }
+      values_[index] = std::move(values_[best]);
+      index = best;
+      if (best <= first_child + 1) {
+        // A child is on a level of the other kind and has no descendants below value
+        break;
+      }
+      // value goes to a level of the same kind, but may be out of order with its new parent,
+      // which is on the other kind of level
+      size_t parent = Parent(index);
+      if (Before<!Max>(value, values_[parent])) {
+        std::swap(value, values_[parent]);
+      }
+    }
+    values_[index] = std::move(value);
+  }
+
+  void BubbleUp(size_t index) {
+    if (index == 0) {
+      return;
+    }
+    size_t parent = Parent(index);
+    if (IsMinLevel(index)) {
+      if (comp_(values_[parent], values_[index])) {
+        // Greater than its max parent, so it belongs to max levels
+        std::swap(values_[index], values_[parent]);
+        BubbleUp<true>(parent);
+      } else {
+        BubbleUp<false>(index);
+      }
+    } else {
+      if (comp_(values_[index], values_[parent])) {
+        std::swap(values_[index], values_[parent]);
+        BubbleUp<false>(parent);
+      } else {
+        BubbleUp<true>(index);
+      }
+    }
+  }
+
+  // Moves up through the grandparents, i.e. levels of the same kind
+  template <bool Max>
+  void BubbleUp(size_t index) {
+    T value(std::move(values_[index]));
+    while (index > 2) {
+      size_t grandparent = Parent(Parent(index));
+      if (!Before<Max>(value, values_[grandparent])) {
+        break;
+      }
+      values_[index] = std::move(values_[grandparent]);
+      index = grandparent;
+    }
+    values_[index] = std::move(value);
+  }
+
+private:
+  Vector<T> values_;
+  Compare comp_;
+};
+
+
+namespace std {
+  // Global swap overloading
+  template <typename T, typename Compare>
+  void swap(MinMaxHeap<T, Compare>& a, MinMaxHeap<T, Compare>& b) {
+    a.Swap(b);
+  }
+}
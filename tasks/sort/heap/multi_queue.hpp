@@ -0,0 +1,242 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+#include <fmt/core.h>
+
+#include "heap.hpp"
+
+// Relaxed concurrent priority queue (MultiQueue, Rihani, Sanders and Dementiev).
+//
+// c * threads heaps, each behind its own mutex. Pop locks two random heaps and pops
+// from the one with the smaller top, so threads rarely wait for each other, but the
+// popped element is not always the smallest: with two choices the expected rank
+// of the popped element among all elements is O(c * threads) and doesn't grow with
+// the size of the queue (Alistarh et al.). Push adds the element to a buffer of the
+// thread, and a full buffer is moved to a random heap with one lock. Elements in
+// the buffer are seen only by its thread, which adds up to buffer_size to the rank
+// of pops of other threads.
+//
+// Every call takes the index of the calling thread, below Threads(), and two threads
+// must not use one index at the same time.
+//
+// Like IndexedHeap, pops the smallest elements by Compare.
+template <typename T, typename Compare = std::less<T>>
+class MultiQueue{
+public:
+  static constexpr size_t QUEUES_PER_THREAD = 2;
+  static constexpr size_t BUFFER_SIZE = 16;
+
+  explicit MultiQueue(size_t threads, size_t queues_per_thread = QUEUES_PER_THREAD,
+                      size_t buffer_size = BUFFER_SIZE, Compare comp = Compare())
+      : thread_count_(threads),
+        queue_count_(threads * queues_per_thread),
+        buffer_size_(buffer_size),
+        comp_(comp) {
+    if (threads == 0 || queues_per_thread == 0 || buffer_size == 0) {
+      throw std::invalid_argument(fmt::format("MultiQueue of {} threads, {} queues per thread, buffers of {}",
+                                              threads, queues_per_thread, buffer_size));
+    }
+    queues_ = std::make_unique<Queue[]>(queue_count_);
+    for (size_t i = 0; i < queue_count_; ++i) {
+      queues_[i].heap = Heap(Greater{comp});
+    }
+    threads_ = std::make_unique<ThreadState[]>(thread_count_);
+    for (size_t i = 0; i < thread_count_; ++i) {
+      threads_[i].random = 0x9E3779B97F4A7C15ull * (i + 1);
+      threads_[i].buffer.Reserve(buffer_size_);
+    }
+  }
+
+  MultiQueue(const MultiQueue&) = delete;
+
+  MultiQueue& operator=(const MultiQueue&) = delete;
+
+  inline size_t Threads() const noexcept {
+    return thread_count_;
+  }
+
+  inline size_t QueueCount() const noexcept {
+    return queue_count_;
+  }
+
+  void Push(size_t thread, const T& value) {
+    ThreadState& state = StateOf(thread);
+    state.buffer.PushBack(value);
+    if (state.buffer.Size() >= buffer_size_) {
+      Flush(thread);
+    }
+  }
+
+  void Push(size_t thread, T&& value) {
+    ThreadState& state = StateOf(thread);
+    state.buffer.PushBack(std::move(value));
+    if (state.buffer.Size() >= buffer_size_) {
+      Flush(thread);
+    }
+  }
+
+  // Moves the buffer of the thread to a random heap, making it visible to other threads
+  void Flush(size_t thread) {
+    ThreadState& state = StateOf(thread);
+    if (state.buffer.IsEmpty()) {
+      return;
+    }
+    while (true) {
+      Queue& queue = queues_[Random(state) % queue_count_];
+      std::unique_lock lock(queue.mutex, std::try_to_lock);
+      if (!lock.owns_lock()) {
+        continue;
+      }
+      queue.heap.PushRange(std::make_move_iterator(state.buffer.Data()),
+                           std::make_move_iterator(state.buffer.Data() + state.buffer.Size()));
+      queue.size.store(queue.heap.Size(), std::memory_order_relaxed);
+      break;
+    }
+    state.buffer.Clear();
+  }
+
+  // A small element: the smaller top of two random heaps or the smallest of the own buffer.
+  // Empty only if the heaps were found empty one by one and so was the buffer
+  std::optional<T> TryPop(size_t thread) {
+    ThreadState& state = StateOf(thread);
+    for (size_t attempt = 0; attempt < queue_count_; ++attempt) {
+      Queue* first = &queues_[Random(state) % queue_count_];
+      Queue* second = &queues_[Random(state) % queue_count_];
+      // Empty heaps are skipped without locking
+      if (first->size.load(std::memory_order_relaxed) == 0) {
+        std::swap(first, second);
+      }
+      if (first->size.load(std::memory_order_relaxed) == 0) {
+        continue;
+      }
+      std::unique_lock first_lock(first->mutex, std::try_to_lock);
+      if (!first_lock.owns_lock()) {
+        continue;
+      }
+      std::unique_lock<std::mutex> second_lock;
+      if (second != first && second->size.load(std::memory_order_relaxed) != 0) {
+        second_lock = std::unique_lock(second->mutex, std::try_to_lock);
+      }
+      Queue* best = Better(first, second_lock.owns_lock() ? second : nullptr);
+      if (best != nullptr) {
+        return PopFrom(best, state);
+      }
+    }
+
+    // The heaps looked empty or busy, so check every one
+    for (size_t i = 0; i < queue_count_; ++i) {
+      Queue& queue = queues_[i];
+      std::lock_guard lock(queue.mutex);
+      if (!queue.heap.IsEmpty()) {
+        return PopFrom(&queue, state);
+      }
+    }
+    if (state.buffer.IsEmpty()) {
+      return std::nullopt;
+    }
+    return PopBuffer(state, SmallestInBuffer(state));
+  }
+
+private:
+  // The inner heaps pop the smallest
+  struct Greater{
+    Compare comp;
+
+    inline bool operator()(const T& a, const T& b) const {
+      return comp(b, a);
+    }
+  };
+
+  using Heap = DaryHeap<T, 4, Greater>;
+
+  struct alignas(64) Queue{
+    std::mutex mutex;
+    Heap heap;
+    // heap.Size() for checks without the lock
+    std::atomic<size_t> size{0};
+  };
+
+  struct alignas(64) ThreadState{
+    Vector<T> buffer;
+    uint64_t random;
+  };
+
+  ThreadState& StateOf(size_t thread) {
+    if (thread >= thread_count_) {
+      throw std::out_of_range(fmt::format("Thread {} of MultiQueue of {} threads", thread, thread_count_));
+    }
+    return threads_[thread];
+  }
+
+  // xorshift64*
+  static inline uint64_t Random(ThreadState& state) noexcept {
+    state.random ^= state.random >> 12;
+    state.random ^= state.random << 25;
+    state.random ^= state.random >> 27;
+    return (state.random * 0x2545F4914F6CDD1Dull) >> 32;
+  }
+
+  // The locked non-empty heap with the smaller top, second may be nullptr
+  Queue* Better(Queue* first, Queue* second) {
+    if (first->heap.IsEmpty()) {
+      first = nullptr;
+    }
+    if (second == nullptr || second->heap.IsEmpty()) {
+      return first;
+    }
+    if (first == nullptr || comp_(second->heap.Top(), first->heap.Top())) {
+      return second;
+    }
+    return first;
+  }
+
+  // Pops the top of the locked queue, unless the buffer has a smaller element
+  T PopFrom(Queue* queue, ThreadState& state) {
+    size_t smallest = SmallestInBuffer(state);
+    if (smallest < state.buffer.Size() && comp_(state.buffer[smallest], queue->heap.Top())) {
+      return PopBuffer(state, smallest);
+    }
+    T top = queue->heap.Extract();
+    queue->size.store(queue->heap.Size(), std::memory_order_relaxed);
+    return top;
+  }
+
+  // Index of the smallest element of the buffer, or its size if it's empty
+  size_t SmallestInBuffer(ThreadState& state) {
+    size_t size = state.buffer.Size();
+    size_t smallest = 0;
+    for (size_t i = 1; i < size; ++i) {
+      if (comp_(state.buffer[i], state.buffer[smallest])) {
+        smallest = i;
+      }
+    }
+    return size == 0 ? size : smallest;
+  }
+
+  T PopBuffer(ThreadState& state, size_t smallest) {
+    T value(std::move(state.buffer[smallest]));
+    if (smallest + 1 != state.buffer.Size()) {
+      state.buffer[smallest] = std::move(state.buffer.Back());
+    }
+    state.buffer.PopBack();
+    return value;
+  }
+
+private:
+  size_t thread_count_;
+  size_t queue_count_;
+  size_t buffer_size_;
+  Compare comp_;
+  std::unique_ptr<Queue[]> queues_;
+  std::unique_ptr<ThreadState[]> threads_;
+};
@@ -0,0 +1,432 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+// Pairing heap: a heap-ordered multiway tree of nodes.
+//
+// Push and Meld link two roots with one comparison, O(1): the greater root becomes
+// the first child of the smaller one. Pop removes the root and melds its children
+// in two passes, first pairs from left to right and then the results from right
+// to left, amortized O(log N). DecreaseKey cuts the subtree of the node and links
+// it with the root. Nodes never move, so handles stay valid after Meld.
+//
+// Nodes are taken from a pool of chunks, so Push doesn't call the allocator and
+// Meld moves the chunks and free slots of the other heap into this one, O(1).
+//
+// Like IndexedHeap, Top() is the smallest element by Compare.
+
+namespace detail {
+
+// Slots for objects of type Node. Chunks are never freed before the pool
+template <typename Node>
+class NodePool{
+public:
+  static constexpr size_t MIN_CHUNK_SIZE = 32;
+  static constexpr size_t MAX_CHUNK_SIZE = 1 << 16;
+
+  NodePool() {
+  }
+
+  NodePool(const NodePool&) = delete;
+
+  NodePool& operator=(const NodePool&) = delete;
+
+  NodePool(NodePool&& other) noexcept {
+    Swap(other);
+  }
+
+  NodePool& operator=(NodePool&& other) noexcept {
+    if (this != &other) {
+      NodePool moved(std::move(other));
+      Swap(moved);
+    }
+    return *this;
+  }
+
+  // Memory for a node, which must be constructed there
+  void* Allocate() {
+    if (free_ == nullptr) {
+      AddChunk();
+    }
+    FreeSlot* slot = free_;
+    free_ = slot->next;
+    if (free_ == nullptr) {
+      free_tail_ = nullptr;
+    }
+    return slot;
+  }
+
+  // Takes back the memory of a destroyed node
+  void Deallocate(void* memory) noexcept {
+    FreeSlot* slot = new (memory) FreeSlot{free_};
+    if (free_ == nullptr) {
+      free_tail_ = slot;
+    }
+    free_ = slot;
+  }
+
+  // Moves all chunks and free slots of other here
+  void Splice(NodePool& other) noexcept {
+    if (other.chunks_ != nullptr) {
+      other.chunks_tail_->next = chunks_;
+      chunks_ = other.chunks_;
+      if (chunks_tail_ == nullptr) {
+        chunks_tail_ = other.chunks_tail_;
+      }
+      next_chunk_size_ = std::max(next_chunk_size_, other.next_chunk_size_);
+    }
+    if (other.free_ != nullptr) {
+      other.free_tail_->next = free_;
+      free_ = other.free_;
+      if (free_tail_ == nullptr) {
+        free_tail_ = other.free_tail_;
+      }
+    }
+    other.chunks_ = other.chunks_tail_ = nullptr;
+    other.free_ = other.free_tail_ = nullptr;
+    other.next_chunk_size_ = MIN_CHUNK_SIZE;
+  }
+
+  void Swap(NodePool& other) noexcept {
+    std::swap(chunks_, other.chunks_);
+    std::swap(chunks_tail_, other.chunks_tail_);
+    std::swap(free_, other.free_);
+    std::swap(free_tail_, other.free_tail_);
+    std::swap(next_chunk_size_, other.next_chunk_size_);
+  }
+
+  ~NodePool() {
+    while (chunks_ != nullptr) {
+      Chunk* next = chunks_->next;
+      ::operator delete(chunks_, std::align_val_t{CHUNK_ALIGNMENT});
+      chunks_ = next;
+    }
+  }
+
+private:
+  struct FreeSlot{
+    FreeSlot* next;
+  };
+
+  struct Chunk{
+    Chunk* next;
+  };
+
+  static constexpr size_t SLOT_ALIGNMENT = std::max(alignof(Node), alignof(FreeSlot));
+  static constexpr size_t SLOT_SIZE =
+    (std::max(sizeof(Node), sizeof(FreeSlot)) + SLOT_ALIGNMENT - 1) / SLOT_ALIGNMENT * SLOT_ALIGNMENT;
+  static constexpr size_t CHUNK_ALIGNMENT = std::max(SLOT_ALIGNMENT, alignof(Chunk));
+  // Slots start after the chunk header
+  static constexpr size_t HEADER_SIZE = (sizeof(Chunk) + SLOT_ALIGNMENT - 1) / SLOT_ALIGNMENT * SLOT_ALIGNMENT;
+
+  // Chunk sizes double, so N nodes take O(log N) allocations
+  void AddChunk() {
+    size_t count = next_chunk_size_;
+    auto* memory = static_cast<std::byte*>(
+      ::operator new(HEADER_SIZE + count * SLOT_SIZE, std::align_val_t{CHUNK_ALIGNMENT}));
+    Chunk* chunk = new (memory) Chunk{chunks_};
+    if (chunks_ == nullptr) {
+      chunks_tail_ = chunk;
+    }
+    chunks_ = chunk;
+    next_chunk_size_ = std::min(next_chunk_size_ * 2, MAX_CHUNK_SIZE);
+
+    // Slots go to the free list in address order
+    for (size_t i = count; i-- > 0;) {
+      Deallocate(memory + HEADER_SIZE + i * SLOT_SIZE);
+    }
+  }
+
+private:
+  Chunk* chunks_ = nullptr;
+  Chunk* chunks_tail_ = nullptr;
+  FreeSlot* free_ = nullptr;
+  FreeSlot* free_tail_ = nullptr;
+  size_t next_chunk_size_ = MIN_CHUNK_SIZE;
+};
+
+}  // namespace detail
+
+template <typename T, typename Compare = std::less<T>>
+class PairingHeap{
+  struct Node{
+    T value;
+    Node* child = nullptr;
+    Node* next = nullptr;
+    // The previous sibling, or the parent for the first child
+    Node* prev = nullptr;
+  };
+
+public:
+  // Refers to an element from Push until it's popped or erased
+  class Handle{
+    friend class PairingHeap;
+
+    public:
+      Handle() {
+      }
+
+      inline bool operator==(const Handle& other) const noexcept = default;
+
+    private:
+      explicit Handle(Node* node) : node_(node) {
+      }
+
+    private:
+      Node* node_ = nullptr;
+  };
+
+  PairingHeap() {
+  }
+
+  explicit PairingHeap(Compare comp) : comp_(std::move(comp)) {
+  }
+
+  PairingHeap(const PairingHeap&) = delete;
+
+  PairingHeap& operator=(const PairingHeap&) = delete;
+
+  PairingHeap(PairingHeap&& other) noexcept : comp_(other.comp_) {
+    Swap(other);
+  }
+
+  PairingHeap& operator=(PairingHeap&& other) noexcept {
+    if (this != &other) {
+      PairingHeap moved(std::move(other));
+      Swap(moved);
+    }
+    return *this;
+  }
+
+  inline bool IsEmpty() const noexcept {
+    return root_ == nullptr;
+  }
+
+  inline size_t Size() const noexcept {
+    return size_;
+  }
+
+  inline const T& Top() const {
+    if (IsEmpty()) {
+      throw std::underflow_error("Top of empty heap");
+    }
+    return root_->value;
+  }
+
+  inline Handle TopHandle() const {
+    if (IsEmpty()) {
+      throw std::underflow_error("Top of empty heap");
+    }
+    return Handle(root_);
+  }
+
+  inline const T& Get(Handle handle) const {
+    return CheckHandle(handle)->value;
+  }
+
+  Handle Push(const T& value) {
+    return Emplace(value);
+  }
+
+  Handle Push(T&& value) {
+    return Emplace(std::move(value));
+  }
+
+  template <typename... Args>
+  Handle Emplace(Args&&... args) {
+    void* memory = pool_.Allocate();
+    Node* node;
+    try {
+      node = new (memory) Node{T(std::forward<Args>(args)...)};
+    } catch (...) {
+      pool_.Deallocate(memory);
+      throw;
+    }
+    root_ = root_ == nullptr ? node : Link(root_, node);
+    ++size_;
+    return Handle(node);
+  }
+
+  void Pop() {
+    if (IsEmpty()) {
+      throw std::underflow_error("Pop from empty heap");
+    }
+    Node* root = root_;
+    root_ = MergePairs(root->child);
+    Destroy(root);
+  }
+
+  // Pops the top and returns it
+  T Extract() {
+    if (IsEmpty()) {
+      throw std::underflow_error("Pop from empty heap");
+    }
+    T top(std::move(root_->value));
+    Pop();
+    return top;
+  }
+
+  // value must not be greater than the current one
+  void DecreaseKey(Handle handle, T value) {
+    Node* node = CheckHandle(handle);
+    if (comp_(node->value, value)) {
+      throw std::invalid_argument("DecreaseKey to a greater value");
+    }
+    node->value = std::move(value);
+    if (node != root_) {
+      Cut(node);
+      root_ = Link(root_, node);
+    }
+  }
+
+  void Erase(Handle handle) {
+    Node* node = CheckHandle(handle);
+    if (node == root_) {
+      Pop();
+      return;
+    }
+    Cut(node);
+    if (Node* children = MergePairs(node->child); children != nullptr) {
+      root_ = Link(root_, children);
+    }
+    Destroy(node);
+  }
+
+  // Moves all elements of other here in O(1), their handles stay valid
+  void Meld(PairingHeap& other) noexcept {
+    if (this == &other || other.root_ == nullptr) {
+      return;
+    }
+    root_ = root_ == nullptr ? other.root_ : Link(root_, other.root_);
+    size_ += other.size_;
+    pool_.Splice(other.pool_);
+    other.root_ = nullptr;
+    other.size_ = 0;
+  }
+
+  void Clear() noexcept {
+    // Rotates the first child above its parent until the node has no children,
+    // so the tree is destroyed in O(N) without recursion
+    Node* node = root_;
+    while (node != nullptr) {
+      if (Node* child = node->child; child != nullptr) {
+        node->child = child->next;
+        child->next = node;
+        node = child;
+      } else {
+        Node* next = node->next;
+        node->~Node();
+        pool_.Deallocate(node);
+        node = next;
+      }
+    }
+    root_ = nullptr;
+    size_ = 0;
+  }
+
+  void Swap(PairingHeap& other) noexcept {
+    std::swap(root_, other.root_);
+    std::swap(size_, other.size_);
+    pool_.Swap(other.pool_);
+    std::swap(comp_, other.comp_);
+  }
+
+  ~PairingHeap() {
+    Clear();
+  }
+
+private:
+  Node* CheckHandle(Handle handle) const {
+    if (handle.node_ == nullptr) {
+      throw std::invalid_argument("Empty handle");
+    }
+    return handle.node_;
+  }
+
+  // Links two roots, the greater becomes the first child of the smaller. a wins ties
+  Node* Link(Node* a, Node* b) {
+    if (comp_(b->value, a->value)) {
+      std::swap(a, b);
+    }
+    b->next = a->child;
+    if (a->child != nullptr) {
+      a->child->prev = b;
+    }
+    b->prev = a;
+    a->child = b;
+    a->next = a->prev = nullptr;
+    return a;
+  }
+
+  // Detaches the subtree of a non-root node
+  void Cut(Node* node) noexcept {
+    if (node->prev->child == node) {
+      node->prev->child = node->next;
+    } else {
+      node->prev->next = node->next;
+    }
+    if (node->next != nullptr) {
+      node->next->prev = node->prev;
+    }
+    node->next = node->prev = nullptr;
+  }
+
+  // Melds a list of siblings into one tree
+  Node* MergePairs(Node* first) {
+    if (first == nullptr) {
+      return nullptr;
+    }
+    // Links pairs from left to right, the results are stacked in reverse
+    Node* linked = nullptr;
+    while (first != nullptr) {
+      Node* a = first;
+      Node* b = a->next;
+      if (b == nullptr) {
+        a->prev = nullptr;
+        a->next = linked;
+        linked = a;
+        break;
+      }
+      first = b->next;
+      Node* pair = Link(a, b);
+      pair->next = linked;
+      linked = pair;
+    }
+    // Links the results from right to left
+    Node* root = linked;
+    linked = linked->next;
+    while (linked != nullptr) {
+      Node* next = linked->next;
+      root = Link(root, linked);
+      linked = next;
+    }
+    root->next = root->prev = nullptr;
+    return root;
+  }
+
+  void Destroy(Node* node) noexcept {
+    node->~Node();
+    pool_.Deallocate(node);
+    --size_;
+  }
+
+private:
+  Node* root_ = nullptr;
+  size_t size_ = 0;
+  detail::NodePool<Node> pool_;
+  Compare comp_;
+};
+
+
+namespace std {
+  // Global swap overloading
+  template <typename T, typename Compare>
+  void swap(PairingHeap<T, Compare>& a, PairingHeap<T, Compare>& b) {
+    a.Swap(b);
+  }
+}
@@ -0,0 +1,634 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <queue>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <fmt/core.h>
+
+#include "../heap.hpp"
+#include "../indexed_heap.hpp"
+#include "../pairing_heap.hpp"
+#include "../min_max_heap.hpp"
+#include "../multi_queue.hpp"
+
+std::vector<uint32_t> RandomKeys(size_t size, std::mt19937& gen) {
+  std::uniform_int_distribution<uint32_t> dist;
+  std::vector<uint32_t> keys(size);
+  for (auto& key : keys) {
+    key = dist(gen);
+  }
+  return keys;
+}
+
+// Keys to push, or POP. The heap starts with size keys and takes size operations,
+// push_percent of them are pushes
+inline constexpr uint32_t POP = 0;
+
+std::vector<uint32_t> PushPopTrace(size_t size, int push_percent, std::mt19937& gen) {
+  std::uniform_int_distribution<uint32_t> key_dist(1, UINT32_MAX);
+  std::uniform_int_distribution<int> percent_dist(0, 99);
+  std::vector<uint32_t> trace(size);
+  for (auto& op : trace) {
+    op = percent_dist(gen) < push_percent ? key_dist(gen) : POP;
+  }
+  return trace;
+}
+
+template <typename Heap>
+void RunPushPopTrace(benchmark::State& state, Heap& heap) {
+  std::mt19937 gen(45);
+  auto initial = RandomKeys(state.range(0), gen);
+  auto trace = PushPopTrace(state.range(0), state.range(1), gen);
+  for (auto _ : state) {
+    state.PauseTiming();
+    heap = Heap(initial.begin(), initial.end());
+    state.ResumeTiming();
+    for (uint32_t op : trace) {
+      if (op != POP) {
+        heap.push(op);
+      } else if (!heap.empty()) {
+        heap.pop();
+      }
+    }
+    benchmark::DoNotOptimize(heap.top());
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+// std::priority_queue interface over DaryHeap for RunPushPopTrace
+template <size_t Arity>
+class StdLikeDaryHeap{
+public:
+  StdLikeDaryHeap() {
+  }
+
+  template <typename Iterator>
+  StdLikeDaryHeap(Iterator first, Iterator last) : heap_(first, last) {
+  }
+
+  void push(uint32_t value) {
+    heap_.Push(value);
+  }
+
+  void pop() {
+    heap_.Pop();
+  }
+
+  bool empty() const {
+    return heap_.IsEmpty();
+  }
+
+  uint32_t top() const {
+    return heap_.Top();
+  }
+
+private:
+  DaryHeap<uint32_t, Arity> heap_;
+};
+
+
+// Random directed graph with degree out-edges per vertex, adjacency in arrays
+struct Graph{
+  std::vector<size_t> offsets;
+  std::vector<uint32_t> targets;
+  std::vector<uint32_t> weights;
+};
+
+Graph RandomGraph(size_t vertices, size_t degree, std::mt19937& gen) {
+  std::uniform_int_distribution<uint32_t> vertex_dist(0, vertices - 1);
+  std::uniform_int_distribution<uint32_t> weight_dist(1, 1000);
+  Graph graph;
+  for (size_t vertex = 0; vertex < vertices; ++vertex) {
+    graph.offsets.push_back(graph.targets.size());
+    for (size_t i = 0; i < degree; ++i) {
+      graph.targets.push_back(vertex_dist(gen));
+      graph.weights.push_back(weight_dist(gen));
+    }
+  }
+  graph.offsets.push_back(graph.targets.size());
+  return graph;
+}
+
+using DistanceVertex = std::pair<uint64_t, uint32_t>;
+
+// Decrease-key Dijkstra, returns the peak heap size
+size_t DijkstraIndexed(const Graph& graph, std::vector<uint64_t>& distances) {
+  size_t vertices = graph.offsets.size() - 1;
+  constexpr size_t UNSEEN = SIZE_MAX;
+  constexpr size_t DONE = SIZE_MAX - 1;
+  std::vector<size_t> handles(vertices, UNSEEN);
+  IndexedHeap<DistanceVertex> heap;
+  handles[0] = heap.Push({0, 0});
+  size_t peak = 1;
+  while (!heap.IsEmpty()) {
+    auto [distance, vertex] = heap.Extract();
+    distances[vertex] = distance;
+    handles[vertex] = DONE;
+    for (size_t edge = graph.offsets[vertex]; edge < graph.offsets[vertex + 1]; ++edge) {
+      uint32_t target = graph.targets[edge];
+      uint64_t candidate = distance + graph.weights[edge];
+      if (handles[target] == UNSEEN) {
+        handles[target] = heap.Push({candidate, target});
+      } else if (handles[target] != DONE && candidate < heap.Get(handles[target]).first) {
+        heap.DecreaseKey(handles[target], {candidate, target});
+      }
+    }
+    peak = std::max(peak, heap.Size());
+  }
+  return peak;
+}
+
+// Lazy deletion: an improved distance is pushed again, stale entries are skipped
+template <typename Heap>
+size_t DijkstraLazy(const Graph& graph, std::vector<uint64_t>& distances) {
+  size_t vertices = graph.offsets.size() - 1;
+  std::vector<uint64_t> best(vertices, UINT64_MAX);
+  std::vector<bool> done(vertices);
+  Heap heap;
+  heap.push({0, 0});
+  best[0] = 0;
+  size_t peak = 1;
+  while (!heap.empty()) {
+    auto [distance, vertex] = heap.top();
+    heap.pop();
+    if (done[vertex]) {
+      continue;
+    }
+    done[vertex] = true;
+    distances[vertex] = distance;
+    for (size_t edge = graph.offsets[vertex]; edge < graph.offsets[vertex + 1]; ++edge) {
+      uint32_t target = graph.targets[edge];
+      uint64_t candidate = distance + graph.weights[edge];
+      if (candidate < best[target]) {
+        best[target] = candidate;
+        heap.push({candidate, target});
+      }
+    }
+    peak = std::max(peak, heap.size());
+  }
+  return peak;
+}
+
+using StdLazyHeap = std::priority_queue<DistanceVertex, std::vector<DistanceVertex>, std::greater<DistanceVertex>>;
+
+template <size_t Arity>
+class StdLikeLazyDaryHeap{
+public:
+  void push(DistanceVertex value) {
+    heap_.Push(value);
+  }
+
+  void pop() {
+    heap_.Pop();
+  }
+
+  bool empty() const {
+    return heap_.IsEmpty();
+  }
+
+  size_t size() const {
+    return heap_.Size();
+  }
+
+  const DistanceVertex& top() const {
+    return heap_.Top();
+  }
+
+private:
+  DaryHeap<DistanceVertex, Arity, std::greater<DistanceVertex>> heap_;
+};
+
+template <typename Dijkstra>
+void RunDijkstra(benchmark::State& state, Dijkstra dijkstra) {
+  std::mt19937 gen(49);
+  Graph graph = RandomGraph(state.range(0), state.range(1), gen);
+  std::vector<uint64_t> distances(state.range(0));
+  size_t peak = 0;
+  for (auto _ : state) {
+    peak = dijkstra(graph, distances);
+    benchmark::DoNotOptimize(distances.data());
+  }
+  state.counters["peak_heap_size"] = peak;
+  state.SetComplexityN(state.range(0));
+}
+
+
+// Each round SHARD_COUNT shard queues of shard_size random keys are built and melded
+// into the main queue, which then pops pop_percent of the melded keys
+inline constexpr size_t MELD_ROUNDS = 16;
+inline constexpr size_t SHARD_COUNT = 4;
+inline constexpr size_t MELD_BASE_SIZE = 1 << 18;
+
+template <typename Heap>
+void RunMeldWorkload(benchmark::State& state) {
+  size_t shard_size = state.range(0);
+  size_t pops = shard_size * SHARD_COUNT * state.range(1) / 100;
+  std::mt19937 gen(47);
+  auto base = RandomKeys(MELD_BASE_SIZE, gen);
+  auto keys = RandomKeys(MELD_ROUNDS * SHARD_COUNT * shard_size, gen);
+  for (auto _ : state) {
+    state.PauseTiming();
+    Heap heap;
+    for (uint32_t key : base) {
+      heap.Push(key);
+    }
+    // The first Pop of a pairing heap after pushes is O(N)
+    heap.Pop();
+    state.ResumeTiming();
+    const uint32_t* next_key = keys.data();
+    for (size_t round = 0; round < MELD_ROUNDS; ++round) {
+      for (size_t shard_index = 0; shard_index < SHARD_COUNT; ++shard_index) {
+        Heap shard;
+        for (size_t i = 0; i < shard_size; ++i) {
+          shard.Push(*next_key++);
+        }
+        heap.Meld(shard);
+      }
+      for (size_t i = 0; i < pops; ++i) {
+        heap.Pop();
+      }
+    }
+    benchmark::DoNotOptimize(heap.Top());
+    state.PauseTiming();
+    heap = Heap();
+    state.ResumeTiming();
+  }
+  state.SetComplexityN(shard_size);
+}
+
+
+// Min and max heaps of the same elements, an element popped from one is erased
+// from the other by the handle
+class TwinHeaps{
+public:
+  bool IsEmpty() const {
+    return min_heap_.IsEmpty();
+  }
+
+  size_t Size() const {
+    return min_heap_.Size();
+  }
+
+  uint32_t PeekMin() const {
+    return min_heap_.Top();
+  }
+
+  void Push(uint32_t value) {
+    size_t min_handle = min_heap_.Push(value);
+    size_t max_handle = max_heap_.Push(value);
+    Link(max_of_min_, min_handle, max_handle);
+    Link(min_of_max_, max_handle, min_handle);
+  }
+
+  void PopMin() {
+    max_heap_.Erase(max_of_min_[min_heap_.TopHandle()]);
+    min_heap_.Pop();
+  }
+
+  void PopMax() {
+    min_heap_.Erase(min_of_max_[max_heap_.TopHandle()]);
+    max_heap_.Pop();
+  }
+
+private:
+  static void Link(std::vector<size_t>& links, size_t from, size_t to) {
+    if (from >= links.size()) {
+      links.resize(from + 1);
+    }
+    links[from] = to;
+  }
+
+private:
+  IndexedHeap<uint32_t> min_heap_;
+  IndexedHeap<uint32_t, 4, std::greater<uint32_t>> max_heap_;
+  std::vector<size_t> max_of_min_;
+  std::vector<size_t> min_of_max_;
+};
+
+// A buffer of the best state.range(0) keys of a stream: a new key evicts the least one
+// when the buffer is full, and every other step the greatest one is consumed
+inline constexpr size_t TOP_K_STREAM_SIZE = 1 << 20;
+
+template <typename Heap>
+void RunSlidingTopK(benchmark::State& state) {
+  size_t capacity = state.range(0);
+  std::mt19937 gen(48);
+  auto stream = RandomKeys(TOP_K_STREAM_SIZE, gen);
+  for (auto _ : state) {
+    Heap heap;
+    for (size_t i = 0; i < stream.size(); ++i) {
+      if (heap.Size() < capacity) {
+        heap.Push(stream[i]);
+      } else if (heap.PeekMin() < stream[i]) {
+        heap.PopMin();
+        heap.Push(stream[i]);
+      }
+      if (i % 2 == 1) {
+        heap.PopMax();
+      }
+    }
+    benchmark::DoNotOptimize(heap.Size());
+  }
+  state.SetComplexityN(capacity);
+}
+
+
+// One heap behind one mutex, the baseline for MultiQueue
+class LockedHeap{
+public:
+  explicit LockedHeap(size_t /*threads*/) {
+  }
+
+  void Push(size_t /*thread*/, uint32_t value) {
+    std::lock_guard lock(mutex_);
+    heap_.Push(value);
+  }
+
+  std::optional<uint32_t> TryPop(size_t /*thread*/) {
+    std::lock_guard lock(mutex_);
+    if (heap_.IsEmpty()) {
+      return std::nullopt;
+    }
+    return heap_.Extract();
+  }
+
+private:
+  std::mutex mutex_;
+  DaryHeap<uint32_t, 4, std::greater<uint32_t>> heap_;
+};
+
+// Every thread pushes a key and pops one in turns, starting from a prefilled queue
+inline constexpr size_t CONCURRENT_PREFILL = 1 << 16;
+inline constexpr size_t CONCURRENT_BATCH = 1 << 10;
+
+template <typename Queue>
+void RunConcurrentQueue(benchmark::State& state) {
+  static Queue* queue = nullptr;
+  if (state.thread_index() == 0) {
+    queue = new Queue(state.threads());
+    std::mt19937 gen(49);
+    for (uint32_t key : RandomKeys(CONCURRENT_PREFILL, gen)) {
+      queue->Push(0, key);
+    }
+  }
+  size_t thread = state.thread_index();
+  std::mt19937 gen(50 + thread);
+  auto keys = RandomKeys(CONCURRENT_BATCH, gen);
+  for (auto _ : state) {
+    for (uint32_t key : keys) {
+      queue->Push(thread, key);
+      benchmark::DoNotOptimize(queue->TryPop(thread));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * CONCURRENT_BATCH * 2);
+  if (state.thread_index() == 0) {
+    delete queue;
+  }
+}
+
+// Mean and max rank of popped keys among the keys in the queue. Threads take turns
+// on one thread, so the rank error doesn't depend on scheduling
+void MeasureRankError(benchmark::State& state, size_t threads, size_t queues_per_thread) {
+  const size_t key_count = 1 << 20;
+  std::mt19937 gen(51);
+  std::vector<uint32_t> keys(key_count);
+  std::iota(keys.begin(), keys.end(), 0);
+  std::shuffle(keys.begin(), keys.end(), gen);
+
+  MultiQueue<uint32_t> queue(threads, queues_per_thread);
+  // Fenwick tree of present keys
+  std::vector<int> present(key_count + 1);
+  auto add = [&](uint32_t key, int delta) {
+    for (size_t i = key + 1; i <= key_count; i += i & -i) {
+      present[i] += delta;
+    }
+  };
+  auto rank = [&](uint32_t key) {
+    int result = 0;
+    for (size_t i = key; i > 0; i -= i & -i) {
+      result += present[i];
+    }
+    return result;
+  };
+
+  size_t next = 0;
+  for (; next < key_count / 2; ++next) {
+    queue.Push(next % threads, keys[next]);
+    add(keys[next], 1);
+  }
+  double rank_sum = 0;
+  int max_rank = 0;
+  size_t pops = 0;
+  for (auto _ : state) {
+    size_t thread = pops % threads;
+    if (next < key_count) {
+      queue.Push(thread, keys[next]);
+      add(keys[next], 1);
+      ++next;
+    }
+    auto key = queue.TryPop(thread);
+    if (!key.has_value()) {
+      state.SkipWithError("The queue ran out of keys");
+      break;
+    }
+    int key_rank = rank(*key);
+    rank_sum += key_rank;
+    max_rank = std::max(max_rank, key_rank);
+    add(*key, -1);
+    ++pops;
+  }
+  state.counters["mean_rank_error"] = pops == 0 ? 0 : rank_sum / pops;
+  state.counters["max_rank_error"] = max_rank;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <size_t Arity>
+void BM_DaryHeapPushPop(benchmark::State& state) {
+  StdLikeDaryHeap<Arity> heap;
+  RunPushPopTrace(state, heap);
+}
+
+void BM_StdPriorityQueuePushPop(benchmark::State& state) {
+  std::priority_queue<uint32_t> heap;
+  RunPushPopTrace(state, heap);
+}
+
+template <size_t Arity>
+void BM_DaryHeapHeapify(benchmark::State& state) {
+  std::mt19937 gen(46);
+  auto keys = RandomKeys(state.range(0), gen);
+  DaryHeap<uint32_t, Arity> heap;
+  for (auto _ : state) {
+    heap.Heapify(keys.begin(), keys.end());
+    benchmark::DoNotOptimize(heap.Top());
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_StdPriorityQueueHeapify(benchmark::State& state) {
+  std::mt19937 gen(46);
+  auto keys = RandomKeys(state.range(0), gen);
+  for (auto _ : state) {
+    std::priority_queue<uint32_t> heap(keys.begin(), keys.end());
+    benchmark::DoNotOptimize(heap.top());
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+// Pushing a batch as big as the heap
+template <size_t Arity>
+void BM_DaryHeapPushRange(benchmark::State& state) {
+  std::mt19937 gen(47);
+  auto initial = RandomKeys(state.range(0), gen);
+  auto batch = RandomKeys(state.range(0), gen);
+  DaryHeap<uint32_t, Arity> heap;
+  for (auto _ : state) {
+    state.PauseTiming();
+    heap.Heapify(initial.begin(), initial.end());
+    state.ResumeTiming();
+    heap.PushRange(batch.begin(), batch.end());
+    benchmark::DoNotOptimize(heap.Top());
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_StdPriorityQueuePushRange(benchmark::State& state) {
+  std::mt19937 gen(47);
+  auto initial = RandomKeys(state.range(0), gen);
+  auto batch = RandomKeys(state.range(0), gen);
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::priority_queue<uint32_t> heap(initial.begin(), initial.end());
+    state.ResumeTiming();
+    for (uint32_t key : batch) {
+      heap.push(key);
+    }
+    benchmark::DoNotOptimize(heap.top());
+    state.PauseTiming();
+    heap = {};
+    state.ResumeTiming();
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+template <size_t Arity>
+void BM_DaryHeapSort(benchmark::State& state) {
+  std::mt19937 gen(48);
+  auto keys = RandomKeys(state.range(0), gen);
+  Vector<uint32_t> values;
+  for (auto _ : state) {
+    state.PauseTiming();
+    values.Clear();
+    for (uint32_t key : keys) {
+      values.PushBack(key);
+    }
+    state.ResumeTiming();
+    HeapSort<Arity>(values);
+    benchmark::DoNotOptimize(values.Data());
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_StdHeapSort(benchmark::State& state) {
+  std::mt19937 gen(48);
+  auto keys = RandomKeys(state.range(0), gen);
+  std::vector<uint32_t> values;
+  for (auto _ : state) {
+    state.PauseTiming();
+    values = keys;
+    state.ResumeTiming();
+    std::make_heap(values.begin(), values.end());
+    std::sort_heap(values.begin(), values.end());
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_DijkstraIndexedHeap(benchmark::State& state) {
+  RunDijkstra(state, DijkstraIndexed);
+}
+
+void BM_DijkstraLazyStdPriorityQueue(benchmark::State& state) {
+  RunDijkstra(state, DijkstraLazy<StdLazyHeap>);
+}
+
+template <size_t Arity>
+void BM_DijkstraLazyDaryHeap(benchmark::State& state) {
+  RunDijkstra(state, DijkstraLazy<StdLikeLazyDaryHeap<Arity>>);
+}
+
+
+void BM_PairingHeapMeld(benchmark::State& state) {
+  RunMeldWorkload<PairingHeap<uint32_t, std::greater<uint32_t>>>(state);
+}
+
+template <size_t Arity>
+void BM_DaryHeapMeld(benchmark::State& state) {
+  RunMeldWorkload<DaryHeap<uint32_t, Arity>>(state);
+}
+
+
+void BM_MinMaxHeapSlidingTopK(benchmark::State& state) {
+  RunSlidingTopK<MinMaxHeap<uint32_t>>(state);
+}
+
+void BM_TwinHeapsSlidingTopK(benchmark::State& state) {
+  RunSlidingTopK<TwinHeaps>(state);
+}
+
+
+void BM_MultiQueueConcurrent(benchmark::State& state) {
+  RunConcurrentQueue<MultiQueue<uint32_t>>(state);
+}
+
+void BM_LockedHeapConcurrent(benchmark::State& state) {
+  RunConcurrentQueue<LockedHeap>(state);
+}
+
+// Threads x queues per thread
+void BM_MultiQueueRankError(benchmark::State& state) {
+  MeasureRankError(state, state.range(0), state.range(1));
+}
+
+
+// Sizes x percent of pushes
+#define PUSH_POP_ARGS ArgsProduct({{1<<10, 1<<16, 1<<22}, {25, 50, 75}})->Complexity()->Unit(benchmark::kMillisecond)
+BENCHMARK(BM_DaryHeapPushPop<2>)->PUSH_POP_ARGS;
+BENCHMARK(BM_DaryHeapPushPop<4>)->PUSH_POP_ARGS;
+BENCHMARK(BM_DaryHeapPushPop<8>)->PUSH_POP_ARGS;
+BENCHMARK(BM_StdPriorityQueuePushPop)->PUSH_POP_ARGS;
+BENCHMARK(BM_DaryHeapHeapify<2>)->Range(1<<10, 1<<22)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DaryHeapHeapify<4>)->Range(1<<10, 1<<22)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DaryHeapHeapify<8>)->Range(1<<10, 1<<22)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StdPriorityQueueHeapify)->Range(1<<10, 1<<22)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DaryHeapPushRange<4>)->Range(1<<10, 1<<22)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StdPriorityQueuePushRange)->Range(1<<10, 1<<22)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DaryHeapSort<2>)->Range(1<<10, 1<<22)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DaryHeapSort<4>)->Range(1<<10, 1<<22)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DaryHeapSort<8>)->Range(1<<10, 1<<22)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StdHeapSort)->Range(1<<10, 1<<22)->Complexity()->Unit(benchmark::kMillisecond);
+// Vertices x out-degree
+#define DIJKSTRA_ARGS ArgsProduct({{1<<10, 1<<14, 1<<18, 1<<20}, {4, 16}})->Complexity()->Unit(benchmark::kMillisecond)
+BENCHMARK(BM_DijkstraIndexedHeap)->DIJKSTRA_ARGS;
+BENCHMARK(BM_DijkstraLazyStdPriorityQueue)->DIJKSTRA_ARGS;
+BENCHMARK(BM_DijkstraLazyDaryHeap<2>)->DIJKSTRA_ARGS;
+BENCHMARK(BM_DijkstraLazyDaryHeap<4>)->DIJKSTRA_ARGS;
+// Shard size x percent of melded keys popped
+#define MELD_ARGS ArgsProduct({{1<<4, 1<<8, 1<<12, 1<<16}, {0, 10, 100}})->Complexity()->Unit(benchmark::kMillisecond)
+BENCHMARK(BM_PairingHeapMeld)->MELD_ARGS;
+BENCHMARK(BM_DaryHeapMeld<2>)->MELD_ARGS;
+BENCHMARK(BM_DaryHeapMeld<4>)->MELD_ARGS;
+BENCHMARK(BM_MinMaxHeapSlidingTopK)->Range(1<<4, 1<<18)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TwinHeapsSlidingTopK)->Range(1<<4, 1<<18)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MultiQueueConcurrent)->ThreadRange(1, 16)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_LockedHeapConcurrent)->ThreadRange(1, 16)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MultiQueueRankError)->ArgsProduct({{1, 4, 16, 64}, {1, 2, 4}})->Iterations(1<<19);
+
+BENCHMARK_MAIN();
\ No newline at end of file
@@ -0,0 +1,624 @@
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <list>
+#include <map>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+
+#include <fmt/core.h>
+#include <gtest/gtest.h>
+
+#include "../heap.hpp"
+#include "../indexed_heap.hpp"
+#include "../pairing_heap.hpp"
+#include "../min_max_heap.hpp"
+#include "../multi_queue.hpp"
+
+template <typename Heap>
+class DaryHeapTest: public testing::Test {
+};
+
+using DaryHeapTypes = testing::Types<DaryHeap<int, 2>, DaryHeap<int, 4>, DaryHeap<int, 8>>;
+TYPED_TEST_SUITE(DaryHeapTest, DaryHeapTypes);
+
+std::list<int> RandomInts(size_t size, int max, std::mt19937& gen) {
+  std::uniform_int_distribution<int> dist(0, max);
+  std::list<int> values;
+  for (size_t i = 0; i < size; ++i) {
+    values.push_back(dist(gen));
+  }
+  return values;
+}
+
+template <typename Heap>
+void ExpectPopsSorted(Heap& heap, std::list<int> expected) {
+  expected.sort(std::greater<int>());
+  ASSERT_EQ(heap.Size(), expected.size());
+  for (int value : expected) {
+    ASSERT_EQ(heap.Top(), value);
+    heap.Pop();
+  }
+  ASSERT_TRUE(heap.IsEmpty());
+}
+
+TYPED_TEST(DaryHeapTest, PushPop) {
+  std::mt19937 gen(45);
+  TypeParam heap;
+  std::list<int> pushed;
+  // Mixed pushes and pops with many duplicates
+  for (int round = 0; round < 1000; ++round) {
+    for (int value : RandomInts(gen() % 5, 100, gen)) {
+      heap.Push(value);
+      pushed.push_back(value);
+    }
+    if (gen() % 2 == 0 && !heap.IsEmpty()) {
+      auto max = std::max_element(pushed.begin(), pushed.end());
+      ASSERT_EQ(heap.Top(), *max);
+      ASSERT_EQ(heap.Extract(), *max);
+      pushed.erase(max);
+    }
+  }
+  ExpectPopsSorted(heap, pushed);
+}
+
+TYPED_TEST(DaryHeapTest, Heapify) {
+  std::mt19937 gen(46);
+  for (size_t size : {0, 1, 2, 7, 8, 9, 100, 4097}) {
+    auto values = RandomInts(size, 1000, gen);
+    TypeParam heap(values.begin(), values.end());
+    ExpectPopsSorted(heap, values);
+  }
+}
+
+TYPED_TEST(DaryHeapTest, PushRange) {
+  std::mt19937 gen(47);
+  for (size_t old_size : {0, 1, 10, 1000}) {
+    for (size_t count : {0, 1, 5, 100, 1000, 5000}) {
+      auto values = RandomInts(old_size, 1 << 20, gen);
+      TypeParam heap(values.begin(), values.end());
+      auto pushed = RandomInts(count, 1 << 20, gen);
+      heap.PushRange(pushed.begin(), pushed.end());
+      values.splice(values.end(), pushed);
+      ExpectPopsSorted(heap, values);
+    }
+  }
+}
+
+TYPED_TEST(DaryHeapTest, Empty) {
+  TypeParam heap;
+  ASSERT_TRUE(heap.IsEmpty());
+  ASSERT_THROW(heap.Top(), std::underflow_error);
+  ASSERT_THROW(heap.Pop(), std::underflow_error);
+  heap.Push(1);
+  heap.Pop();
+  ASSERT_THROW(heap.Extract(), std::underflow_error);
+}
+
+TEST(DaryHeapTest, MinHeapOfStrings) {
+  DaryHeap<std::string, 4, std::greater<std::string>> heap;
+  for (const char* value : {"pear", "apple", "plum", "fig", "apple"}) {
+    heap.Emplace(value);
+  }
+  std::string popped;
+  while (!heap.IsEmpty()) {
+    popped += heap.Extract() + " ";
+  }
+  ASSERT_EQ(popped, "apple apple fig pear plum ");
+}
+
+template <size_t Arity>
+void CheckHeapSort(std::mt19937& gen) {
+  for (size_t size : {0, 1, 2, 3, 17, 1000, 10007}) {
+    auto values = RandomInts(size, size / 2, gen);
+    Vector<int> sorted;
+    for (int value : values) {
+      sorted.PushBack(value);
+    }
+    HeapSort<Arity>(sorted);
+    values.sort();
+    auto it = values.begin();
+    for (size_t i = 0; i < sorted.Size(); ++i, ++it) {
+      ASSERT_EQ(sorted[i], *it) << "Arity " << Arity << ", size " << size;
+    }
+  }
+}
+
+TEST(DaryHeapTest, HeapSort) {
+  std::mt19937 gen(48);
+  CheckHeapSort<2>(gen);
+  CheckHeapSort<3>(gen);
+  CheckHeapSort<4>(gen);
+  CheckHeapSort<8>(gen);
+
+  Vector<int> descending;
+  for (int i = 0; i < 100; ++i) {
+    descending.PushBack(i);
+  }
+  HeapSort(descending, std::greater<int>());
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_EQ(descending[i], 99 - i);
+  }
+}
+
+
+TYPED_TEST(DaryHeapTest, Meld) {
+  std::mt19937 gen(49);
+  for (size_t size : {0, 3, 1000}) {
+    for (size_t other_size : {0, 5, 2000}) {
+      auto values = RandomInts(size, 1000, gen);
+      auto other_values = RandomInts(other_size, 1000, gen);
+      TypeParam heap(values.begin(), values.end());
+      TypeParam other(other_values.begin(), other_values.end());
+      heap.Meld(other);
+      ASSERT_TRUE(other.IsEmpty());
+      values.splice(values.end(), other_values);
+      ExpectPopsSorted(heap, values);
+    }
+  }
+}
+
+TEST(IndexedHeapTest, RandomOperations) {
+  std::mt19937 gen(46);
+  IndexedHeap<int> heap;
+  // The model: value by handle
+  std::map<size_t, int> values;
+  auto random_handle = [&] {
+    auto it = values.begin();
+    std::advance(it, gen() % values.size());
+    return it->first;
+  };
+  for (int step = 0; step < 20000; ++step) {
+    int value = gen() % 1000;
+    switch (values.empty() ? 0 : gen() % 6) {
+      case 0:
+      case 1: {
+        size_t handle = heap.Push(value);
+        ASSERT_FALSE(values.contains(handle));
+        values[handle] = value;
+        break;
+      }
+      case 2: {
+        size_t handle = random_handle();
+        values[handle] = std::min(values[handle], value);
+        heap.DecreaseKey(handle, values[handle]);
+        break;
+      }
+      case 3: {
+        size_t handle = random_handle();
+        values[handle] = std::max(values[handle], value);
+        heap.IncreaseKey(handle, values[handle]);
+        break;
+      }
+      case 4: {
+        size_t handle = random_handle();
+        heap.Erase(handle);
+        values.erase(handle);
+        break;
+      }
+      case 5: {
+        int min = std::min_element(values.begin(), values.end(), [](auto& a, auto& b) {
+          return a.second < b.second;
+        })->second;
+        ASSERT_EQ(heap.Top(), min);
+        size_t handle = heap.TopHandle();
+        ASSERT_EQ(values[handle], min);
+        heap.Pop();
+        values.erase(handle);
+        break;
+      }
+    }
+    ASSERT_EQ(heap.Size(), values.size());
+  }
+  for (auto [handle, value] : values) {
+    ASSERT_TRUE(heap.Contains(handle));
+    ASSERT_EQ(heap.Get(handle), value);
+  }
+}
+
+TEST(IndexedHeapTest, Handles) {
+  IndexedHeap<std::string> heap;
+  size_t pear = heap.Push("pear");
+  size_t apple = heap.Push("apple");
+  size_t plum = heap.Push("plum");
+  ASSERT_EQ(heap.Top(), "apple");
+  heap.Update(pear, "banana");
+  heap.Update(apple, "zucchini");
+  ASSERT_EQ(heap.Top(), "banana");
+  ASSERT_EQ(heap.TopHandle(), pear);
+
+  ASSERT_THROW(heap.DecreaseKey(plum, "quince"), std::invalid_argument);
+  ASSERT_THROW(heap.IncreaseKey(plum, "fig"), std::invalid_argument);
+  ASSERT_EQ(heap.Get(plum), "plum");
+
+  heap.Erase(plum);
+  ASSERT_FALSE(heap.Contains(plum));
+  ASSERT_THROW(heap.Erase(plum), std::out_of_range);
+  ASSERT_THROW(heap.Get(100), std::out_of_range);
+  // A free handle is reused
+  ASSERT_EQ(heap.Push("cherry"), plum);
+  ASSERT_EQ(heap.Extract(), "banana");
+  ASSERT_EQ(heap.Extract(), "cherry");
+  ASSERT_EQ(heap.Extract(), "zucchini");
+  ASSERT_THROW(heap.Pop(), std::underflow_error);
+  ASSERT_THROW(heap.TopHandle(), std::underflow_error);
+}
+
+TEST(IndexedHeapTest, ExtractReversedStrings) {
+  // Long strings are heap-allocated, so a moved-from one is empty
+  IndexedHeap<std::string, 2, std::greater<std::string>> heap;
+  std::vector<std::string> values;
+  for (char c = 'a'; c <= 'g'; ++c) {
+    values.emplace_back(40, c);
+    heap.Push(values.back());
+  }
+  for (auto it = values.rbegin(); it != values.rend(); ++it) {
+    ASSERT_EQ(heap.Extract(), *it);
+  }
+  ASSERT_TRUE(heap.IsEmpty());
+}
+
+TEST(IndexedHeapTest, Dijkstra) {
+  std::mt19937 gen(47);
+  const size_t vertices = 300;
+  std::list<std::tuple<size_t, size_t, int>> edges;
+  for (size_t i = 0; i < vertices * 5; ++i) {
+    edges.emplace_back(gen() % vertices, gen() % vertices, gen() % 100);
+  }
+
+  // Bellman-Ford
+  std::map<size_t, int> expected{{0, 0}};
+  for (bool changed = true; changed;) {
+    changed = false;
+    for (auto [from, to, weight] : edges) {
+      if (expected.contains(from) && (!expected.contains(to) || expected[from] + weight < expected[to])) {
+        expected[to] = expected[from] + weight;
+        changed = true;
+      }
+    }
+  }
+
+  IndexedHeap<std::pair<int, size_t>> heap;
+  std::map<size_t, size_t> handles{{0, heap.Push({0, 0})}};
+  std::map<size_t, int> distances;
+  while (!heap.IsEmpty()) {
+    auto [distance, vertex] = heap.Extract();
+    distances[vertex] = distance;
+    for (auto [from, to, weight] : edges) {
+      if (from != vertex || distances.contains(to)) {
+        continue;
+      }
+      if (!handles.contains(to)) {
+        handles[to] = heap.Push({distance + weight, to});
+      } else if (distance + weight < heap.Get(handles[to]).first) {
+        heap.DecreaseKey(handles[to], {distance + weight, to});
+      }
+    }
+  }
+  ASSERT_EQ(distances, expected);
+}
+
+
+using PairingHandle = PairingHeap<int>::Handle;
+
+// Checks the heap against the model: (handle, value) of every element
+void ExpectPairingHeapEquals(PairingHeap<int>& heap, std::list<std::pair<PairingHandle, int>>& values) {
+  ASSERT_EQ(heap.Size(), values.size());
+  for (auto [handle, value] : values) {
+    ASSERT_EQ(heap.Get(handle), value);
+  }
+}
+
+// Pops the top from the heap and the model
+void PopPairingHeap(PairingHeap<int>& heap, std::list<std::pair<PairingHandle, int>>& values) {
+  auto min = std::min_element(values.begin(), values.end(), [](auto& a, auto& b) {
+    return a.second < b.second;
+  });
+  ASSERT_EQ(heap.Top(), min->second);
+  auto top = std::find_if(values.begin(), values.end(), [&](auto& element) {
+    return element.first == heap.TopHandle();
+  });
+  ASSERT_NE(top, values.end());
+  ASSERT_EQ(heap.Extract(), top->second);
+  values.erase(top);
+}
+
+TEST(PairingHeapTest, RandomOperations) {
+  std::mt19937 gen(50);
+  PairingHeap<int> heap;
+  std::list<std::pair<PairingHandle, int>> values;
+  auto random_element = [&] {
+    auto it = values.begin();
+    std::advance(it, gen() % values.size());
+    return it;
+  };
+  for (int step = 0; step < 20000; ++step) {
+    int value = gen() % 1000;
+    switch (values.empty() ? 0 : gen() % 5) {
+      case 0:
+      case 1:
+        values.emplace_back(heap.Push(value), value);
+        break;
+      case 2: {
+        auto it = random_element();
+        it->second = std::min(it->second, value);
+        heap.DecreaseKey(it->first, it->second);
+        break;
+      }
+      case 3: {
+        auto it = random_element();
+        heap.Erase(it->first);
+        values.erase(it);
+        break;
+      }
+      case 4:
+        PopPairingHeap(heap, values);
+        break;
+    }
+    ASSERT_EQ(heap.Size(), values.size());
+  }
+  ExpectPairingHeapEquals(heap, values);
+  while (!values.empty()) {
+    PopPairingHeap(heap, values);
+  }
+  ASSERT_THROW(heap.Pop(), std::underflow_error);
+}
+
+TEST(PairingHeapTest, Meld) {
+  std::mt19937 gen(51);
+  PairingHeap<int> heap;
+  std::list<std::pair<PairingHandle, int>> values;
+  for (int round = 0; round < 200; ++round) {
+    // Shards of random sizes, some of them empty, with popped and erased elements
+    PairingHeap<int> shard;
+    std::list<std::pair<PairingHandle, int>> shard_values;
+    for (int value : RandomInts(gen() % 50, 1000, gen)) {
+      shard_values.emplace_back(shard.Push(value), value);
+    }
+    if (!shard_values.empty() && gen() % 2 == 0) {
+      PopPairingHeap(shard, shard_values);
+    }
+    if (!shard_values.empty() && gen() % 2 == 0) {
+      shard.Erase(shard_values.back().first);
+      shard_values.pop_back();
+    }
+    heap.Meld(shard);
+    ASSERT_TRUE(shard.IsEmpty());
+    values.splice(values.end(), shard_values);
+    // The emptied shard is still usable
+    shard.Push(1);
+
+    // Handles from the shard are valid in the heap
+    if (!values.empty()) {
+      auto it = values.begin();
+      std::advance(it, gen() % values.size());
+      it->second -= 10;
+      heap.DecreaseKey(it->first, it->second);
+      PopPairingHeap(heap, values);
+    }
+  }
+  heap.Meld(heap);
+  ExpectPairingHeapEquals(heap, values);
+
+  PairingHeap<int> moved(std::move(heap));
+  ASSERT_TRUE(heap.IsEmpty());
+  while (!values.empty()) {
+    PopPairingHeap(moved, values);
+  }
+}
+
+TEST(PairingHeapTest, Errors) {
+  PairingHeap<std::string> heap;
+  ASSERT_THROW(heap.Top(), std::underflow_error);
+  ASSERT_THROW(heap.Get({}), std::invalid_argument);
+  auto pear = heap.Push("pear");
+  ASSERT_THROW(heap.DecreaseKey(pear, "plum"), std::invalid_argument);
+  heap.DecreaseKey(pear, "apple");
+  ASSERT_EQ(heap.Top(), "apple");
+  ASSERT_EQ(heap.TopHandle(), pear);
+}
+
+
+TEST(MinMaxHeapTest, RandomOperations) {
+  std::mt19937 gen(52);
+  MinMaxHeap<int> heap;
+  std::multiset<int> values;
+  for (int step = 0; step < 50000; ++step) {
+    switch (values.empty() ? 0 : gen() % 4) {
+      case 0:
+      case 1: {
+        int value = gen() % 500;
+        heap.Push(value);
+        values.insert(value);
+        break;
+      }
+      case 2:
+        ASSERT_EQ(heap.ExtractMin(), *values.begin());
+        values.erase(values.begin());
+        break;
+      case 3:
+        ASSERT_EQ(heap.ExtractMax(), *values.rbegin());
+        values.erase(std::prev(values.end()));
+        break;
+    }
+    ASSERT_EQ(heap.Size(), values.size());
+    if (!values.empty()) {
+      ASSERT_EQ(heap.PeekMin(), *values.begin());
+      ASSERT_EQ(heap.PeekMax(), *values.rbegin());
+    }
+  }
+}
+
+TEST(MinMaxHeapTest, Heapify) {
+  std::mt19937 gen(53);
+  for (size_t size : {0, 1, 2, 3, 4, 7, 8, 15, 16, 100, 4097}) {
+    auto values = RandomInts(size, 1000, gen);
+    MinMaxHeap<int> heap(values.begin(), values.end());
+    std::multiset<int> sorted(values.begin(), values.end());
+    // Pops from both ends in turns
+    for (bool min = true; !sorted.empty(); min = !min) {
+      if (min) {
+        ASSERT_EQ(heap.PeekMin(), *sorted.begin());
+        heap.PopMin();
+        sorted.erase(sorted.begin());
+      } else {
+        ASSERT_EQ(heap.PeekMax(), *sorted.rbegin());
+        heap.PopMax();
+        sorted.erase(std::prev(sorted.end()));
+      }
+    }
+    ASSERT_TRUE(heap.IsEmpty());
+  }
+}
+
+TEST(MinMaxHeapTest, Errors) {
+  MinMaxHeap<std::string, std::greater<std::string>> heap;
+  ASSERT_THROW(heap.PeekMin(), std::underflow_error);
+  ASSERT_THROW(heap.PeekMax(), std::underflow_error);
+  ASSERT_THROW(heap.PopMin(), std::underflow_error);
+  ASSERT_THROW(heap.PopMax(), std::underflow_error);
+  heap.Emplace("apple");
+  heap.Emplace("pear");
+  heap.Emplace("fig");
+  // The order is reversed by the comparator
+  ASSERT_EQ(heap.PeekMin(), "pear");
+  ASSERT_EQ(heap.PeekMax(), "apple");
+}
+
+
+TEST(MultiQueueTest, OneQueueIsExact) {
+  std::mt19937 gen(54);
+  MultiQueue<int> queue(1, 1, 1);
+  auto values = RandomInts(1000, 100, gen);
+  for (int value : values) {
+    queue.Push(0, value);
+  }
+  values.sort();
+  for (int value : values) {
+    ASSERT_EQ(queue.TryPop(0), value);
+  }
+  ASSERT_EQ(queue.TryPop(0), std::nullopt);
+  ASSERT_THROW(queue.Push(1, 0), std::out_of_range);
+  ASSERT_THROW(MultiQueue<int>(0), std::invalid_argument);
+}
+
+// Number of present keys below key
+class RankCounter{
+public:
+  explicit RankCounter(size_t size) : tree_(size + 1) {
+  }
+
+  void Add(size_t key, int delta) {
+    for (++key; key < tree_.size(); key += key & -key) {
+      tree_[key] += delta;
+    }
+  }
+
+  int Rank(size_t key) const {
+    int rank = 0;
+    for (; key > 0; key -= key & -key) {
+      rank += tree_[key];
+    }
+    return rank;
+  }
+
+private:
+  std::deque<int> tree_;
+};
+
+TEST(MultiQueueTest, RankError) {
+  // Threads take turns on one thread of the test
+  const size_t threads = 4;
+  const size_t size = 1 << 16;
+  std::mt19937 gen(55);
+  std::deque<size_t> keys(size);
+  std::iota(keys.begin(), keys.end(), 0);
+  std::shuffle(keys.begin(), keys.end(), gen);
+
+  MultiQueue<size_t> queue(threads);
+  RankCounter ranks(size);
+  for (size_t i = 0; i < size / 2; ++i) {
+    queue.Push(i % threads, keys[i]);
+    ranks.Add(keys[i], 1);
+  }
+  for (size_t thread = 0; thread < threads; ++thread) {
+    queue.Flush(thread);
+  }
+
+  // Pushes and pops in turns, then pops everything
+  double rank_sum = 0;
+  size_t pops = 0;
+  size_t next = size / 2;
+  while (true) {
+    size_t thread = pops % threads;
+    if (next < size) {
+      queue.Push(thread, keys[next]);
+      ranks.Add(keys[next], 1);
+      ++next;
+    }
+    auto key = queue.TryPop(thread);
+    if (!key.has_value()) {
+      break;
+    }
+    rank_sum += ranks.Rank(*key);
+    ranks.Add(*key, -1);
+    ++pops;
+  }
+  ASSERT_EQ(pops, size);
+  // O(c * threads) on average
+  ASSERT_LT(rank_sum / pops, 2.0 * queue.QueueCount());
+}
+
+TEST(MultiQueueTest, Concurrent) {
+  const size_t threads = 4;
+  const int per_thread = 20000;
+  MultiQueue<int> queue(threads);
+  std::atomic<int> popped_count = 0;
+  std::deque<std::deque<int>> popped(threads);
+  std::deque<std::thread> workers;
+  for (size_t thread = 0; thread < threads; ++thread) {
+    workers.emplace_back([&, thread] {
+      for (int i = 0; i < per_thread; ++i) {
+        queue.Push(thread, i * threads + thread);
+        if (i % 2 == 1) {
+          if (auto value = queue.TryPop(thread); value.has_value()) {
+            popped[thread].push_back(*value);
+            ++popped_count;
+          }
+        }
+      }
+      queue.Flush(thread);
+      while (popped_count < static_cast<int>(threads) * per_thread) {
+        if (auto value = queue.TryPop(thread); value.has_value()) {
+          popped[thread].push_back(*value);
+          ++popped_count;
+        }
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  std::deque<int> all;
+  for (auto& values : popped) {
+    all.insert(all.end(), values.begin(), values.end());
+  }
+  std::sort(all.begin(), all.end());
+  ASSERT_EQ(all.size(), threads * per_thread);
+  for (size_t i = 0; i < all.size(); ++i) {
+    ASSERT_EQ(all[i], static_cast<int>(i));
+  }
+}
+
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
\ No newline at end of file
@@ -0,0 +1,453 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <fmt/core.h>
+
+#include "../../vector/vector/vector.hpp"
+#include "pdq_sort.hpp"
+
+// Sort of a binary file of T records which doesn't fit in memory.
+//
+// 1. Run generation: the input is read by chunks of what fits in the memory budget,
+//    each chunk is sorted with PdqSort and written to a temporary file, a run.
+// 2. Merge: up to fan-in runs are read at once and merged with a loser tree into the next
+//    run or, on the last pass, into the output. Every run takes two I/O blocks, so
+//    fan-in is about memory_budget / (2 * block_size).
+//
+// Files are read and written by large blocks. With async_io one block of each file
+// is read ahead and one is written behind on another thread while the current one
+// is processed, so disk and CPU work overlap.
+
+struct ExternalSortOptions {
+  // Bytes for records and I/O buffers
+  size_t memory_budget = size_t{256} << 20;
+  // Bytes per read or write
+  size_t block_size = size_t{1} << 20;
+  bool async_io = true;
+  // Where runs go, the system temporary directory if empty
+  std::filesystem::path temp_dir;
+};
+
+// Reads a file of T by blocks
+template <typename T>
+class BlockReader{
+public:
+  BlockReader(const std::filesystem::path& path, size_t block_elements, bool read_ahead)
+    : block_elements_(std::max<size_t>(block_elements, 1)), read_ahead_(read_ahead) {
+    file_ = std::fopen(path.c_str(), "rb");
+    if (file_ == nullptr) {
+      throw std::runtime_error(fmt::format("Can't open {} for reading", path.string()));
+    }
+    std::setvbuf(file_, nullptr, _IONBF, 0);
+    current_.Resize(block_elements_, T());
+    if (read_ahead_) {
+      next_.Resize(block_elements_, T());
+      StartRead();
+    }
+  }
+
+  BlockReader(const BlockReader&) = delete;
+
+  BlockReader& operator=(const BlockReader&) = delete;
+
+  // The next record, nullptr at the end of the file
+  inline const T* Peek() {
+    if (position_ == size_ && !Refill()) {
+      return nullptr;
+    }
+    return current_.Data() + position_;
+  }
+
+  inline void Pop() noexcept {
+    ++position_;
+  }
+
+  // Copies up to count next records to out, returns how many there were
+  size_t Read(T* out, size_t count) {
+    size_t done = 0;
+    while (done < count && (position_ < size_ || Refill())) {
+      size_t chunk = std::min(count - done, size_ - position_);
+      std::copy_n(current_.Data() + position_, chunk, out + done);
+      position_ += chunk;
+      done += chunk;
+    }
+    return done;
+  }
+
+  ~BlockReader() {
+    if (pending_.valid()) {
+      pending_.wait();
+    }
+    std::fclose(file_);
+  }
+
+private:
+  // Reads the block after the current one to next_
+  void StartRead() {
+    pending_ = std::async(std::launch::async, [this] {
+      return ReadBlock(next_.Data());
+    });
+  }
+
+  size_t ReadBlock(T* data) {
+    size_t count = std::fread(data, sizeof(T), block_elements_, file_);
+    if (count < block_elements_ && std::ferror(file_)) {
+      throw std::runtime_error("Error reading a file");
+    }
+    return count;
+  }
+
+  // Makes the next block current, false at the end of the file
+  bool Refill() {
+    if (end_) {
+      return false;
+    }
+    if (read_ahead_) {
+      size_ = pending_.get();
+      current_.Swap(next_);
+      if (size_ > 0) {
+        StartRead();
+      }
+    } else {
+      size_ = ReadBlock(current_.Data());
+    }
+    position_ = 0;
+    end_ = size_ == 0;
+    return !end_;
+  }
+
+private:
+  std::FILE* file_;
+  size_t block_elements_;
+  bool read_ahead_;
+  Vector<T> current_;
+  // Read ahead on another thread
+  Vector<T> next_;
+  std::future<size_t> pending_;
+  size_t position_ = 0;
+  size_t size_ = 0;
+  bool end_ = false;
+};
+
+// Writes a file of T by blocks
+template <typename T>
+class BlockWriter{
+public:
+  BlockWriter(const std::filesystem::path& path, size_t block_elements, bool write_behind)
+    : block_elements_(std::max<size_t>(block_elements, 1)), write_behind_(write_behind) {
+    file_ = std::fopen(path.c_str(), "wb");
+    if (file_ == nullptr) {
+      throw std::runtime_error(fmt::format("Can't open {} for writing", path.string()));
+    }
+    std::setvbuf(file_, nullptr, _IONBF, 0);
+    current_.Resize(block_elements_, T());
+    if (write_behind_) {
+      previous_.Resize(block_elements_, T());
+    }
+  }
+
+  BlockWriter(const BlockWriter&) = delete;
+
+  BlockWriter& operator=(const BlockWriter&) = delete;
+
+  inline void Push(const T& value) {
+    current_[size_++] = value;
+    if (size_ == block_elements_) {
+      Flush();
+    }
+  }
+
+  void Write(const T* data, size_t count) {
+    while (count > 0) {
+      size_t chunk = std::min(count, block_elements_ - size_);
+      std::copy_n(data, chunk, current_.Data() + size_);
+      size_ += chunk;
+      data += chunk;
+      count -= chunk;
+      if (size_ == block_elements_) {
+        Flush();
+      }
+    }
+  }
+
+  // Writes everything out and reports write errors, the writer can't be used after it
+  void Close() {
+    Flush();
+    if (pending_.valid()) {
+      pending_.get();
+    }
+    std::FILE* file = file_;
+    file_ = nullptr;
+    if (std::fclose(file) != 0) {
+      throw std::runtime_error("Error closing a file");
+    }
+  }
+
+  ~BlockWriter() {
+    if (pending_.valid()) {
+      pending_.wait();
+    }
+    if (file_ != nullptr) {
+      std::fclose(file_);
+    }
+  }
+
+private:
+  void Flush() {
+    if (size_ == 0) {
+      return;
+    }
+    if (write_behind_) {
+      // The previous block must be written before its buffer is reused
+      if (pending_.valid()) {
+        pending_.get();
+      }
+      current_.Swap(previous_);
+      size_t count = size_;
+      pending_ = std::async(std::launch::async, [this, count] {
+        WriteBlock(previous_.Data(), count);
+      });
+    } else {
+      WriteBlock(current_.Data(), size_);
+    }
+    size_ = 0;
+  }
+
+  void WriteBlock(const T* data, size_t count) {
+    if (std::fwrite(data, sizeof(T), count, file_) != count) {
+      throw std::runtime_error("Error writing a file");
+    }
+  }
+
+private:
+  std::FILE* file_;
+  size_t block_elements_;
+  bool write_behind_;
+  Vector<T> current_;
+  // Written behind on another thread
+  Vector<T> previous_;
+  std::future<void> pending_;
+  size_t size_ = 0;
+};
+
+// Tournament tree for a k-way merge. Every inner node keeps the source which lost the match
+// there and the root keeps the overall winner, so replacing the winner's head replays
+// only the matches on its path: log(k) comparisons per record, no swaps as in a heap.
+// Ties go to the source with the smaller index, which keeps the merge stable.
+template <typename T, typename Compare>
+class LoserTree{
+public:
+  LoserTree(size_t sources, Compare& comp) : sources_(sources), comp_(comp) {
+    losers_.Resize(std::max<size_t>(sources_, 1), 0);
+    heads_.Resize(sources_, nullptr);
+  }
+
+  // Head of source i before Build(), nullptr if it is empty
+  inline void SetHead(size_t source, const T* head) noexcept {
+    heads_[source] = head;
+  }
+
+  // O(k)
+  void Build() {
+    // Leaf i is node sources_ + i, winners of the subtrees are kept while going up
+    Vector<size_t> winners;
+    winners.Resize(sources_, 0);
+    for (size_t node = sources_; node-- > 1;) {
+      size_t left = WinnerOf(2 * node, winners);
+      size_t right = WinnerOf(2 * node + 1, winners);
+      bool left_wins = Less(left, right);
+      winners[node] = left_wins ? left : right;
+      losers_[node] = left_wins ? right : left;
+    }
+    losers_[0] = sources_ > 1 ? winners[1] : 0;
+  }
+
+  // Source with the least head, its head is nullptr when all are empty
+  inline size_t Winner() const noexcept {
+    return losers_[0];
+  }
+
+  inline const T* WinnerHead() const noexcept {
+    return heads_[losers_[0]];
+  }
+
+  // Sets the next head of the winner and finds the new one
+  void ReplaceWinner(const T* head) {
+    size_t winner = losers_[0];
+    heads_[winner] = head;
+    for (size_t node = (winner + sources_) / 2; node > 0; node /= 2) {
+      if (Less(losers_[node], winner)) {
+        std::swap(losers_[node], winner);
+      }
+    }
+    losers_[0] = winner;
+  }
+
+private:
+  inline size_t WinnerOf(size_t node, const Vector<size_t>& winners) const noexcept {
+    return node >= sources_ ? node - sources_ : winners[node];
+  }
+
+  // Empty sources lose to everything
+  inline bool Less(size_t a, size_t b) {
+    if (heads_[a] == nullptr || heads_[b] == nullptr) {
+      return heads_[b] == nullptr && (heads_[a] != nullptr || a < b);
+    }
+    if (comp_(*heads_[a], *heads_[b])) {
+      return true;
+    }
+    return a < b && !comp_(*heads_[b], *heads_[a]);
+  }
+
+private:
+  size_t sources_;
+  Compare& comp_;
+  Vector<size_t> losers_;
+  Vector<const T*> heads_;
+};
+
+namespace detail {
+
+// Temporary run files, removed with the object
+class RunFiles{
+public:
+  explicit RunFiles(std::filesystem::path dir) : dir_(std::move(dir)) {
+    if (dir_.empty()) {
+      dir_ = std::filesystem::temp_directory_path();
+    }
+    prefix_ = fmt::format("external-sort-{:016x}", std::random_device()() * 0x9E3779B97F4A7C15ull);
+  }
+
+  RunFiles(const RunFiles&) = delete;
+
+  RunFiles& operator=(const RunFiles&) = delete;
+
+  std::filesystem::path Create() {
+    return dir_ / fmt::format("{}-{}.run", prefix_, created_++);
+  }
+
+  static void Remove(const std::filesystem::path& path) noexcept {
+    std::error_code error;
+    std::filesystem::remove(path, error);
+  }
+
+  ~RunFiles() {
+    for (size_t i = 0; i < created_; ++i) {
+      Remove(dir_ / fmt::format("{}-{}.run", prefix_, i));
+    }
+  }
+
+private:
+  std::filesystem::path dir_;
+  std::string prefix_;
+  size_t created_ = 0;
+};
+
+template <typename T, typename Compare>
+void MergeRuns(const std::filesystem::path* runs, size_t count, const std::filesystem::path& output,
+               size_t block_elements, bool async_io, Compare& comp) {
+  Vector<std::unique_ptr<BlockReader<T>>> readers;
+  readers.Reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    readers.PushBack(std::make_unique<BlockReader<T>>(runs[i], block_elements, async_io));
+  }
+  BlockWriter<T> writer(output, block_elements, async_io);
+  LoserTree<T, Compare> tree(count, comp);
+  for (size_t i = 0; i < count; ++i) {
+    tree.SetHead(i, readers[i]->Peek());
+  }
+  tree.Build();
+  while (const T* head = tree.WinnerHead()) {
+    writer.Push(*head);
+    BlockReader<T>& reader = *readers[tree.Winner()];
+    reader.Pop();
+    tree.ReplaceWinner(reader.Peek());
+  }
+  writer.Close();
+}
+
+}  // namespace detail
+
+// Sorts the records of input into output, which may be the same file.
+// T is written to files as is, so it must be trivially copyable
+template <typename T, typename Compare = std::less<T>>
+void ExternalSort(const std::filesystem::path& input, const std::filesystem::path& output,
+                  Compare comp = Compare(), const ExternalSortOptions& options = ExternalSortOptions()) {
+  static_assert(std::is_trivially_copyable_v<T>, "Records are stored in files byte by byte");
+  // Run generation holds a run and two blocks of the input and of the run file
+  size_t block_bytes = std::max(sizeof(T), std::min(options.block_size, options.memory_budget / 8));
+  size_t block_elements = block_bytes / sizeof(T);
+  size_t run_elements = std::max<size_t>(1, (options.memory_budget - std::min(options.memory_budget, 4 * block_bytes)) / sizeof(T));
+  size_t run_blocks = options.memory_budget / (2 * block_bytes);
+  size_t fan_in = std::max<size_t>(2, run_blocks > 0 ? run_blocks - 1 : 0);
+
+  detail::RunFiles files(options.temp_dir);
+  Vector<std::filesystem::path> runs;
+  Vector<T> records;
+  bool single_run = false;
+  {
+    BlockReader<T> reader(input, block_elements, options.async_io);
+    size_t file_elements = std::filesystem::file_size(input) / sizeof(T);
+    records.Resize(std::max<size_t>(1, std::min(run_elements, file_elements)), T());
+    while (true) {
+      size_t count = reader.Read(records.Data(), records.Size());
+      if (count == 0) {
+        break;
+      }
+      records.Resize(count, T());
+      PdqSort(records, comp);
+      // Everything fits into one run, it goes right to the output once the input is closed
+      if (runs.IsEmpty() && reader.Peek() == nullptr) {
+        single_run = true;
+        break;
+      }
+      runs.PushBack(files.Create());
+      BlockWriter<T> writer(runs.Back(), block_elements, options.async_io);
+      writer.Write(records.Data(), count);
+      writer.Close();
+    }
+  }
+  if (single_run || runs.IsEmpty()) {
+    BlockWriter<T> writer(output, block_elements, options.async_io);
+    writer.Write(records.Data(), single_run ? records.Size() : 0);
+    writer.Close();
+    return;
+  }
+  records = Vector<T>();
+
+  // Each pass merges groups of fan_in runs, the last one goes to the output
+  while (runs.Size() > 1) {
+    Vector<std::filesystem::path> merged;
+    for (size_t first = 0; first < runs.Size(); first += fan_in) {
+      size_t count = std::min(fan_in, runs.Size() - first);
+      std::filesystem::path target = runs.Size() <= fan_in ? output : files.Create();
+      detail::MergeRuns<T>(runs.Data() + first, count, target, block_elements, options.async_io, comp);
+      for (size_t i = first; i < first + count; ++i) {
+        detail::RunFiles::Remove(runs[i]);
+      }
+      merged.PushBack(target);
+    }
+    runs.Swap(merged);
+  }
+  if (runs[0] != output) {
+    // Only the last pass writes to the output, unless there was only one run from the start
+    std::error_code error;
+    std::filesystem::rename(runs[0], output, error);
+    if (error) {
+      std::filesystem::copy_file(runs[0], output, std::filesystem::copy_options::overwrite_existing);
+    }
+  }
+}
@@ -0,0 +1,229 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+// Fork-join thread pool with work stealing.
+//
+// Invoke(left, right) may run right on another thread: it pushes right to the bottom
+// of the queue of the current thread and runs left. Idle threads steal from the top
+// of other queues, i.e. the oldest and biggest tasks. When left is done, right is popped
+// back and run in place unless it was stolen, otherwise the thread helps with other
+// tasks until right is finished. So Invoke returns when both are done and tasks may
+// live on the stack of the thread which invoked them.
+//
+// The thread which created the pool is one of its Threads() and must be the one
+// to call the first Invoke, the other threads are started by the pool.
+// Invoke from a thread outside the pool just runs left and right one after another.
+class ForkJoinPool{
+public:
+  explicit ForkJoinPool(size_t threads) : thread_count_(std::max<size_t>(threads, 1)) {
+    queues_ = std::make_unique<WorkQueue[]>(thread_count_);
+    workers_ = std::make_unique<std::thread[]>(thread_count_ - 1);
+    outer_pool_ = current_pool_;
+    outer_index_ = current_index_;
+    current_pool_ = this;
+    current_index_ = thread_count_ - 1;
+    try {
+      for (size_t i = 0; i + 1 < thread_count_; ++i) {
+        workers_[i] = std::thread([this, i] {
+          WorkerLoop(i);
+        });
+        ++started_;
+      }
+    } catch (...) {
+      Stop();
+      throw;
+    }
+  }
+
+  ForkJoinPool(const ForkJoinPool&) = delete;
+
+  ForkJoinPool& operator=(const ForkJoinPool&) = delete;
+
+  inline size_t Threads() const noexcept {
+    return thread_count_;
+  }
+
+  // Runs left() and right(), possibly in parallel. If either throws, rethrows
+  // after both are done, the exception of left first
+  template <typename Left, typename Right>
+  void Invoke(Left&& left, Right&& right) {
+    if (current_pool_ != this) {
+      left();
+      right();
+      return;
+    }
+
+    FuncTask<Right> task(right);
+    WorkQueue& queue = queues_[current_index_];
+    if (!queue.Push(&task)) {
+      left();
+      right();
+      return;
+    }
+
+    std::exception_ptr error;
+    try {
+      left();
+    } catch (...) {
+      error = std::current_exception();
+    }
+    // Everything pushed by left has been joined, so right is at the bottom unless stolen
+    if (queue.PopIf(&task)) {
+      Execute(&task);
+    } else {
+      HelpUntilDone(task);
+    }
+
+    if (error) {
+      std::rethrow_exception(error);
+    }
+    if (task.error_) {
+      std::rethrow_exception(task.error_);
+    }
+  }
+
+  ~ForkJoinPool() {
+    Stop();
+  }
+
+private:
+  class Task{
+    friend class ForkJoinPool;
+
+    protected:
+      explicit Task(void (*run)(Task*)) : run_(run) {
+      }
+
+    private:
+      void (*run_)(Task*);
+      std::atomic<bool> done_{false};
+      std::exception_ptr error_;
+  };
+
+  template <typename Func>
+  class FuncTask : public Task{
+    public:
+      explicit FuncTask(Func& func) : Task(&FuncTask::Run), func_(func) {
+      }
+
+    private:
+      static void Run(Task* task) {
+        static_cast<FuncTask*>(task)->func_();
+      }
+
+    private:
+      Func& func_;
+  };
+
+  // Deque of tasks: the owner pushes and pops at the bottom, thieves take from the top.
+  // Its depth is bounded by the nesting of Invoke, and a full queue makes Invoke sequential
+  class WorkQueue{
+    public:
+      static constexpr size_t CAPACITY = 256;
+
+      bool Push(Task* task) {
+        std::lock_guard lock(mutex_);
+        if (bottom_ - top_ == CAPACITY) {
+          return false;
+        }
+        tasks_[bottom_++ % CAPACITY] = task;
+        return true;
+      }
+
+      // Pops task if it's at the bottom, i.e. wasn't stolen
+      bool PopIf(const Task* task) {
+        std::lock_guard lock(mutex_);
+        if (bottom_ == top_ || tasks_[(bottom_ - 1) % CAPACITY] != task) {
+          return false;
+        }
+        --bottom_;
+        return true;
+      }
+
+      Task* Steal() {
+        std::unique_lock lock(mutex_, std::try_to_lock);
+        if (!lock.owns_lock() || bottom_ == top_) {
+          return nullptr;
+        }
+        return tasks_[top_++ % CAPACITY];
+      }
+
+    private:
+      alignas(64) std::mutex mutex_;
+      size_t top_ = 0;
+      size_t bottom_ = 0;
+      Task* tasks_[CAPACITY];
+  };
+
+  static void Execute(Task* task) noexcept {
+    try {
+      task->run_(task);
+    } catch (...) {
+      task->error_ = std::current_exception();
+    }
+    task->done_.store(true, std::memory_order_release);
+  }
+
+  // A task from the top of another queue, starting after the given one
+  Task* Steal(size_t thief) noexcept {
+    for (size_t i = 1; i < thread_count_; ++i) {
+      if (Task* task = queues_[(thief + i) % thread_count_].Steal(); task != nullptr) {
+        return task;
+      }
+    }
+    return nullptr;
+  }
+
+  void HelpUntilDone(const Task& task) {
+    while (!task.done_.load(std::memory_order_acquire)) {
+      if (Task* other = Steal(current_index_); other != nullptr) {
+        Execute(other);
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  void WorkerLoop(size_t index) {
+    current_pool_ = this;
+    current_index_ = index;
+    while (!stop_.load(std::memory_order_acquire)) {
+      if (Task* task = Steal(index); task != nullptr) {
+        Execute(task);
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  void Stop() noexcept {
+    stop_.store(true, std::memory_order_release);
+    for (size_t i = 0; i < started_; ++i) {
+      workers_[i].join();
+    }
+    started_ = 0;
+    current_pool_ = outer_pool_;
+    current_index_ = outer_index_;
+  }
+
+private:
+  // The pool and the queue of the current thread
+  inline static thread_local ForkJoinPool* current_pool_ = nullptr;
+  inline static thread_local size_t current_index_ = 0;
+
+  size_t thread_count_;
+  std::unique_ptr<WorkQueue[]> queues_;
+  std::unique_ptr<std::thread[]> workers_;
+  size_t started_ = 0;
+  std::atomic<bool> stop_{false};
+  ForkJoinPool* outer_pool_;
+  size_t outer_index_;
+};
@@ -1,8 +1,10 @@
 #pragma once
 
 #include <cstdlib>
+#include <cstddef>
 #include <iterator>
 #include <functional>
+#include <stdexcept>
 #include <utility>
 
 #include <fmt/core.h>
@@ -11,103 +13,310 @@
 template <typename T>
 class ForwardList{
 private:
-  class Node{
-    friend class ForwardListIterator;
+  // Links only. The list keeps one of them before the first element,
+  // the last element links to nullptr, which is End()
+  class BaseNode{
     friend class ForwardList;
-    /*???*/
 
     private:
-      /*???*/
+      BaseNode* next_ = nullptr;
+  };
+
+  class Node : public BaseNode{
+    friend class ForwardList;
+
+    public:
+      explicit Node(const T& value) : value_(value) {
+      }
 
+    private:
+      T value_;
   };
+
 public:
   class ForwardListIterator{
+    friend class ForwardList;
+
     public:
-    /*???*/
+      using value_type = T;
+      using reference_type = value_type&;
+      using pointer_type = value_type*;
+      using reference = reference_type;
+      using pointer = pointer_type;
+      using difference_type = std::ptrdiff_t;
+      using iterator_category = std::forward_iterator_tag;
+
+      inline bool operator==(const ForwardListIterator& other) const {
+          return current == other.current;
+      };
+
+      inline bool operator!=(const ForwardListIterator& other) const {
+          return current != other.current;
+      };
+
+      inline reference_type operator*() const {
+          return static_cast<Node*>(current)->value_;
+      };
+
+      ForwardListIterator& operator++() {
+          current = current->next_;
+          return *this;
+      };
+
+      ForwardListIterator operator++(int) {
+          ForwardListIterator old = *this;
+          current = current->next_;
+          return old;
+      };
+
+      inline pointer_type operator->() const {
+          return &static_cast<Node*>(current)->value_;
+      };
 
   private:
-      ForwardListIterator(const Node*) {
-          // Not implemented
+      explicit ForwardListIterator(const BaseNode* node) : current(const_cast<BaseNode*>(node)) {
       }
   private:
-      Node* current;
+      BaseNode* current;
   };
 
 public:
   ForwardList() {
-    // Not implemented
   }
 
-  explicit ForwardList(size_t /*sz*/) {
-    // Not implemented
+  explicit ForwardList(size_t sz) {
+    while (sz--) {
+      PushFront(T());
+    }
   }
 
-  ForwardList(const std::initializer_list<T>& /*values*/) {
-    // Not implemented
+  ForwardList(const std::initializer_list<T>& values) {
+    AssignRange(values.begin(), values.end());
   }
 
-  ForwardList(const ForwardList& /*other*/) {
-    // Not implemented
+  ForwardList(const ForwardList& other) {
+    AssignRange(other.Begin(), other.End());
   }
 
-  ForwardList& operator=(const ForwardList& /*other*/) {
-    std::abort(); // Not implemented
+  ForwardList& operator=(const ForwardList& other) {
+    if (this != &other) {
+      ForwardList copy(other);
+      Swap(copy);
+    }
+    return *this;
   }
 
   ForwardListIterator Begin() const noexcept {
-    std::abort(); // Not implemented
+    return ForwardListIterator(head_.next_);
   }
 
   ForwardListIterator End() const noexcept {
-    std::abort(); // Not implemented
+    return ForwardListIterator(nullptr);
   }
 
   inline T& Front() const {
-    std::abort(); // Not implemented
+    return *Begin();
   }
 
   inline bool IsEmpty() const noexcept {
-    std::abort(); // Not implemented
+    return size_ == 0;
   }
 
   inline size_t Size() const noexcept {
-    std::abort(); // Not implemented
+    return size_;
   }
 
-  void Swap(ForwardList& /*a*/) {
-    // Not implemented
+  void Swap(ForwardList& a) noexcept {
+    std::swap(head_.next_, a.head_.next_);
+    std::swap(size_, a.size_);
   }
 
-  void EraseAfter(ForwardListIterator /*pos*/) {
-    // Not implemented
+  void EraseAfter(ForwardListIterator pos) {
+    EraseAfter(pos.current);
   }
 
-  void InsertAfter(ForwardListIterator /*pos*/, const T& /*value*/) {
-    // Not implemented
+  void InsertAfter(ForwardListIterator pos, const T& value) {
+    InsertAfter(pos.current, value);
   }
 
-  ForwardListIterator Find(const T& /*value*/) const {
-    std::abort(); // Not implemented
+  ForwardListIterator Find(const T& value) const {
+    for (auto it = Begin(); it != End(); ++it) {
+      if (*it == value) {
+        return it;
+      }
+    }
+    return End();
   }
 
   void Clear() noexcept {
-    // Not implemented
+    BaseNode* node = head_.next_;
+    while (node != nullptr) {
+      BaseNode* next = node->next_;
+      delete static_cast<Node*>(node);
+      node = next;
+    }
+    head_.next_ = nullptr;
+    size_ = 0;
   }
 
-  void PushFront(const T& /*value*/) {
-    // Not implemented
+  void PushFront(const T& value) {
+    InsertAfter(&head_, value);
   }
 
   void PopFront() {
-    // Not implemented
+    if (IsEmpty()) {
+      throw std::underflow_error("PopFront from empty list");
+    }
+    EraseAfter(&head_);
+  }
+
+  // Stable natural merge sort. Relinks nodes, doesn't allocate
+  // and takes O(1) extra memory: a fixed array of run heads on the stack
+  void Sort() {
+    Sort(std::less<T>());
+  }
+
+  // comp(a, b) is true if a goes strictly before b
+  template <typename Compare>
+  void Sort(Compare comp) {
+    if (size_ < 2) {
+      return;
+    }
+    // Bottom-up merging as in binary addition: sorted[i] holds the merge of about 2^i runs,
+    // older runs in higher slots, so equal elements keep their order
+    BaseNode* sorted[SORT_SLOTS] = {};
+    BaseNode* rest = head_.next_;
+    while (rest != nullptr) {
+      BaseNode* carry = TakeRun(rest, comp);
+      size_t slot = 0;
+      while (slot + 1 < SORT_SLOTS && sorted[slot] != nullptr) {
+        carry = MergeChains(sorted[slot], carry, comp);
+        sorted[slot++] = nullptr;
+      }
+      sorted[slot] = sorted[slot] == nullptr ? carry : MergeChains(sorted[slot], carry, comp);
+    }
+
+    BaseNode* result = nullptr;
+    for (auto* chain : sorted) {
+      if (chain != nullptr) {
+        result = result == nullptr ? chain : MergeChains(chain, result, comp);
+      }
+    }
+    head_.next_ = result;
   }
 
   ~ForwardList() {
-    // Not implemented
+    Clear();
+  }
+
+private:
+  static constexpr size_t SORT_SLOTS = 64;
+  // Shorter natural runs are extended by insertion, so random input
+  // doesn't start merging from runs of one or two elements
+  static constexpr size_t MIN_RUN = 8;
+
+  static inline const T& ValueOf(const BaseNode* node) noexcept {
+    return static_cast<const Node*>(node)->value_;
+  }
+
+  void InsertAfter(BaseNode* pos, const T& value) {
+    Node* node = new Node(value);
+    node->next_ = pos->next_;
+    pos->next_ = node;
+    ++size_;
+  }
+
+  void EraseAfter(BaseNode* pos) noexcept {
+    BaseNode* node = pos->next_;
+    pos->next_ = node->next_;
+    delete static_cast<Node*>(node);
+    --size_;
+  }
+
+  // Appends [first, last) in order, the list must be empty
+  template <typename Iterator>
+  void AssignRange(Iterator first, Iterator last) {
+    BaseNode* tail = &head_;
+    for (; first != last; ++first) {
+      InsertAfter(tail, *first);
+      tail = tail->next_;
+    }
+  }
+
+  // Cuts the sorted prefix of rest off as a null-terminated chain and moves rest past it.
+  // A strictly descending prefix is reversed, which keeps the sort stable
+  // because it has no equal elements
+  template <typename Compare>
+  static BaseNode* TakeRun(BaseNode*& rest, Compare& comp) {
+    BaseNode* head = rest;
+    BaseNode* tail = head;
+    BaseNode* next = head->next_;
+    size_t length = 1;
+    if (next != nullptr && comp(ValueOf(next), ValueOf(head))) {
+      tail->next_ = nullptr;
+      while (next != nullptr && comp(ValueOf(next), ValueOf(head))) {
+        BaseNode* after = next->next_;
+        next->next_ = head;
+        head = next;
+        next = after;
+        ++length;
+      }
+    } else {
+      while (next != nullptr && !comp(ValueOf(next), ValueOf(tail))) {
+        tail = next;
+        next = next->next_;
+        ++length;
+      }
+    }
+
+    // Insertion sort of the following nodes into the run, from its tail side
+    // for nodes not less than the tail, so equal elements stay in order
+    while (length < MIN_RUN && next != nullptr) {
+      BaseNode* node = next;
+      next = next->next_;
+      if (!comp(ValueOf(node), ValueOf(tail))) {
+        tail->next_ = node;
+        tail = node;
+      } else if (comp(ValueOf(node), ValueOf(head))) {
+        node->next_ = head;
+        head = node;
+      } else {
+        BaseNode* prev = head;
+        while (!comp(ValueOf(node), ValueOf(prev->next_))) {
+          prev = prev->next_;
+        }
+        node->next_ = prev->next_;
+        prev->next_ = node;
+      }
+      ++length;
+    }
+    tail->next_ = nullptr;
+    rest = next;
+    return head;
+  }
+
+  // Merges two null-terminated chains, taking from first on ties
+  template <typename Compare>
+  static BaseNode* MergeChains(BaseNode* first, BaseNode* second, Compare& comp) {
+    BaseNode head;
+    BaseNode* tail = &head;
+    while (first != nullptr && second != nullptr) {
+      if (comp(ValueOf(second), ValueOf(first))) {
+        tail->next_ = second;
+        second = second->next_;
+      } else {
+        tail->next_ = first;
+        first = first->next_;
+      }
+      tail = tail->next_;
+    }
+    tail->next_ = first != nullptr ? first : second;
+    return head.next_;
   }
 
 private:
-  /*???*/
+  BaseNode head_;
+  size_t size_ = 0;
 };
 
 
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <thread>
+#include <utility>
+
+#include "../../vector/vector/vector.hpp"
+#include "fork_join_pool.hpp"
+#include "small_sort.hpp"
+
+// Stable merge sort on a ForkJoinPool.
+//
+// Both halves are sorted as parallel tasks, ping-ponging between the vector and a buffer
+// of the same size, and then merged. The merge is parallel too: co-ranking finds how many
+// elements of each half go to the first half of the output by binary search,
+// and the two halves of the output are merged as two tasks.
+//
+// Ranges and merges of up to cutoff elements are done sequentially: a smaller cutoff
+// gives more parallelism but more task overhead.
+inline constexpr size_t PARALLEL_SORT_CUTOFF = 1 << 14;
+
+namespace detail {
+
+template <typename T, typename Compare>
+class ParallelMergeSorter{
+public:
+  // pool == nullptr sorts sequentially
+  ParallelMergeSorter(ForkJoinPool* pool, Compare& comp, size_t cutoff) : pool_(pool), comp_(comp), cutoff_(cutoff) {
+  }
+
+  // Sorts data[0, size). The result goes to data or to buffer, the other one is scratch.
+  // Both hold size constructed elements
+  void Sort(T* data, T* buffer, size_t size, bool into_buffer) {
+    if (size <= STABLE_SMALL_SORT_SIZE<T, Compare>) {
+      StableSmallSort(data, data + size, comp_);
+      if (into_buffer) {
+        std::move(data, data + size, buffer);
+      }
+      return;
+    }
+
+    // The halves go to the other array, so that merging brings them back to the target
+    size_t half = size / 2;
+    Fork(size, [&] {
+      Sort(data, buffer, half, !into_buffer);
+    }, [&] {
+      Sort(data + half, buffer + half, size - half, !into_buffer);
+    });
+    T* from = into_buffer ? data : buffer;
+    T* to = into_buffer ? buffer : data;
+    Merge(from, from + half, from + half, from + size, to);
+  }
+
+  // Stable: takes from the first range on ties
+  void Merge(T* first1, T* last1, T* first2, T* last2, T* out) {
+    size_t size1 = last1 - first1;
+    size_t size2 = last2 - first2;
+    size_t total = size1 + size2;
+    if (pool_ == nullptr || total <= cutoff_ || size1 == 0 || size2 == 0) {
+      SequentialMerge(first1, last1, first2, last2, out);
+      return;
+    }
+
+    size_t split = total / 2;
+    size_t from_first = CoRank(split, first1, size1, first2, size2);
+    size_t from_second = split - from_first;
+    Fork(total, [&] {
+      Merge(first1, first1 + from_first, first2, first2 + from_second, out);
+    }, [&] {
+      Merge(first1 + from_first, last1, first2 + from_second, last2, out + split);
+    });
+  }
+
+private:
+  template <typename Left, typename Right>
+  void Fork(size_t size, Left&& left, Right&& right) {
+    if (pool_ != nullptr && size > cutoff_) {
+      pool_->Invoke(left, right);
+    } else {
+      left();
+      right();
+    }
+  }
+
+  // How many of the first count elements of the stable merge come from the first range.
+  // i is too small while the element first1[i] goes before the last one taken from the second range
+  size_t CoRank(size_t count, const T* first1, size_t size1, const T* first2, size_t size2) {
+    size_t low = count > size2 ? count - size2 : 0;
+    size_t high = std::min(count, size1);
+    while (low < high) {
+      size_t middle = low + (high - low) / 2;
+      if (!comp_(first2[count - middle - 1], first1[middle])) {
+        low = middle + 1;
+      } else {
+        high = middle;
+      }
+    }
+    return low;
+  }
+
+  void SequentialMerge(T* first1, T* last1, T* first2, T* last2, T* out) {
+    while (first1 != last1 && first2 != last2) {
+      if (comp_(*first2, *first1)) {
+        *out++ = std::move(*first2++);
+      } else {
+        *out++ = std::move(*first1++);
+      }
+    }
+    out = std::move(first1, last1, out);
+    std::move(first2, last2, out);
+  }
+
+private:
+  ForkJoinPool* pool_;
+  Compare& comp_;
+  size_t cutoff_;
+};
+
+}  // namespace detail
+
+// Stable, on threads threads including the calling one.
+// If comp throws, the elements are left in unspecified order and some of them may be moved-from
+template <typename T, typename Compare>
+void ParallelMergeSort(Vector<T>& values, Compare comp, size_t threads = std::thread::hardware_concurrency(),
+                       size_t cutoff = PARALLEL_SORT_CUTOFF) {
+  size_t size = values.Size();
+  if (size < 2) {
+    return;
+  }
+  cutoff = std::max(cutoff, SMALL_SORT_SIZE);
+
+  T* buffer = static_cast<T*>(::operator new(size * sizeof(T), std::align_val_t{alignof(T)}));
+  try {
+    std::uninitialized_move_n(values.Data(), size, buffer);
+  } catch (...) {
+    ::operator delete(buffer, std::align_val_t{alignof(T)});
+    throw;
+  }
+
+  // The elements are in the buffer now, the sorted ones come back to the vector
+  try {
+    if (threads > 1 && size > cutoff) {
+      ForkJoinPool pool(threads);
+      detail::ParallelMergeSorter<T, Compare>(&pool, comp, cutoff).Sort(buffer, values.Data(), size, true);
+    } else {
+      detail::ParallelMergeSorter<T, Compare>(nullptr, comp, cutoff).Sort(buffer, values.Data(), size, true);
+    }
+  } catch (...) {
+    std::destroy_n(buffer, size);
+    ::operator delete(buffer, std::align_val_t{alignof(T)});
+    throw;
+  }
+  std::destroy_n(buffer, size);
+  ::operator delete(buffer, std::align_val_t{alignof(T)});
+}
+
+template <typename T>
+void ParallelMergeSort(Vector<T>& values) {
+  ParallelMergeSort(values, std::less<T>());
+}
@@ -0,0 +1,379 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#include "../../vector/vector/vector.hpp"
+#include "small_sort.hpp"
+
+// Pattern-defeating quicksort (O. Peters, 2021): introsort which adapts to the input.
+//
+// - The pivot is the median of 3, or the median of 3 medians of 3 (ninther) for long ranges.
+// - If a partition found no element to swap, the range may be already sorted: both sides
+//   get an insertion sort which gives up after a few moves, so sorted and reverse
+//   inputs take O(N).
+// - A range whose leftmost element equals the pivot of its parent is split into
+//   "equal to the pivot" and "greater": each distinct value is partitioned once, so
+//   inputs with few distinct values take O(N * K).
+// - A highly unbalanced partition shuffles a few elements to break the pattern,
+//   and after log(N) of them the range goes to heapsort, so the worst case is O(N log N).
+// - For arithmetic types with the default order the partition is branchless: it first
+//   collects offsets of misplaced elements in blocks, then swaps them.
+//
+// Not stable.
+
+namespace detail {
+
+inline constexpr size_t PDQ_INSERTION_SORT_SIZE = 24;
+inline constexpr size_t PDQ_NINTHER_SIZE = 128;
+// Moves allowed to the insertion sort which checks if a range is sorted
+inline constexpr size_t PDQ_PARTIAL_INSERTION_LIMIT = 8;
+inline constexpr size_t PDQ_BLOCK_SIZE = 64;
+inline constexpr size_t PDQ_CACHE_LINE = 64;
+
+// Insertion sort of a range which has an element not greater than all of it right before first
+template <typename T, typename Compare>
+void UnguardedInsertionSort(T* first, T* last, Compare& comp) {
+  if (first == last) {
+    return;
+  }
+  for (T* it = first + 1; it != last; ++it) {
+    if (!comp(*it, *(it - 1))) {
+      continue;
+    }
+    T value(std::move(*it));
+    T* hole = it;
+    do {
+      *hole = std::move(*(hole - 1));
+      --hole;
+    } while (comp(value, *(hole - 1)));
+    *hole = std::move(value);
+  }
+}
+
+// Insertion sort which gives up after PDQ_PARTIAL_INSERTION_LIMIT moved elements.
+// Returns whether the range is sorted
+template <typename T, typename Compare>
+bool PartialInsertionSort(T* first, T* last, Compare& comp) {
+  if (first == last) {
+    return true;
+  }
+  size_t moves = 0;
+  for (T* it = first + 1; it != last; ++it) {
+    if (comp(*it, *(it - 1))) {
+      T value(std::move(*it));
+      T* hole = it;
+      do {
+        *hole = std::move(*(hole - 1));
+        --hole;
+      } while (hole != first && comp(value, *(hole - 1)));
+      *hole = std::move(value);
+      moves += it - hole;
+    }
+    if (moves > PDQ_PARTIAL_INSERTION_LIMIT) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T, typename Compare>
+inline void Sort2(T* a, T* b, Compare& comp) {
+  if (comp(*b, *a)) {
+    std::iter_swap(a, b);
+  }
+}
+
+template <typename T, typename Compare>
+inline void Sort3(T* a, T* b, T* c, Compare& comp) {
+  Sort2(a, b, comp);
+  Sort2(b, c, comp);
+  Sort2(a, b, comp);
+}
+
+template <typename T, typename Compare>
+void SiftDown(T* heap, size_t size, size_t index, Compare& comp) {
+  T value(std::move(heap[index]));
+  while (2 * index + 1 < size) {
+    size_t child = 2 * index + 1;
+    if (child + 1 < size && comp(heap[child], heap[child + 1])) {
+      ++child;
+    }
+    if (!comp(value, heap[child])) {
+      break;
+    }
+    heap[index] = std::move(heap[child]);
+    index = child;
+  }
+  heap[index] = std::move(value);
+}
+
+template <typename T, typename Compare>
+void HeapSort(T* first, T* last, Compare& comp) {
+  size_t size = last - first;
+  for (size_t i = size / 2; i-- > 0;) {
+    SiftDown(first, size, i, comp);
+  }
+  for (size_t end = size; end > 1; --end) {
+    std::iter_swap(first, first + end - 1);
+    SiftDown(first, end - 1, 0, comp);
+  }
+}
+
+// Swaps first[offsets_left[i]] with last[-offsets_right[i]], i < count.
+// If the counts of misplaced elements differ, a cyclic permutation does it in fewer moves
+template <typename T>
+void SwapOffsets(T* first, T* last, const unsigned char* offsets_left, const unsigned char* offsets_right,
+                 size_t count, bool use_swaps) {
+  if (use_swaps) {
+    for (size_t i = 0; i < count; ++i) {
+      std::iter_swap(first + offsets_left[i], last - offsets_right[i]);
+    }
+  } else if (count > 0) {
+    T* left = first + offsets_left[0];
+    T* right = last - offsets_right[0];
+    T value(std::move(*left));
+    *left = std::move(*right);
+    for (size_t i = 1; i < count; ++i) {
+      left = first + offsets_left[i];
+      *right = std::move(*left);
+      right = last - offsets_right[i];
+      *left = std::move(*right);
+    }
+    *right = std::move(value);
+  }
+}
+
+// Partitions [begin, end) around the pivot *begin into elements less than it and not less.
+// Returns the position of the pivot and whether no element had to be swapped.
+// Needs an element not less than the pivot after end - 1 or in the range
+template <bool Branchless, typename T, typename Compare>
+std::pair<T*, bool> PartitionRight(T* begin, T* end, Compare& comp) {
+  T pivot(std::move(*begin));
+  T* first = begin;
+  T* last = end;
+
+  // The median of 3 guards the first scan, the second one needs a check if nothing was found
+  while (comp(*++first, pivot)) {
+  }
+  if (first - 1 == begin) {
+    while (first < last && !comp(*--last, pivot)) {
+    }
+  } else {
+    while (!comp(*--last, pivot)) {
+    }
+  }
+
+  bool already_partitioned = first >= last;
+  if constexpr (Branchless) {
+    if (!already_partitioned) {
+      std::iter_swap(first, last);
+      ++first;
+
+      // Offsets of elements which are on the wrong side, counted from the block start
+      alignas(PDQ_CACHE_LINE) unsigned char offsets_left[PDQ_BLOCK_SIZE];
+      alignas(PDQ_CACHE_LINE) unsigned char offsets_right[PDQ_BLOCK_SIZE];
+      T* left_base = first;
+      T* right_base = last;
+      size_t left_count = 0;
+      size_t right_count = 0;
+      size_t left_start = 0;
+      size_t right_start = 0;
+      while (first < last) {
+        // Refill only the blocks which are used up, the rest of the range goes to them
+        size_t unknown = last - first;
+        size_t left_split = left_count == 0 ? (right_count == 0 ? unknown / 2 : unknown) : 0;
+        size_t right_split = right_count == 0 ? unknown - left_split : 0;
+
+        size_t left_size = std::min(left_split, PDQ_BLOCK_SIZE);
+        for (size_t i = 0; i < left_size; ++i) {
+          offsets_left[left_count] = static_cast<unsigned char>(i);
+          left_count += !comp(*first, pivot);
+          ++first;
+        }
+        size_t right_size = std::min(right_split, PDQ_BLOCK_SIZE);
+        for (size_t i = 0; i < right_size;) {
+          offsets_right[right_count] = static_cast<unsigned char>(++i);
+          right_count += comp(*--last, pivot);
+        }
+
+        size_t count = std::min(left_count, right_count);
+        SwapOffsets(left_base, right_base, offsets_left + left_start, offsets_right + right_start,
+                    count, left_count == right_count);
+        left_count -= count;
+        right_count -= count;
+        left_start += count;
+        right_start += count;
+        if (left_count == 0) {
+          left_start = 0;
+          left_base = first;
+        }
+        if (right_count == 0) {
+          right_start = 0;
+          right_base = last;
+        }
+      }
+
+      // One block may still have misplaced elements, they go to the boundary
+      if (left_count > 0) {
+        while (left_count-- > 0) {
+          std::iter_swap(left_base + offsets_left[left_start + left_count], --last);
+        }
+        first = last;
+      }
+      if (right_count > 0) {
+        while (right_count-- > 0) {
+          std::iter_swap(right_base - offsets_right[right_start + right_count], first);
+          ++first;
+        }
+        last = first;
+      }
+    }
+  } else {
+    while (first < last) {
+      std::iter_swap(first, last);
+      while (comp(*++first, pivot)) {
+      }
+      while (!comp(*--last, pivot)) {
+      }
+    }
+  }
+
+  T* pivot_pos = first - 1;
+  *begin = std::move(*pivot_pos);
+  *pivot_pos = std::move(pivot);
+  return {pivot_pos, already_partitioned};
+}
+
+// Partitions [begin, end) around the pivot *begin into elements equal to it and greater.
+// Used when an element before begin equals the pivot, so nothing is less than it
+template <typename T, typename Compare>
+T* PartitionLeft(T* begin, T* end, Compare& comp) {
+  T pivot(std::move(*begin));
+  T* first = begin;
+  T* last = end;
+  while (comp(pivot, *--last)) {
+  }
+  if (last + 1 == end) {
+    while (first < last && !comp(pivot, *++first)) {
+    }
+  } else {
+    while (!comp(pivot, *++first)) {
+    }
+  }
+  while (first < last) {
+    std::iter_swap(first, last);
+    while (comp(pivot, *--last)) {
+    }
+    while (!comp(pivot, *++first)) {
+    }
+  }
+
+  T* pivot_pos = last;
+  *begin = std::move(*pivot_pos);
+  *pivot_pos = std::move(pivot);
+  return pivot_pos;
+}
+
+// Swaps a few elements of a range which was on the small side of a bad partition
+// with ones from its quarter points, so the next pivots are different
+template <typename T>
+void BreakPatterns(T* first, T* last) {
+  size_t size = last - first;
+  if (size < PDQ_INSERTION_SORT_SIZE) {
+    return;
+  }
+  std::iter_swap(first, first + size / 4);
+  std::iter_swap(last - 1, last - size / 4);
+  if (size > PDQ_NINTHER_SIZE) {
+    std::iter_swap(first + 1, first + (size / 4 + 1));
+    std::iter_swap(first + 2, first + (size / 4 + 2));
+    std::iter_swap(last - 2, last - (size / 4 + 1));
+    std::iter_swap(last - 3, last - (size / 4 + 2));
+  }
+}
+
+// bad_allowed: unbalanced partitions left before heapsort.
+// leftmost: there's no element before begin which is not greater than all of the range
+template <bool Branchless, typename T, typename Compare>
+void PdqSortLoop(T* begin, T* end, Compare& comp, int bad_allowed, bool leftmost) {
+  while (true) {
+    size_t size = end - begin;
+    if constexpr (Branchless) {
+      if (size <= SORTING_NETWORK_MAX_SIZE) {
+        NetworkSort(begin, size, comp);
+        return;
+      }
+    }
+    if (size < PDQ_INSERTION_SORT_SIZE) {
+      if (leftmost) {
+        InsertionSort(begin, end, comp);
+      } else {
+        UnguardedInsertionSort(begin, end, comp);
+      }
+      return;
+    }
+
+    // The pivot goes to begin
+    size_t half = size / 2;
+    if (size > PDQ_NINTHER_SIZE) {
+      Sort3(begin, begin + half, end - 1, comp);
+      Sort3(begin + 1, begin + (half - 1), end - 2, comp);
+      Sort3(begin + 2, begin + (half + 1), end - 3, comp);
+      Sort3(begin + (half - 1), begin + half, begin + (half + 1), comp);
+      std::iter_swap(begin, begin + half);
+    } else {
+      Sort3(begin + half, begin, end - 1, comp);
+    }
+
+    // The pivot equals the element before the range: put the equal ones aside, they are in place
+    if (!leftmost && !comp(*(begin - 1), *begin)) {
+      begin = PartitionLeft(begin, end, comp) + 1;
+      continue;
+    }
+
+    auto [pivot_pos, already_partitioned] = PartitionRight<Branchless>(begin, end, comp);
+    size_t left_size = pivot_pos - begin;
+    size_t right_size = end - (pivot_pos + 1);
+
+    if (left_size < size / 8 || right_size < size / 8) {
+      if (--bad_allowed == 0) {
+        HeapSort(begin, end, comp);
+        return;
+      }
+      BreakPatterns(begin, pivot_pos);
+      BreakPatterns(pivot_pos + 1, end);
+    } else if (already_partitioned && PartialInsertionSort(begin, pivot_pos, comp) &&
+               PartialInsertionSort(pivot_pos + 1, end, comp)) {
+      return;
+    }
+
+    // Recursion into the left part, the loop goes on with the right one
+    PdqSortLoop<Branchless>(begin, pivot_pos, comp, bad_allowed, leftmost);
+    begin = pivot_pos + 1;
+    leftmost = false;
+  }
+}
+
+}  // namespace detail
+
+template <typename T, typename Compare>
+void PdqSort(Vector<T>& values, Compare comp) {
+  size_t size = values.Size();
+  if (size < 2) {
+    return;
+  }
+  int bad_allowed = static_cast<int>(std::bit_width(size));
+  detail::PdqSortLoop<detail::IS_BRANCHLESS_COMPARISON<T, Compare>>(values.Data(), values.Data() + size, comp,
+                                                                     bad_allowed, true);
+}
+
+template <typename T>
+void PdqSort(Vector<T>& values) {
+  PdqSort(values, std::less<T>());
+}
@@ -0,0 +1,265 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "../../vector/vector/vector.hpp"
+#include "sorting_network.hpp"
+
+// Radix sorts of integral keys, one byte (digit) at a time.
+//
+// RadixSort is LSD: stable counting-sort passes from the lowest byte to the highest,
+// ping-ponging between the vector and a buffer of the same size. Histograms of all bytes
+// are counted in a single pass before scattering, and a byte which is the same
+// in every key is skipped, so e.g. 64-bit keys below 2^20 take 3 passes, not 8.
+//
+// MsdRadixSort is in-place (American flag sort): it permutes elements into buckets
+// of the highest byte by swaps and recurses into buckets by the next byte.
+// No buffer, but it isn't stable.
+//
+// Signed keys are ordered as numbers: their sign bit is flipped before taking bytes.
+// Ranges of up to RADIX_SMALL_SORT elements are sorted by insertion, integers sorted
+// by themselves go to a sorting network if there are at most SORTING_NETWORK_MAX_SIZE of them.
+
+namespace detail {
+
+inline constexpr size_t RADIX_BITS = 8;
+inline constexpr size_t RADIX = size_t{1} << RADIX_BITS;
+inline constexpr size_t RADIX_SMALL_SORT = 64;
+
+template <typename T, typename KeyFunc>
+using RadixKeyOf = std::decay_t<std::invoke_result_t<KeyFunc&, const T&>>;
+
+// Unsigned key with the same order as key
+template <typename Key>
+inline std::make_unsigned_t<Key> RadixKey(Key key) noexcept {
+  using Unsigned = std::make_unsigned_t<Key>;
+  auto bits = static_cast<Unsigned>(key);
+  if constexpr (std::is_signed_v<Key>) {
+    bits = static_cast<Unsigned>(bits ^ (Unsigned{1} << (sizeof(Key) * 8 - 1)));
+  }
+  return bits;
+}
+
+template <typename Unsigned>
+inline size_t Digit(Unsigned key, size_t digit) noexcept {
+  return static_cast<size_t>(key >> (digit * RADIX_BITS)) & (RADIX - 1);
+}
+
+template <typename T, typename KeyFunc>
+inline auto RadixKeyAt(const T& value, KeyFunc& key) {
+  return RadixKey(std::invoke(key, value));
+}
+
+// Stable
+template <typename T, typename KeyFunc>
+void InsertionSortByKey(T* first, T* last, KeyFunc& key) {
+  if (first == last) {
+    return;
+  }
+  for (T* it = first + 1; it != last; ++it) {
+    auto current = RadixKeyAt(*it, key);
+    if (!(current < RadixKeyAt(*(it - 1), key))) {
+      continue;
+    }
+    T value(std::move(*it));
+    T* hole = it;
+    do {
+      *hole = std::move(*(hole - 1));
+      --hole;
+    } while (hole != first && current < RadixKeyAt(*(hole - 1), key));
+    *hole = std::move(value);
+  }
+}
+
+// Equal integers can't be told apart, so a network sorts them stably too
+template <typename T, typename KeyFunc>
+inline constexpr bool IS_RADIX_NETWORK_SORTABLE = std::is_integral_v<T> && std::is_same_v<KeyFunc, std::identity>;
+
+// Stable, for up to RADIX_SMALL_SORT elements
+template <typename T, typename KeyFunc>
+void RadixSmallSort(T* first, T* last, KeyFunc& key) {
+  if constexpr (IS_RADIX_NETWORK_SORTABLE<T, KeyFunc>) {
+    if (static_cast<size_t>(last - first) <= SORTING_NETWORK_MAX_SIZE) {
+      std::less<T> comp;
+      NetworkSort(first, last - first, comp);
+      return;
+    }
+  }
+  InsertionSortByKey(first, last, key);
+}
+
+// Stable counting-sort pass by one digit. offsets are the bucket starts and end up at their ends.
+// The first pass constructs elements in raw memory, the next ones assign to moved-from ones
+template <bool Construct, typename T, typename KeyFunc>
+void ScatterByDigit(T* from, size_t size, T* to, size_t digit, size_t* offsets, KeyFunc& key) {
+  for (size_t i = 0; i < size; ++i) {
+    size_t& pos = offsets[Digit(RadixKeyAt(from[i], key), digit)];
+    if constexpr (Construct) {
+      new (to + pos) T(std::move(from[i]));
+    } else {
+      to[pos] = std::move(from[i]);
+    }
+    ++pos;
+  }
+}
+
+template <typename T, typename KeyFunc>
+void LsdRadixSort(T* data, size_t size, KeyFunc& key) {
+  using Key = RadixKeyOf<T, KeyFunc>;
+  constexpr size_t DIGITS = sizeof(Key);
+
+  if (size <= RADIX_SMALL_SORT) {
+    RadixSmallSort(data, data + size, key);
+    return;
+  }
+
+  size_t counts[DIGITS][RADIX] = {};
+  for (size_t i = 0; i < size; ++i) {
+    auto bits = RadixKeyAt(data[i], key);
+    for (size_t digit = 0; digit < DIGITS; ++digit) {
+      ++counts[digit][Digit(bits, digit)];
+    }
+  }
+
+  // A digit is trivial if every key has the one of the first key
+  size_t passes[DIGITS];
+  size_t pass_count = 0;
+  auto first_bits = RadixKeyAt(data[0], key);
+  for (size_t digit = 0; digit < DIGITS; ++digit) {
+    if (counts[digit][Digit(first_bits, digit)] != size) {
+      passes[pass_count++] = digit;
+    }
+  }
+  if (pass_count == 0) {
+    return;
+  }
+
+  T* buffer = static_cast<T*>(::operator new(size * sizeof(T), std::align_val_t{alignof(T)}));
+  T* from = data;
+  T* to = buffer;
+  for (size_t pass = 0; pass < pass_count; ++pass) {
+    size_t digit = passes[pass];
+    size_t offsets[RADIX];
+    size_t offset = 0;
+    for (size_t bucket = 0; bucket < RADIX; ++bucket) {
+      offsets[bucket] = offset;
+      offset += counts[digit][bucket];
+    }
+    if (pass == 0) {
+      ScatterByDigit<true>(from, size, to, digit, offsets, key);
+    } else {
+      ScatterByDigit<false>(from, size, to, digit, offsets, key);
+    }
+    std::swap(from, to);
+  }
+  if (from != data) {
+    std::move(from, from + size, data);
+  }
+  std::destroy_n(buffer, size);
+  ::operator delete(buffer, std::align_val_t{alignof(T)});
+}
+
+// Sorts [first, last) by digits digit, digit - 1, ..., 0 of the keys
+template <typename T, typename KeyFunc>
+void MsdRadixSortRange(T* first, T* last, size_t digit, KeyFunc& key) {
+  size_t size = last - first;
+  size_t ends[RADIX];
+  while (true) {
+    if (size <= RADIX_SMALL_SORT) {
+      RadixSmallSort(first, last, key);
+      return;
+    }
+
+    size_t counts[RADIX] = {};
+    for (T* it = first; it != last; ++it) {
+      ++counts[Digit(RadixKeyAt(*it, key), digit)];
+    }
+    if (counts[Digit(RadixKeyAt(*first, key), digit)] != size) {
+      size_t offset = 0;
+      for (size_t bucket = 0; bucket < RADIX; ++bucket) {
+        offset += counts[bucket];
+        ends[bucket] = offset;
+      }
+      break;
+    }
+    // Trivial digit
+    if (digit == 0) {
+      return;
+    }
+    --digit;
+  }
+
+  // next[b] is the first element of bucket b which may be not in its place.
+  // Each swap puts the element at next[b] into the bucket it belongs to
+  size_t next[RADIX];
+  next[0] = 0;
+  for (size_t bucket = 1; bucket < RADIX; ++bucket) {
+    next[bucket] = ends[bucket - 1];
+  }
+  for (size_t bucket = 0; bucket < RADIX; ++bucket) {
+    while (next[bucket] != ends[bucket]) {
+      size_t target = Digit(RadixKeyAt(first[next[bucket]], key), digit);
+      if (target == bucket) {
+        ++next[bucket];
+      } else {
+        using std::swap;
+        swap(first[next[bucket]], first[next[target]++]);
+      }
+    }
+  }
+
+  if (digit == 0) {
+    return;
+  }
+  size_t begin = 0;
+  for (size_t bucket = 0; bucket < RADIX; ++bucket) {
+    if (ends[bucket] - begin > 1) {
+      MsdRadixSortRange(first + begin, first + ends[bucket], digit - 1, key);
+    }
+    begin = ends[bucket];
+  }
+}
+
+template <typename T, typename KeyFunc>
+constexpr void CheckRadixSortable() {
+  using Key = RadixKeyOf<T, KeyFunc>;
+  static_assert(std::is_integral_v<Key> && !std::is_same_v<Key, bool>, "Radix sort needs integral keys");
+  static_assert(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_assignable_v<T>,
+                "Radix sort moves elements and can't roll a throwing move back");
+}
+
+}  // namespace detail
+
+// Stable, sorts records by key(record), which must be integral. key is called
+// several times per element, so it should be cheap, like a member access
+template <typename T, typename KeyFunc>
+void RadixSort(Vector<T>& values, KeyFunc key) {
+  detail::CheckRadixSortable<T, KeyFunc>();
+  detail::LsdRadixSort(values.Data(), values.Size(), key);
+}
+
+template <typename T>
+void RadixSort(Vector<T>& values) {
+  RadixSort(values, std::identity());
+}
+
+// In-place, O(1) extra memory besides recursion, not stable
+template <typename T, typename KeyFunc>
+void MsdRadixSort(Vector<T>& values, KeyFunc key) {
+  detail::CheckRadixSortable<T, KeyFunc>();
+  using Key = detail::RadixKeyOf<T, KeyFunc>;
+  if (values.Size() > 1) {
+    detail::MsdRadixSortRange(values.Data(), values.Data() + values.Size(), sizeof(Key) - 1, key);
+  }
+}
+
+template <typename T>
+void MsdRadixSort(Vector<T>& values) {
+  MsdRadixSort(values, std::identity());
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "sorting_network.hpp"
+
+// Base case of the sort engines: ranges this short are sorted by insertion
+inline constexpr size_t SMALL_SORT_SIZE = 16;
+
+namespace detail {
+
+// Stable
+template <typename T, typename Compare>
+void InsertionSort(T* first, T* last, Compare& comp) {
+  if (first == last) {
+    return;
+  }
+  for (T* it = first + 1; it != last; ++it) {
+    if (!comp(*it, *(it - 1))) {
+      continue;
+    }
+    T value(std::move(*it));
+    T* hole = it;
+    do {
+      *hole = std::move(*(hole - 1));
+      --hole;
+    } while (hole != first && comp(value, *(hole - 1)));
+    *hole = std::move(value);
+  }
+}
+
+// Sorting networks aren't stable, but equal integers can't be told apart
+template <typename T, typename Compare>
+inline constexpr bool IS_NETWORK_STABLE = std::is_integral_v<T> && IS_BRANCHLESS_COMPARISON<T, Compare>;
+
+// Base case of the stable engines: integers go to a sorting network, other types to insertion
+template <typename T, typename Compare>
+inline constexpr size_t STABLE_SMALL_SORT_SIZE = IS_NETWORK_STABLE<T, Compare> ? SORTING_NETWORK_MAX_SIZE : SMALL_SORT_SIZE;
+
+// Stable, for up to STABLE_SMALL_SORT_SIZE elements
+template <typename T, typename Compare>
+void StableSmallSort(T* first, T* last, Compare& comp) {
+  if constexpr (IS_NETWORK_STABLE<T, Compare>) {
+    NetworkSort(first, last - first, comp);
+  } else {
+    InsertionSort(first, last, comp);
+  }
+}
+
+}  // namespace detail
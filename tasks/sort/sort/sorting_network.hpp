@@ -0,0 +1,157 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+// Sorting networks for ranges of up to SORTING_NETWORK_MAX_SIZE elements.
+//
+// A network is a fixed sequence of compare-exchanges, so for arithmetic types it has
+// no branches to mispredict: each comparator is a min and a max. The networks are
+// Batcher's merge exchange (Knuth, TAOCP 5.2.2, algorithm M) generated at compile time
+// for every size. They are optimal for up to 8 elements and a few comparators longer
+// than the best known ones above (63 against 60 for 16, 191 against 185 for 32).
+//
+// The comparators of one step of the algorithm come in runs (i, i + d), (i + 1, i + 1 + d), ...
+// of the same distance and don't overlap, so a run is a loop over two disjoint blocks
+// which the compiler turns into vector min and max.
+//
+// Not stable.
+inline constexpr size_t SORTING_NETWORK_MAX_SIZE = 32;
+
+namespace detail {
+
+// Comparisons of such types compile to flags, not branches
+template <typename T, typename Compare>
+inline constexpr bool IS_BRANCHLESS_COMPARISON = std::is_arithmetic_v<T> &&
+  (std::is_same_v<Compare, std::less<T>> || std::is_same_v<Compare, std::less<>> ||
+   std::is_same_v<Compare, std::greater<T>> || std::is_same_v<Compare, std::greater<>>);
+
+// Comparators (first + k, first + distance + k) for k < length
+struct ComparatorRun{
+  uint8_t first;
+  uint8_t distance;
+  uint8_t length;
+};
+
+// Calls emit(run) for the runs of the network for size elements in order
+template <typename Emit>
+constexpr void ForEachComparatorRun(size_t size, Emit emit) {
+  if (size < 2) {
+    return;
+  }
+  size_t top = 1;
+  while (top * 2 < size) {
+    top *= 2;
+  }
+  for (size_t p = top; p > 0; p /= 2) {
+    size_t q = top;
+    size_t r = 0;
+    size_t d = p;
+    while (true) {
+      ComparatorRun run{0, static_cast<uint8_t>(d), 0};
+      for (size_t i = 0; i + d < size; ++i) {
+        if ((i & p) != r) {
+          continue;
+        }
+        if (run.length != 0 && run.first + run.length != i) {
+          emit(run);
+          run.length = 0;
+        }
+        if (run.length == 0) {
+          run.first = static_cast<uint8_t>(i);
+        }
+        ++run.length;
+      }
+      if (run.length != 0) {
+        emit(run);
+      }
+      if (q == p) {
+        break;
+      }
+      d = q - p;
+      q /= 2;
+      r = p;
+    }
+  }
+}
+
+constexpr size_t CountComparatorRuns(size_t size) {
+  size_t count = 0;
+  ForEachComparatorRun(size, [&count](ComparatorRun) {
+    ++count;
+  });
+  return count;
+}
+
+template <size_t Size>
+constexpr auto MakeSortingNetwork() {
+  std::array<ComparatorRun, CountComparatorRuns(Size)> runs{};
+  size_t count = 0;
+  ForEachComparatorRun(Size, [&](ComparatorRun run) {
+    runs[count++] = run;
+  });
+  return runs;
+}
+
+template <size_t Size>
+inline constexpr auto SORTING_NETWORK = MakeSortingNetwork<Size>();
+
+// Number of comparators
+template <size_t Size>
+constexpr size_t SortingNetworkLength() {
+  size_t length = 0;
+  for (ComparatorRun run : SORTING_NETWORK<Size>) {
+    length += run.length;
+  }
+  return length;
+}
+
+template <bool Branchless, typename T, typename Compare>
+inline void CompareExchange(T& a, T& b, Compare& comp) {
+  if constexpr (Branchless) {
+    // Compiles to a min and a max: each select keeps the operand order of its comparison.
+    // If neither is less (equal or NaN), both stay in place
+    T x = a;
+    T y = b;
+    a = comp(y, x) ? y : x;
+    b = comp(x, y) ? y : x;
+  } else {
+    if (comp(b, a)) {
+      using std::swap;
+      swap(a, b);
+    }
+  }
+}
+
+template <bool Branchless, ComparatorRun Run, typename T, typename Compare>
+inline void ApplyComparatorRun(T* data, Compare& comp) {
+  T* low = data + Run.first;
+  T* high = low + Run.distance;
+  for (size_t k = 0; k < Run.length; ++k) {
+    CompareExchange<Branchless>(low[k], high[k], comp);
+  }
+}
+
+template <size_t Size, typename T, typename Compare>
+void SortNetwork(T* data, Compare& comp) {
+  constexpr bool BRANCHLESS = IS_BRANCHLESS_COMPARISON<T, Compare>;
+  [&]<size_t... I>(std::index_sequence<I...>) {
+    (ApplyComparatorRun<BRANCHLESS, SORTING_NETWORK<Size>[I]>(data, comp), ...);
+  }(std::make_index_sequence<SORTING_NETWORK<Size>.size()>());
+}
+
+// Sorts [data, data + size) for size <= SORTING_NETWORK_MAX_SIZE
+template <typename T, typename Compare>
+void NetworkSort(T* data, size_t size, Compare& comp) {
+  using Kernel = void (*)(T*, Compare&);
+  static constexpr auto KERNELS = []<size_t... Size>(std::index_sequence<Size...>) {
+    return std::array<Kernel, sizeof...(Size)>{&SortNetwork<Size, T, Compare>...};
+  }(std::make_index_sequence<SORTING_NETWORK_MAX_SIZE + 1>());
+  KERNELS[size](data, comp);
+}
+
+}  // namespace detail
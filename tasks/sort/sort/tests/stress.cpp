@@ -1,11 +1,23 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
 #include <random>
 #include <forward_list>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 #include <benchmark/benchmark.h>
 #include <fmt/core.h>
 
 #include "../forward_list.hpp"
+#include "../radix_sort.hpp"
+#include "../parallel_merge_sort.hpp"
+#include "../pdq_sort.hpp"
+#include "../external_sort.hpp"
+#include "../sorting_network.hpp"
 
 void ConstructRandomList(ForwardList<int>& list, int sz) {
   std::random_device rd;
@@ -31,6 +43,97 @@ void ConstructRandomList(std::forward_list<int>& list, int sz) {
   }
 }
 
+enum Shape {
+  RANDOM,
+  SORTED,
+  REVERSE,
+  FEW_UNIQUE,
+  ORGAN_PIPE,
+  SAWTOOTH,
+  ALL_EQUAL,
+};
+
+std::vector<int> ShapedValues(int sz, int shape) {
+  std::mt19937 mt(29);
+  std::vector<int> values(sz);
+  for (int i = 0; i < sz; ++i) {
+    switch (shape) {
+      case RANDOM: values[i] = static_cast<int>(mt()); break;
+      case SORTED: values[i] = i; break;
+      case REVERSE: values[i] = sz - i; break;
+      case ORGAN_PIPE: values[i] = i < sz / 2 ? i : sz - i; break;
+      case SAWTOOTH: values[i] = i % 1000; break;
+      case ALL_EQUAL: values[i] = 0; break;
+      default: values[i] = static_cast<int>(mt() % 16); break;
+    }
+  }
+  return values;
+}
+
+template <typename ListType>
+void FillFront(ListType& list, const std::vector<int>& values) {
+  for (auto it = values.rbegin(); it != values.rend(); ++it) {
+    if constexpr (std::is_same_v<ListType, std::forward_list<int>>) {
+      list.push_front(*it);
+    } else {
+      list.PushFront(*it);
+    }
+  }
+}
+
+// Keys of the given width, random in all bits
+template <typename T>
+Vector<T> RandomVector(int sz) {
+  std::mt19937_64 mt(41);
+  Vector<T> values;
+  values.Reserve(sz);
+  for (int i = 0; i < sz; ++i) {
+    values.PushBack(static_cast<T>(mt()));
+  }
+  return values;
+}
+
+Vector<int> ShapedVector(int sz, int shape) {
+  auto values = ShapedValues(sz, shape);
+  Vector<int> result;
+  result.Reserve(sz);
+  for (int value : values) {
+    result.PushBack(value);
+  }
+  return result;
+}
+
+// A file of random uint64_t keys in the temporary directory, the caller removes it
+std::filesystem::path RandomKeysFile(size_t megabytes) {
+  auto path = std::filesystem::temp_directory_path() / fmt::format("external-sort-bench-{}mb.bin", megabytes);
+  size_t bytes = megabytes << 20;
+  std::mt19937_64 mt(44);
+  std::ofstream file(path, std::ios::binary);
+  std::vector<uint64_t> block(1 << 17);
+  for (size_t written = 0; written < bytes; written += block.size() * sizeof(uint64_t)) {
+    for (auto& key : block) {
+      key = mt();
+    }
+    file.write(reinterpret_cast<const char*>(block.data()), block.size() * sizeof(uint64_t));
+  }
+  return path;
+}
+
+struct KeyedRecord {
+  uint64_t key;
+  uint64_t payload;
+};
+
+Vector<KeyedRecord> RandomRecords(int sz) {
+  std::mt19937_64 mt(41);
+  Vector<KeyedRecord> records;
+  records.Reserve(sz);
+  for (int i = 0; i < sz; ++i) {
+    records.PushBack({mt(), static_cast<uint64_t>(i)});
+  }
+  return records;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void BM_CustomListPushFront(benchmark::State& state) {
   ForwardList<int> list;
@@ -159,6 +262,277 @@ void BM_StdListFind(benchmark::State& state) {
 }
 
 
+// The list is refilled with the same values outside of the timed region
+void BM_CustomListSort(benchmark::State& state) {
+  auto values = ShapedValues(state.range(0), state.range(1));
+  for (auto _ : state) {
+    state.PauseTiming();
+    ForwardList<int> list;
+    FillFront(list, values);
+    state.ResumeTiming();
+    list.Sort();
+    state.PauseTiming();
+    list.Clear();
+    state.ResumeTiming();
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_StdListSort(benchmark::State& state) {
+  auto values = ShapedValues(state.range(0), state.range(1));
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::forward_list<int> list;
+    FillFront(list, values);
+    state.ResumeTiming();
+    list.sort();
+    state.PauseTiming();
+    list.clear();
+    state.ResumeTiming();
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+// Copies values to a vector, sorts it and writes them back to the nodes
+void BM_CustomListVectorSort(benchmark::State& state) {
+  auto values = ShapedValues(state.range(0), state.range(1));
+  for (auto _ : state) {
+    state.PauseTiming();
+    ForwardList<int> list;
+    FillFront(list, values);
+    state.ResumeTiming();
+    std::vector<int> buffer(list.Begin(), list.End());
+    std::stable_sort(buffer.begin(), buffer.end());
+    std::copy(buffer.begin(), buffer.end(), list.Begin());
+    state.PauseTiming();
+    list.Clear();
+    state.ResumeTiming();
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+// The vector is refilled with the same keys outside of the timed region
+template <typename T>
+void BM_VectorRadixSort(benchmark::State& state) {
+  auto source = RandomVector<T>(state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    Vector<T> values = source;
+    state.ResumeTiming();
+    RadixSort(values);
+    benchmark::DoNotOptimize(values.Data());
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+template <typename T>
+void BM_VectorMsdRadixSort(benchmark::State& state) {
+  auto source = RandomVector<T>(state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    Vector<T> values = source;
+    state.ResumeTiming();
+    MsdRadixSort(values);
+    benchmark::DoNotOptimize(values.Data());
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+template <typename T>
+void BM_VectorStdSort(benchmark::State& state) {
+  auto source = RandomVector<T>(state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    Vector<T> values = source;
+    state.ResumeTiming();
+    std::sort(values.Data(), values.Data() + values.Size());
+    benchmark::DoNotOptimize(values.Data());
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_RecordRadixSort(benchmark::State& state) {
+  auto source = RandomRecords(state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    Vector<KeyedRecord> records = source;
+    state.ResumeTiming();
+    RadixSort(records, &KeyedRecord::key);
+    benchmark::DoNotOptimize(records.Data());
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_RecordStdStableSort(benchmark::State& state) {
+  auto source = RandomRecords(state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    Vector<KeyedRecord> records = source;
+    state.ResumeTiming();
+    std::stable_sort(records.Data(), records.Data() + records.Size(), [](const KeyedRecord& a, const KeyedRecord& b) {
+      return a.key < b.key;
+    });
+    benchmark::DoNotOptimize(records.Data());
+  }
+  state.SetComplexityN(state.range(0));
+}
+// Arguments: size, threads. Time is wall clock, so the speedup is the ratio to one thread
+void BM_ParallelMergeSort(benchmark::State& state) {
+  auto source = RandomVector<uint32_t>(state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    Vector<uint32_t> values = source;
+    state.ResumeTiming();
+    ParallelMergeSort(values, std::less<uint32_t>(), state.range(1));
+    benchmark::DoNotOptimize(values.Data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Arguments: size, sequential cutoff, on all hardware threads
+void BM_ParallelMergeSortCutoff(benchmark::State& state) {
+  auto source = RandomVector<uint32_t>(state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    Vector<uint32_t> values = source;
+    state.ResumeTiming();
+    ParallelMergeSort(values, std::less<uint32_t>(), std::thread::hardware_concurrency(), state.range(1));
+    benchmark::DoNotOptimize(values.Data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_StdStableSort(benchmark::State& state) {
+  auto source = RandomVector<uint32_t>(state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    Vector<uint32_t> values = source;
+    state.ResumeTiming();
+    std::stable_sort(values.Data(), values.Data() + values.Size());
+    benchmark::DoNotOptimize(values.Data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// Arguments: size, input shape
+void BM_VectorPdqSort(benchmark::State& state) {
+  auto source = ShapedVector(state.range(0), state.range(1));
+  for (auto _ : state) {
+    state.PauseTiming();
+    Vector<int> values = source;
+    state.ResumeTiming();
+    PdqSort(values);
+    benchmark::DoNotOptimize(values.Data());
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_VectorStdSortShaped(benchmark::State& state) {
+  auto source = ShapedVector(state.range(0), state.range(1));
+  for (auto _ : state) {
+    state.PauseTiming();
+    Vector<int> values = source;
+    state.ResumeTiming();
+    std::sort(values.Data(), values.Data() + values.Size());
+    benchmark::DoNotOptimize(values.Data());
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+// Comparison through a lambda, so the partition is the branchy one
+void BM_StringPdqSort(benchmark::State& state) {
+  auto keys = RandomVector<uint64_t>(state.range(0));
+  Vector<std::string> source;
+  for (size_t i = 0; i < keys.Size(); ++i) {
+    source.PushBack(std::to_string(keys[i]));
+  }
+  for (auto _ : state) {
+    state.PauseTiming();
+    Vector<std::string> values = source;
+    state.ResumeTiming();
+    PdqSort(values, [](const std::string& a, const std::string& b) {
+      return a < b;
+    });
+    benchmark::DoNotOptimize(values.Data());
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_StringStdSort(benchmark::State& state) {
+  auto keys = RandomVector<uint64_t>(state.range(0));
+  Vector<std::string> source;
+  for (size_t i = 0; i < keys.Size(); ++i) {
+    source.PushBack(std::to_string(keys[i]));
+  }
+  for (auto _ : state) {
+    state.PauseTiming();
+    Vector<std::string> values = source;
+    state.ResumeTiming();
+    std::sort(values.Data(), values.Data() + values.Size(), [](const std::string& a, const std::string& b) {
+      return a < b;
+    });
+    benchmark::DoNotOptimize(values.Data());
+  }
+  state.SetComplexityN(state.range(0));
+}
+// 256 MB files, 4 GB ones as well if EXTERNAL_SORT_LARGE is set: they take 12 GB of disk
+void ExternalSortArguments(benchmark::internal::Benchmark* benchmark) {
+  std::vector<int64_t> sizes{256};
+  if (std::getenv("EXTERNAL_SORT_LARGE") != nullptr) {
+    sizes.push_back(4096);
+  }
+  benchmark->ArgsProduct({sizes, {0, 1}});
+}
+
+// Arguments: file size in MB, async I/O. The memory budget is 64 MB
+void BM_ExternalSort(benchmark::State& state) {
+  auto input = RandomKeysFile(state.range(0));
+  auto output = std::filesystem::path(input).replace_extension("sorted");
+  ExternalSortOptions options;
+  options.memory_budget = size_t{64} << 20;
+  options.async_io = state.range(1) != 0;
+  for (auto _ : state) {
+    ExternalSort<uint64_t>(input, output, std::less<uint64_t>(), options);
+  }
+  std::filesystem::remove(output);
+  std::filesystem::remove(input);
+  state.SetBytesProcessed(state.iterations() * (state.range(0) << 20));
+}
+
+
+// Sorts SMALL_SORT_BATCH arrays of state.range(0) random keys each, copying them from the source first
+inline constexpr size_t SMALL_SORT_BATCH = 1 << 10;
+
+template <typename T, typename SmallSort>
+void RunSmallSorts(benchmark::State& state, SmallSort sort) {
+  size_t size = state.range(0);
+  auto source = RandomVector<T>(size * SMALL_SORT_BATCH);
+  Vector<T> values = source;
+  std::less<T> comp;
+  for (auto _ : state) {
+    std::copy(source.Data(), source.Data() + source.Size(), values.Data());
+    for (size_t i = 0; i < SMALL_SORT_BATCH; ++i) {
+      sort(values.Data() + i * size, size, comp);
+    }
+    benchmark::DoNotOptimize(values.Data());
+  }
+  state.SetItemsProcessed(state.iterations() * SMALL_SORT_BATCH);
+}
+
+template <typename T>
+void BM_SortingNetwork(benchmark::State& state) {
+  RunSmallSorts<T>(state, [](T* data, size_t size, std::less<T>& comp) {
+    detail::NetworkSort(data, size, comp);
+  });
+}
+
+template <typename T>
+void BM_SmallInsertionSort(benchmark::State& state) {
+  RunSmallSorts<T>(state, [](T* data, size_t size, std::less<T>& comp) {
+    detail::InsertionSort(data, data + size, comp);
+  });
+}
+
+
 BENCHMARK(BM_CustomListPushFront)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMillisecond);
 BENCHMARK(BM_StdListPushFront)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMillisecond);
 BENCHMARK(BM_CustomListMiddleInsert)->Range(1<<10, 1<<15)->Complexity()->Unit(benchmark::kMillisecond);
@@ -170,5 +544,40 @@ BENCHMARK(BM_StdListClear)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::k
 BENCHMARK(BM_CustomListFind)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMillisecond);
 BENCHMARK(BM_StdListFind)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMillisecond);
 
+// Arguments: size, input shape (0 random, 1 sorted, 2 reverse, 3 few unique)
+BENCHMARK(BM_CustomListSort)->ArgsProduct({{1<<10, 1<<15, 1<<20}, {RANDOM, SORTED, REVERSE, FEW_UNIQUE}})->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StdListSort)->ArgsProduct({{1<<10, 1<<15, 1<<20}, {RANDOM, SORTED, REVERSE, FEW_UNIQUE}})->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CustomListVectorSort)->ArgsProduct({{1<<10, 1<<15, 1<<20}, {RANDOM, SORTED, REVERSE, FEW_UNIQUE}})->Unit(benchmark::kMillisecond);
+
+// Radix sorts by key width against std::sort
+BENCHMARK_TEMPLATE(BM_VectorRadixSort, uint32_t)->Range(1<<10, 1<<24)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_VectorMsdRadixSort, uint32_t)->Range(1<<10, 1<<24)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_VectorStdSort, uint32_t)->Range(1<<10, 1<<24)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_VectorRadixSort, uint64_t)->Range(1<<10, 1<<24)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_VectorMsdRadixSort, uint64_t)->Range(1<<10, 1<<24)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_VectorStdSort, uint64_t)->Range(1<<10, 1<<24)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RecordRadixSort)->Range(1<<10, 1<<24)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RecordStdStableSort)->Range(1<<10, 1<<24)->Complexity()->Unit(benchmark::kMillisecond);
+
+// Parallel merge sort by threads, 10M elements and more need a few GB of memory
+BENCHMARK(BM_ParallelMergeSort)->ArgsProduct({{1<<20, 10000000}, {1, 2, 4, 8, 16}})->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ParallelMergeSortCutoff)->ArgsProduct({{10000000}, {1<<10, 1<<12, 1<<14, 1<<16, 1<<18}})->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StdStableSort)->Arg(1<<20)->Arg(10000000)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// Arguments: size, input shape (0 random, 1 sorted, 2 reverse, 3 few unique, 4 organ pipe, 5 sawtooth, 6 all equal)
+BENCHMARK(BM_VectorPdqSort)->ArgsProduct({{1<<10, 1<<15, 1<<20}, {RANDOM, SORTED, REVERSE, FEW_UNIQUE, ORGAN_PIPE, SAWTOOTH, ALL_EQUAL}})->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_VectorStdSortShaped)->ArgsProduct({{1<<10, 1<<15, 1<<20}, {RANDOM, SORTED, REVERSE, FEW_UNIQUE, ORGAN_PIPE, SAWTOOTH, ALL_EQUAL}})->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StringPdqSort)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StringStdSort)->Range(1<<10, 1<<20)->Complexity()->Unit(benchmark::kMillisecond);
+
+// External sort of a file 4 times bigger than the memory budget, and 64 times on request
+BENCHMARK(BM_ExternalSort)->Apply(ExternalSortArguments)->Iterations(1)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+
+// Base case kernels by the number of elements, items are arrays
+BENCHMARK_TEMPLATE(BM_SortingNetwork, uint32_t)->DenseRange(2, SORTING_NETWORK_MAX_SIZE);
+BENCHMARK_TEMPLATE(BM_SmallInsertionSort, uint32_t)->DenseRange(2, SORTING_NETWORK_MAX_SIZE);
+BENCHMARK_TEMPLATE(BM_SortingNetwork, double)->DenseRange(2, SORTING_NETWORK_MAX_SIZE);
+BENCHMARK_TEMPLATE(BM_SmallInsertionSort, double)->DenseRange(2, SORTING_NETWORK_MAX_SIZE);
 
 BENCHMARK_MAIN();
\ No newline at end of file
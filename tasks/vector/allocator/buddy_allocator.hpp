@@ -0,0 +1,241 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+
+// Buddy-system allocator over a fixed arena.
+//
+// Arena is split into blocks of size MinBlockSize() * 2^order. Allocation rounds
+// the request up to the nearest block size and splits a bigger free block if needed,
+// deallocation merges the block with its free buddy as long as possible.
+// Both operations are O(log(Capacity() / MinBlockSize())).
+class BuddyAllocator {
+public:
+    static constexpr size_t DEFAULT_MIN_BLOCK_SIZE = 64;
+    static constexpr size_t ARENA_ALIGNMENT = 4096;
+
+    explicit BuddyAllocator(size_t capacity, size_t min_block_size = DEFAULT_MIN_BLOCK_SIZE) {
+        if (min_block_size < sizeof(FreeBlock) || !std::has_single_bit(min_block_size)) {
+            throw std::invalid_argument("Min block size must be a power of two not less than 16");
+        }
+        min_block_shift_ = std::countr_zero(min_block_size);
+        capacity_ = capacity >> min_block_shift_ << min_block_shift_;
+        if (capacity_ == 0) {
+            throw std::invalid_argument("Capacity is less than min block size");
+        }
+
+        size_t block_count = capacity_ >> min_block_shift_;
+        max_order_ = std::bit_width(block_count) - 1;
+
+        // The destructor doesn't run if the constructor throws, so the tags are freed by hand
+        block_tags_ = new uint8_t[block_count]();
+        try {
+            arena_ = static_cast<std::byte*>(::operator new(capacity_, std::align_val_t{ARENA_ALIGNMENT}));
+        } catch (...) {
+            delete[] block_tags_;
+            throw;
+        }
+
+        // Capacity may be not a power of two: seed free lists with its binary decomposition,
+        // largest blocks first, so every block stays aligned to its size
+        size_t offset = 0;
+        for (size_t order = max_order_ + 1; order-- > 0;) {
+            size_t block_size = BlockSizeOf(order);
+            if (offset + block_size <= capacity_) {
+                PushFree(offset, order);
+                offset += block_size;
+            }
+        }
+    }
+
+    BuddyAllocator(const BuddyAllocator&) = delete;
+
+    BuddyAllocator& operator=(const BuddyAllocator&) = delete;
+
+    // Throws std::bad_alloc if there is no free block big enough
+    void* Allocate(size_t size) {
+        void* ptr = TryAllocate(size);
+        if (ptr == nullptr) {
+            throw std::bad_alloc();
+        }
+        return ptr;
+    }
+
+    void* TryAllocate(size_t size) noexcept {
+        // Checked before rounding up, which overflows for sizes close to SIZE_MAX
+        if (size > capacity_) {
+            return nullptr;
+        }
+        size_t order = OrderFor(size);
+        if (order > max_order_) {
+            return nullptr;
+        }
+
+        uint64_t suitable_orders = free_orders_ >> order;
+        if (suitable_orders == 0) {
+            return nullptr;
+        }
+        size_t found_order = order + std::countr_zero(suitable_orders);
+        size_t offset = PopFree(found_order);
+
+        // Split down, returning upper halves to the free lists
+        while (found_order > order) {
+            --found_order;
+            PushFree(offset + BlockSizeOf(found_order), found_order);
+        }
+
+        block_tags_[offset >> min_block_shift_] = static_cast<uint8_t>(order);
+        used_bytes_ += BlockSizeOf(order);
+        return arena_ + offset;
+    }
+
+    void Deallocate(void* ptr) noexcept {
+        if (ptr == nullptr) {
+            return;
+        }
+        size_t offset = OffsetOf(ptr);
+        size_t order = block_tags_[offset >> min_block_shift_];
+        used_bytes_ -= BlockSizeOf(order);
+
+        // Merge with free buddies going up
+        while (order < max_order_) {
+            size_t buddy = offset ^ BlockSizeOf(order);
+            if (buddy + BlockSizeOf(order) > capacity_ || !IsFreeBlock(buddy, order)) {
+                break;
+            }
+            RemoveFree(buddy, order);
+            offset = offset < buddy ? offset : buddy;
+            block_tags_[(offset ^ BlockSizeOf(order)) >> min_block_shift_] = 0;
+            ++order;
+        }
+        PushFree(offset, order);
+    }
+
+    inline bool Owns(const void* ptr) const noexcept {
+        auto* byte_ptr = static_cast<const std::byte*>(ptr);
+        return byte_ptr >= arena_ && byte_ptr < arena_ + capacity_;
+    }
+
+    // Size of the block actually granted for ptr
+    inline size_t BlockSize(const void* ptr) const noexcept {
+        return BlockSizeOf(block_tags_[OffsetOf(ptr) >> min_block_shift_] & ORDER_MASK);
+    }
+
+    inline size_t Capacity() const noexcept {
+        return capacity_;
+    }
+
+    inline size_t MinBlockSize() const noexcept {
+        return BlockSizeOf(0);
+    }
+
+    inline size_t UsedBytes() const noexcept {
+        return used_bytes_;
+    }
+
+    inline size_t FreeBytes() const noexcept {
+        return capacity_ - used_bytes_;
+    }
+
+    inline size_t LargestFreeBlock() const noexcept {
+        if (free_orders_ == 0) {
+            return 0;
+        }
+        return BlockSizeOf(std::bit_width(free_orders_) - 1);
+    }
+
+    // 1 - LargestFreeBlock / FreeBytes: 0 when all free memory is one block,
+    // close to 1 when it is scattered over many small ones
+    inline double ExternalFragmentation() const noexcept {
+        size_t free_bytes = FreeBytes();
+        if (free_bytes == 0) {
+            return 0.0;
+        }
+        return 1.0 - static_cast<double>(LargestFreeBlock()) / static_cast<double>(free_bytes);
+    }
+
+    ~BuddyAllocator() {
+        delete[] block_tags_;
+        ::operator delete(arena_, std::align_val_t{ARENA_ALIGNMENT});
+    }
+
+private:
+    struct FreeBlock {
+        FreeBlock* prev;
+        FreeBlock* next;
+    };
+
+    static constexpr size_t MAX_ORDERS = 64;
+    static constexpr uint8_t FREE_FLAG = 0x80;
+    static constexpr uint8_t ORDER_MASK = 0x7F;
+
+    inline size_t BlockSizeOf(size_t order) const noexcept {
+        return size_t{1} << (order + min_block_shift_);
+    }
+
+    inline size_t OrderFor(size_t size) const noexcept {
+        size_t blocks = (size + MinBlockSize() - 1) >> min_block_shift_;
+        if (blocks <= 1) {
+            return 0;
+        }
+        return std::bit_width(blocks - 1);
+    }
+
+    inline size_t OffsetOf(const void* ptr) const noexcept {
+        return static_cast<size_t>(static_cast<const std::byte*>(ptr) - arena_);
+    }
+
+    inline bool IsFreeBlock(size_t offset, size_t order) const noexcept {
+        return block_tags_[offset >> min_block_shift_] == (FREE_FLAG | order);
+    }
+
+    void PushFree(size_t offset, size_t order) noexcept {
+        auto* block = reinterpret_cast<FreeBlock*>(arena_ + offset);
+        block->prev = nullptr;
+        block->next = free_lists_[order];
+        if (block->next != nullptr) {
+            block->next->prev = block;
+        }
+        free_lists_[order] = block;
+        free_orders_ |= uint64_t{1} << order;
+        block_tags_[offset >> min_block_shift_] = static_cast<uint8_t>(FREE_FLAG | order);
+    }
+
+    void RemoveFree(size_t offset, size_t order) noexcept {
+        auto* block = reinterpret_cast<FreeBlock*>(arena_ + offset);
+        if (block->prev != nullptr) {
+            block->prev->next = block->next;
+        } else {
+            free_lists_[order] = block->next;
+        }
+        if (block->next != nullptr) {
+            block->next->prev = block->prev;
+        }
+        if (free_lists_[order] == nullptr) {
+            free_orders_ &= ~(uint64_t{1} << order);
+        }
+        block_tags_[offset >> min_block_shift_] = 0;
+    }
+
+    size_t PopFree(size_t order) noexcept {
+        size_t offset = OffsetOf(free_lists_[order]);
+        RemoveFree(offset, order);
+        return offset;
+    }
+
+private:
+    std::byte* arena_ = nullptr;
+    size_t capacity_ = 0;
+    size_t min_block_shift_ = 0;
+    size_t max_order_ = 0;
+    size_t used_bytes_ = 0;
+
+    FreeBlock* free_lists_[MAX_ORDERS] = {};
+    // Bit k is set iff free_lists_[k] isn't empty
+    uint64_t free_orders_ = 0;
+    // Tag of the first min block of every block: its order and FREE_FLAG for free ones
+    uint8_t* block_tags_ = nullptr;
+};
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <exception>
+#include <string>
+
+class PersistentHeapException: public std::exception {
+public:
+    explicit PersistentHeapException(const std::string& text) : error_message_(text) {
+    }
+
+    const char* what() const noexcept override {
+        return error_message_.c_str();
+    }
+
+private:
+    std::string error_message_;
+};
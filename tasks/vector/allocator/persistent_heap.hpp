@@ -0,0 +1,474 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "exceptions.hpp"
+
+// Pointer which stores the distance from itself to the target.
+// Stays valid when the memory holding both of them is mapped at another address.
+template <typename T>
+class OffsetPtr {
+public:
+    using element_type = T;
+
+    OffsetPtr() noexcept = default;
+
+    OffsetPtr(T* ptr) noexcept {  // implicit, like a raw pointer
+        Set(ptr);
+    }
+
+    OffsetPtr(const OffsetPtr& other) noexcept {
+        Set(other.Get());
+    }
+
+    OffsetPtr& operator=(const OffsetPtr& other) noexcept {
+        Set(other.Get());
+        return *this;
+    }
+
+    OffsetPtr& operator=(T* ptr) noexcept {
+        Set(ptr);
+        return *this;
+    }
+
+    inline T* Get() const noexcept {
+        if (offset_ == NULL_OFFSET) {
+            return nullptr;
+        }
+        return reinterpret_cast<T*>(reinterpret_cast<std::uintptr_t>(this) + offset_);
+    }
+
+    inline std::add_lvalue_reference_t<T> operator*() const noexcept {
+        return *Get();
+    }
+
+    inline T* operator->() const noexcept {
+        return Get();
+    }
+
+    inline std::add_lvalue_reference_t<T> operator[](std::ptrdiff_t index) const noexcept {
+        return Get()[index];
+    }
+
+    inline explicit operator bool() const noexcept {
+        return offset_ != NULL_OFFSET;
+    }
+
+    inline bool operator==(const OffsetPtr& other) const noexcept {
+        return Get() == other.Get();
+    }
+
+    inline bool operator!=(const OffsetPtr& other) const noexcept {
+        return Get() != other.Get();
+    }
+
+private:
+    // The pointer can't point into its own second byte, so this is never a real offset
+    static constexpr std::uintptr_t NULL_OFFSET = 1;
+
+    inline void Set(T* ptr) noexcept {
+        if (ptr == nullptr) {
+            offset_ = NULL_OFFSET;
+            return;
+        }
+        // Addresses as integers: subtracting pointers into different objects is undefined
+        // and the optimizer relies on it. Unsigned wrap-around gives the right sum in Get
+        offset_ = reinterpret_cast<std::uintptr_t>(ptr) - reinterpret_cast<std::uintptr_t>(this);
+    }
+
+private:
+    std::uintptr_t offset_ = NULL_OFFSET;
+};
+
+namespace detail {
+
+// Layout of the file: this header, then the chunks. Everything inside the file refers
+// to other parts of it only by OffsetPtr, so the file can be mapped at any address.
+struct Segment {
+    static constexpr uint64_t MAGIC = 0x50484541505F3031;  // "PHEAP_01"
+    static constexpr size_t ALIGNMENT = 16;
+    static constexpr size_t MAX_ROOTS = 64;
+    static constexpr size_t ROOT_NAME_SIZE = 48;
+
+    struct Chunk {
+        // Whole chunk size including this header
+        uint64_t size;
+        // Valid only while the chunk is in the free list
+        OffsetPtr<Chunk> next;
+    };
+
+    struct Root {
+        char name[ROOT_NAME_SIZE];
+        OffsetPtr<void> object;
+    };
+
+    static constexpr size_t MIN_CHUNK_SIZE = sizeof(Chunk) + ALIGNMENT;
+
+    uint64_t magic;
+    uint64_t capacity;
+    // Offset of the never allocated tail
+    uint64_t top;
+    OffsetPtr<Chunk> free_list;
+    Root roots[MAX_ROOTS];
+
+    static inline size_t AlignUp(size_t size) noexcept {
+        return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    }
+
+    inline std::byte* Base() noexcept {
+        return reinterpret_cast<std::byte*>(this);
+    }
+
+    // First fit over the address-ordered free list, then the tail
+    void* Allocate(size_t size) {
+        // Checked before rounding up, which overflows for sizes close to SIZE_MAX
+        if (size > capacity) {
+            throw std::bad_alloc();
+        }
+        size_t need = AlignUp(size + sizeof(Chunk));
+
+        OffsetPtr<Chunk>* link = &free_list;
+        while (*link) {
+            Chunk* chunk = link->Get();
+            if (chunk->size >= need) {
+                if (chunk->size - need >= MIN_CHUNK_SIZE) {
+                    auto* rest = new (reinterpret_cast<std::byte*>(chunk) + need) Chunk{chunk->size - need, {}};
+                    rest->next = chunk->next.Get();
+                    *link = rest;
+                    chunk->size = need;
+                } else {
+                    *link = chunk->next.Get();
+                }
+                return reinterpret_cast<std::byte*>(chunk) + sizeof(Chunk);
+            }
+            link = &chunk->next;
+        }
+
+        if (need > capacity - top) {
+            throw std::bad_alloc();
+        }
+        auto* chunk = new (Base() + top) Chunk{need, {}};
+        top += need;
+        return reinterpret_cast<std::byte*>(chunk) + sizeof(Chunk);
+    }
+
+    // Returns the chunk to the free list, merging it with adjacent free chunks
+    void Deallocate(void* ptr) noexcept {
+        if (ptr == nullptr) {
+            return;
+        }
+        auto* chunk = reinterpret_cast<Chunk*>(static_cast<std::byte*>(ptr) - sizeof(Chunk));
+
+        OffsetPtr<Chunk>* prev_link = nullptr;
+        OffsetPtr<Chunk>* link = &free_list;
+        while (*link && link->Get() < chunk) {
+            prev_link = link;
+            link = &link->Get()->next;
+        }
+        Chunk* prev = prev_link == nullptr ? nullptr : prev_link->Get();
+        Chunk* next = link->Get();
+
+        if (next != nullptr && End(chunk) == reinterpret_cast<std::byte*>(next)) {
+            chunk->size += next->size;
+            next = next->next.Get();
+        }
+        if (prev != nullptr && End(prev) == reinterpret_cast<std::byte*>(chunk)) {
+            prev->size += chunk->size;
+            prev->next = next;
+            chunk = prev;
+            link = prev_link;
+        } else {
+            chunk->next = next;
+            *link = chunk;
+        }
+
+        // Nothing is allocated after this chunk: give it back to the tail
+        if (End(chunk) == Base() + top) {
+            top -= chunk->size;
+            *link = nullptr;
+        }
+    }
+
+    Root* FindRoot(const std::string& name) noexcept {
+        for (auto& root : roots) {
+            if (root.object && name == root.name) {
+                return &root;
+            }
+        }
+        return nullptr;
+    }
+
+    Root* FreeRoot() noexcept {
+        for (auto& root : roots) {
+            if (!root.object) {
+                return &root;
+            }
+        }
+        return nullptr;
+    }
+
+private:
+    static inline std::byte* End(Chunk* chunk) noexcept {
+        return reinterpret_cast<std::byte*>(chunk) + chunk->size;
+    }
+};
+
+}  // namespace detail
+
+// Heap inside a memory-mapped file.
+//
+// Opens the file if it already holds a heap, otherwise creates a new one of the given capacity.
+// Objects are reachable after reopening through named roots. They must not own anything
+// outside of the heap and must refer to each other through OffsetPtr only:
+// the file is mapped at an arbitrary address.
+class PersistentHeap {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = size_t{1} << 26;
+
+    explicit PersistentHeap(const std::string& path, size_t capacity = DEFAULT_CAPACITY) {
+        fd_ = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (fd_ < 0) {
+            throw PersistentHeapException("Can't open heap file " + path);
+        }
+
+        struct stat file_stat {};
+        if (::fstat(fd_, &file_stat) != 0) {
+            ::close(fd_);
+            throw PersistentHeapException("Can't stat heap file " + path);
+        }
+        bool is_new = file_stat.st_size == 0;
+        if (is_new) {
+            capacity = detail::Segment::AlignUp(capacity);
+            if (capacity < sizeof(detail::Segment) || ::ftruncate(fd_, static_cast<off_t>(capacity)) != 0) {
+                ::close(fd_);
+                throw PersistentHeapException("Can't create heap file " + path);
+            }
+            size_ = capacity;
+        } else {
+            size_ = static_cast<size_t>(file_stat.st_size);
+        }
+
+        void* address = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (address == MAP_FAILED) {
+            ::close(fd_);
+            throw PersistentHeapException("Can't map heap file " + path);
+        }
+        segment_ = static_cast<detail::Segment*>(address);
+
+        if (is_new) {
+            new (segment_) detail::Segment{
+                detail::Segment::MAGIC, size_, detail::Segment::AlignUp(sizeof(detail::Segment)), {}, {}};
+        } else if (size_ < sizeof(detail::Segment) || segment_->magic != detail::Segment::MAGIC ||
+                   segment_->capacity != size_) {
+            Close();
+            throw PersistentHeapException("File " + path + " doesn't contain a heap");
+        }
+    }
+
+    PersistentHeap(const PersistentHeap&) = delete;
+
+    PersistentHeap& operator=(const PersistentHeap&) = delete;
+
+    // Throws std::bad_alloc if the file is full
+    inline void* Allocate(size_t size) {
+        return segment_->Allocate(size);
+    }
+
+    inline void Deallocate(void* ptr) noexcept {
+        segment_->Deallocate(ptr);
+    }
+
+    // Creates an object and registers it as a named root
+    template <typename T, typename... Args>
+    T* Construct(const std::string& name, Args&&... args) {
+        if (name.size() >= detail::Segment::ROOT_NAME_SIZE) {
+            throw PersistentHeapException("Root name is too long: " + name);
+        }
+        if (segment_->FindRoot(name) != nullptr) {
+            throw PersistentHeapException("Root already exists: " + name);
+        }
+        auto* root = segment_->FreeRoot();
+        if (root == nullptr) {
+            throw PersistentHeapException("Too many roots");
+        }
+
+        void* memory = Allocate(sizeof(T));
+        T* object;
+        try {
+            object = new (memory) T(std::forward<Args>(args)...);
+        } catch (...) {
+            Deallocate(memory);
+            throw;
+        }
+        std::memcpy(root->name, name.c_str(), name.size() + 1);
+        root->object = object;
+        return object;
+    }
+
+    // nullptr if there is no such root
+    template <typename T>
+    T* Find(const std::string& name) const noexcept {
+        auto* root = segment_->FindRoot(name);
+        return root == nullptr ? nullptr : static_cast<T*>(root->object.Get());
+    }
+
+    template <typename T, typename... Args>
+    T* FindOrConstruct(const std::string& name, Args&&... args) {
+        T* object = Find<T>(name);
+        return object != nullptr ? object : Construct<T>(name, std::forward<Args>(args)...);
+    }
+
+    template <typename T>
+    void Destroy(const std::string& name) noexcept {
+        auto* root = segment_->FindRoot(name);
+        if (root == nullptr) {
+            return;
+        }
+        T* object = static_cast<T*>(root->object.Get());
+        object->~T();
+        Deallocate(object);
+        root->object = nullptr;
+    }
+
+    // Write dirty pages to the file
+    void Flush() {
+        if (::msync(segment_, size_, MS_SYNC) != 0) {
+            throw PersistentHeapException("Can't flush heap file");
+        }
+    }
+
+    inline const void* Base() const noexcept {
+        return segment_;
+    }
+
+    inline size_t Capacity() const noexcept {
+        return size_;
+    }
+
+    ~PersistentHeap() {
+        Close();
+    }
+
+private:
+    template <typename T>
+    friend class PersistentVector;
+
+    void Close() noexcept {
+        ::munmap(segment_, size_);
+        ::close(fd_);
+    }
+
+private:
+    int fd_ = -1;
+    size_t size_ = 0;
+    detail::Segment* segment_ = nullptr;
+};
+
+// Vector which lives inside a PersistentHeap, e.g.
+//   auto* values = heap.FindOrConstruct<PersistentVector<int>>("values", heap);
+// Keeps a self-relative link to the heap, so it can grow after reopening.
+template <typename T>
+class PersistentVector {
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable elements survive a restart");
+
+public:
+    explicit PersistentVector(PersistentHeap& heap) noexcept : segment_(heap.segment_) {
+    }
+
+    PersistentVector(const PersistentVector&) = delete;
+
+    PersistentVector& operator=(const PersistentVector&) = delete;
+
+    inline T& operator[](size_t pos) const noexcept {
+        return data_[static_cast<std::ptrdiff_t>(pos)];
+    }
+
+    inline T& Front() const noexcept {
+        return data_[0];
+    }
+
+    inline T& Back() const noexcept {
+        return data_[static_cast<std::ptrdiff_t>(size_ - 1)];
+    }
+
+    inline T* Data() const noexcept {
+        return data_.Get();
+    }
+
+    inline T* Begin() const noexcept {
+        return data_.Get();
+    }
+
+    inline T* End() const noexcept {
+        return data_.Get() + size_;
+    }
+
+    inline bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    inline size_t Size() const noexcept {
+        return size_;
+    }
+
+    inline size_t Capacity() const noexcept {
+        return capacity_;
+    }
+
+    void Reserve(size_t new_cap) {
+        if (new_cap <= capacity_) {
+            return;
+        }
+        if (new_cap > std::numeric_limits<size_t>::max() / sizeof(T)) {
+            throw std::bad_alloc();
+        }
+        auto* new_data = static_cast<T*>(segment_->Allocate(new_cap * sizeof(T)));
+        if (size_ > 0) {
+            std::memcpy(new_data, data_.Get(), size_ * sizeof(T));
+        }
+        segment_->Deallocate(data_.Get());
+        data_ = new_data;
+        capacity_ = new_cap;
+    }
+
+    void PushBack(const T& value) {
+        if (size_ == capacity_) {
+            // value may live inside the buffer being reallocated
+            T copy = value;
+            Reserve(capacity_ == 0 ? 1 : capacity_ * 2);
+            data_[static_cast<std::ptrdiff_t>(size_++)] = copy;
+            return;
+        }
+        data_[static_cast<std::ptrdiff_t>(size_++)] = value;
+    }
+
+    void PopBack() noexcept {
+        --size_;
+    }
+
+    void Clear() noexcept {
+        size_ = 0;
+    }
+
+    ~PersistentVector() {
+        segment_->Deallocate(data_.Get());
+    }
+
+private:
+    OffsetPtr<detail::Segment> segment_;
+    OffsetPtr<T> data_;
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+};
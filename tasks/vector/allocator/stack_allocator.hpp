@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+
+// Scratch arena for short-lived containers.
+//
+// Memory is served from an inline buffer of N bytes by bumping a pointer.
+// Deallocation of the most recent allocation moves the pointer back (LIFO),
+// other deallocations leave a hole until Reset() or the arena dies.
+// Requests which don't fit into the buffer go to the heap.
+template <size_t N, size_t Alignment = alignof(std::max_align_t)>
+class StackAllocator {
+public:
+    StackAllocator() noexcept : top_(buffer_) {
+    }
+
+    StackAllocator(const StackAllocator&) = delete;
+
+    StackAllocator& operator=(const StackAllocator&) = delete;
+
+    void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+        void* ptr = top_;
+        size_t space = static_cast<size_t>(buffer_ + N - top_);
+        if (std::align(alignment, size, ptr, space) != nullptr) {
+            top_ = static_cast<std::byte*>(ptr) + size;
+            return ptr;
+        }
+        if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            return ::operator new(size, std::align_val_t{alignment});
+        }
+        return ::operator new(size);
+    }
+
+    void Deallocate(void* ptr, size_t size, size_t alignment = alignof(std::max_align_t)) noexcept {
+        if (Owns(ptr)) {
+            if (static_cast<std::byte*>(ptr) + size == top_) {
+                top_ = static_cast<std::byte*>(ptr);
+            }
+            return;
+        }
+        if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            ::operator delete(ptr, std::align_val_t{alignment});
+        } else {
+            ::operator delete(ptr);
+        }
+    }
+
+    // Forget all buffer allocations at once. Heap allocations are not affected
+    inline void Reset() noexcept {
+        top_ = buffer_;
+    }
+
+    // The end of the buffer is included: a zero-sized allocation from a full buffer points there
+    inline bool Owns(const void* ptr) const noexcept {
+        auto* byte_ptr = static_cast<const std::byte*>(ptr);
+        return byte_ptr >= buffer_ && byte_ptr <= buffer_ + N;
+    }
+
+    inline size_t Used() const noexcept {
+        return static_cast<size_t>(top_ - buffer_);
+    }
+
+    static constexpr size_t Capacity() noexcept {
+        return N;
+    }
+
+private:
+    alignas(Alignment) std::byte buffer_[N];
+    std::byte* top_;
+};
+
+// Adapter which lets allocator-aware containers take memory from a StackAllocator.
+// The arena must outlive every container using it.
+template <typename T, size_t N, size_t Alignment = alignof(std::max_align_t)>
+class StackStlAllocator {
+public:
+    using value_type = T;
+    using Arena = StackAllocator<N, Alignment>;
+
+    template <typename U>
+    struct rebind {
+        using other = StackStlAllocator<U, N, Alignment>;
+    };
+
+    explicit StackStlAllocator(Arena& arena) noexcept : arena_(&arena) {
+    }
+
+    template <typename U>
+    StackStlAllocator(const StackStlAllocator<U, N, Alignment>& other) noexcept
+        : arena_(other.arena_) {
+    }
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(arena_->Allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* ptr, size_t n) noexcept {
+        arena_->Deallocate(ptr, n * sizeof(T), alignof(T));
+    }
+
+    template <typename U>
+    bool operator==(const StackStlAllocator<U, N, Alignment>& other) const noexcept {
+        return arena_ == other.arena_;
+    }
+
+    template <typename U>
+    bool operator!=(const StackStlAllocator<U, N, Alignment>& other) const noexcept {
+        return arena_ != other.arena_;
+    }
+
+private:
+    template <typename U, size_t M, size_t A>
+    friend class StackStlAllocator;
+
+    Arena* arena_;
+};
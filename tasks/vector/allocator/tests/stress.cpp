@@ -0,0 +1,268 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <fmt/core.h>
+#include <mimalloc.h>
+
+#include "../buddy_allocator.hpp"
+#include "../persistent_heap.hpp"
+#include "../stack_allocator.hpp"
+
+static constexpr size_t ARENA_CAPACITY = size_t{1} << 28;
+static constexpr size_t SCRATCH_SIZE = size_t{1} << 16;
+static constexpr int STARTUP_QUERIES = 1000;
+
+struct TraceOp {
+  bool is_allocation;
+  // Allocation size or index of the allocation to free
+  size_t value;
+};
+
+// Mixed-size trace: mostly small buffers, some medium, a few large ones.
+// Live set size is kept around live_target allocations.
+std::vector<TraceOp> MakeMixedTrace(size_t ops_count, size_t live_target) {
+  std::mt19937 mt(2024);
+  std::uniform_int_distribution<size_t> small(16, 256);
+  std::uniform_int_distribution<size_t> medium(256, 4096);
+  std::uniform_int_distribution<size_t> large(4096, 65536);
+  std::uniform_int_distribution<int> kind(0, 99);
+
+  std::vector<TraceOp> trace;
+  std::vector<size_t> live;
+  size_t allocations = 0;
+  for (size_t i = 0; i < ops_count; ++i) {
+    bool is_allocation = live.empty() || (live.size() < live_target ? mt() % 4 != 0 : mt() % 4 == 0);
+    if (is_allocation) {
+      int k = kind(mt);
+      size_t size = k < 70 ? small(mt) : (k < 95 ? medium(mt) : large(mt));
+      trace.push_back({true, size});
+      live.push_back(allocations++);
+    } else {
+      size_t pos = mt() % live.size();
+      trace.push_back({false, live[pos]});
+      live[pos] = live.back();
+      live.pop_back();
+    }
+  }
+  for (size_t index : live) {
+    trace.push_back({false, index});
+  }
+  return trace;
+}
+
+std::string BenchFilePath(const std::string& name) {
+  return (std::filesystem::temp_directory_path() / name).string();
+}
+
+// Sorted keys 0, 2, 4, ... in a persistent heap and in a flat binary file
+void PrepareStartupFiles(const std::string& heap_path, const std::string& flat_path, int64_t count) {
+  std::filesystem::remove(heap_path);
+  PersistentHeap heap(heap_path, static_cast<size_t>(count) * sizeof(int) + (size_t{1} << 20));
+  auto* keys = heap.Construct<PersistentVector<int>>("keys", heap);
+  keys->Reserve(count);
+  for (int64_t i = 0; i < count; ++i) {
+    keys->PushBack(static_cast<int>(2 * i));
+  }
+  heap.Flush();
+
+  std::ofstream flat(flat_path, std::ios::binary | std::ios::trunc);
+  flat.write(reinterpret_cast<const char*>(keys->Data()), static_cast<std::streamsize>(count * sizeof(int)));
+}
+
+int CountFound(const int* begin, const int* end, int64_t count) {
+  std::mt19937 mt(7);
+  std::uniform_int_distribution<int64_t> dist(0, 2 * count);
+  int found = 0;
+  for (int i = 0; i < STARTUP_QUERIES; ++i) {
+    found += std::binary_search(begin, end, static_cast<int>(dist(mt)));
+  }
+  return found;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void BM_BuddyMixedTrace(benchmark::State& state) {
+  auto trace = MakeMixedTrace(state.range(0), state.range(0) / 8);
+  BuddyAllocator allocator(ARENA_CAPACITY);
+  std::vector<void*> ptrs(trace.size(), nullptr);
+  size_t failures = 0;
+  size_t peak_used = 0;
+  double peak_fragmentation = 0.0;
+  size_t peak_largest_free = 0;
+  size_t requested = 0;
+  size_t granted = 0;
+
+  for (auto _ : state) {
+    size_t allocation = 0;
+    for (const auto& op : trace) {
+      if (op.is_allocation) {
+        void* ptr = allocator.TryAllocate(op.value);
+        failures += ptr == nullptr;
+        ptrs[allocation++] = ptr;
+      } else {
+        allocator.Deallocate(ptrs[op.value]);
+      }
+    }
+  }
+
+  // Replay once more outside of timing to sample fragmentation at the peak of the live set
+  size_t allocation = 0;
+  for (const auto& op : trace) {
+    if (op.is_allocation) {
+      void* ptr = allocator.TryAllocate(op.value);
+      if (ptr != nullptr) {
+        requested += op.value;
+        granted += allocator.BlockSize(ptr);
+      }
+      ptrs[allocation++] = ptr;
+      if (allocator.UsedBytes() > peak_used) {
+        peak_used = allocator.UsedBytes();
+        peak_fragmentation = allocator.ExternalFragmentation();
+        peak_largest_free = allocator.LargestFreeBlock();
+      }
+    } else {
+      allocator.Deallocate(ptrs[op.value]);
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * trace.size());
+  state.counters["failures"] = static_cast<double>(failures);
+  state.counters["peak_used"] = static_cast<double>(peak_used);
+  state.counters["peak_ext_fragmentation"] = peak_fragmentation;
+  state.counters["peak_largest_free"] = static_cast<double>(peak_largest_free);
+  state.counters["internal_waste"] = 1.0 - static_cast<double>(requested) / static_cast<double>(granted);
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_MimallocMixedTrace(benchmark::State& state) {
+  auto trace = MakeMixedTrace(state.range(0), state.range(0) / 8);
+  std::vector<void*> ptrs(trace.size(), nullptr);
+  size_t requested = 0;
+  size_t granted = 0;
+
+  for (auto _ : state) {
+    size_t allocation = 0;
+    for (const auto& op : trace) {
+      if (op.is_allocation) {
+        ptrs[allocation++] = mi_malloc(op.value);
+      } else {
+        mi_free(ptrs[op.value]);
+      }
+    }
+  }
+
+  size_t allocation = 0;
+  for (const auto& op : trace) {
+    if (op.is_allocation) {
+      void* ptr = mi_malloc(op.value);
+      requested += op.value;
+      granted += mi_usable_size(ptr);
+      ptrs[allocation++] = ptr;
+    } else {
+      mi_free(ptrs[op.value]);
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * trace.size());
+  state.counters["internal_waste"] = 1.0 - static_cast<double>(requested) / static_cast<double>(granted);
+  state.SetComplexityN(state.range(0));
+}
+
+// Temporary containers which live for a single request
+void BM_HeapTemporaryVector(benchmark::State& state) {
+  for (auto _ : state) {
+    std::vector<int> values;
+    for (int i = 0; i < state.range(0); ++i) {
+      values.push_back(i);
+    }
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_StackTemporaryVector(benchmark::State& state) {
+  using Allocator = StackStlAllocator<int, SCRATCH_SIZE>;
+  for (auto _ : state) {
+    Allocator::Arena arena;
+    std::vector<int, Allocator> values{Allocator(arena)};
+    for (int i = 0; i < state.range(0); ++i) {
+      values.push_back(i);
+    }
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_HeapTemporaryMap(benchmark::State& state) {
+  for (auto _ : state) {
+    std::map<int, int> mp;
+    for (int i = 0; i < state.range(0); ++i) {
+      mp.emplace(i * 7919 % state.range(0), i);
+    }
+    benchmark::DoNotOptimize(mp.size());
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_StackTemporaryMap(benchmark::State& state) {
+  using Allocator = StackStlAllocator<std::pair<const int, int>, SCRATCH_SIZE>;
+  for (auto _ : state) {
+    Allocator::Arena arena;
+    std::map<int, int, std::less<int>, Allocator> mp{Allocator(arena)};
+    for (int i = 0; i < state.range(0); ++i) {
+      mp.emplace(i * 7919 % state.range(0), i);
+    }
+    benchmark::DoNotOptimize(mp.size());
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+// Startup: open the data and answer the first queries
+void BM_PersistentReopenAndQuery(benchmark::State& state) {
+  auto heap_path = BenchFilePath("persistent_heap_startup.bin");
+  auto flat_path = BenchFilePath("persistent_heap_startup.flat");
+  PrepareStartupFiles(heap_path, flat_path, state.range(0));
+
+  for (auto _ : state) {
+    PersistentHeap heap(heap_path);
+    auto* keys = heap.Find<PersistentVector<int>>("keys");
+    benchmark::DoNotOptimize(CountFound(keys->Begin(), keys->End(), state.range(0)));
+  }
+  std::filesystem::remove(heap_path);
+  std::filesystem::remove(flat_path);
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_ReloadAndQuery(benchmark::State& state) {
+  auto heap_path = BenchFilePath("persistent_heap_reload.bin");
+  auto flat_path = BenchFilePath("persistent_heap_reload.flat");
+  PrepareStartupFiles(heap_path, flat_path, state.range(0));
+
+  for (auto _ : state) {
+    std::ifstream flat(flat_path, std::ios::binary);
+    std::vector<int> keys(state.range(0));
+    flat.read(reinterpret_cast<char*>(keys.data()), static_cast<std::streamsize>(keys.size() * sizeof(int)));
+    benchmark::DoNotOptimize(CountFound(keys.data(), keys.data() + keys.size(), state.range(0)));
+  }
+  std::filesystem::remove(heap_path);
+  std::filesystem::remove(flat_path);
+  state.SetComplexityN(state.range(0));
+}
+
+
+BENCHMARK(BM_BuddyMixedTrace)->Range(1<<12, 1<<18)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MimallocMixedTrace)->Range(1<<12, 1<<18)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_HeapTemporaryVector)->Range(1<<3, 1<<11)->Complexity()->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_StackTemporaryVector)->Range(1<<3, 1<<11)->Complexity()->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_HeapTemporaryMap)->Range(1<<3, 1<<10)->Complexity()->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_StackTemporaryMap)->Range(1<<3, 1<<10)->Complexity()->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_PersistentReopenAndQuery)->Range(1<<16, 1<<24)->Complexity()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ReloadAndQuery)->Range(1<<16, 1<<24)->Complexity()->Unit(benchmark::kMillisecond);
+
+
+BENCHMARK_MAIN();
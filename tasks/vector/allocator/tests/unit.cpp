@@ -1,180 +1,479 @@
-#include <chrono>
-#include <future>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <map>
-#include <iostream>
+#include <new>
+#include <random>
+#include <stdexcept>
 #include <string>
-#include <thread>
+#include <utility>
+#include <vector>
 
 #include <fmt/core.h>
 #include <gtest/gtest.h>
 
-#include "../filesystem/fs.hpp"
+#include "../buddy_allocator.hpp"
+#include "../persistent_heap.hpp"
+#include "../stack_allocator.hpp"
 
-class FsTest: public testing::Test {
+class BuddyAllocatorTest: public testing::Test {
   protected:
-    void SetUp() override {
-      fs.MakeDir("/mnt/c/Users/Sysoev/VSCodeProjects/", true);
-      fs.CreateFile("/mnt/c/Users/Sysoev/VSCodeProjects/test.txt", false);
-      fs.CreateFile("/mnt/c/Users/Sysoev/VSCodeProjects/test1.txt", false);
-      fs.CreateFile("/mnt/c/Users/Sysoev/VSCodeProjects/test2.txt", false);
-      fs.CreateFile("/mnt/c/Users/Sysoev/VSCodeProjects/test3.txt", false);
-      fs.CreateFile("/mnt/c/Users/Sysoev/test3.txt", false);
-      fs.CreateFile("/mnt/c/Users/test1.txt", false);
-    }
-  
-public:
-  filesystem::Fs fs;
+    static constexpr size_t CAPACITY = 1 << 16;
+    static constexpr size_t MIN_BLOCK = 64;
+
+  BuddyAllocator allocator{CAPACITY, MIN_BLOCK};
 };
 
 
-TEST(EmptyFsTest, PWDOnRoot) {
-  filesystem::Fs fs;
-  fs.PWD();
-  // expect: "/"
+TEST(EmptyBuddyAllocatorTest, InvalidArguments) {
+  EXPECT_THROW({
+    BuddyAllocator allocator(1024, 48);
+  }, std::invalid_argument);
+  EXPECT_THROW({
+    BuddyAllocator allocator(1024, 8);
+  }, std::invalid_argument);
+  EXPECT_THROW({
+    BuddyAllocator allocator(32, 64);
+  }, std::invalid_argument);
 }
 
-TEST(EmptyFsTest, EmptyListFiles) {
-  filesystem::Fs fs;
-  fs.ListFiles(".");
-  // expect: 
+TEST(EmptyBuddyAllocatorTest, NotPowerOfTwoCapacity) {
+  BuddyAllocator allocator(1024 + 256 + 64 + 10, 64);
+  ASSERT_EQ(allocator.Capacity(), 1024 + 256 + 64);
+  ASSERT_EQ(allocator.FreeBytes(), allocator.Capacity());
+  ASSERT_EQ(allocator.LargestFreeBlock(), 1024);
+
+  void* big = allocator.Allocate(1024);
+  void* middle = allocator.Allocate(256);
+  void* small = allocator.Allocate(64);
+  ASSERT_EQ(allocator.FreeBytes(), 0);
+  ASSERT_EQ(allocator.TryAllocate(1), nullptr);
+
+  allocator.Deallocate(middle);
+  allocator.Deallocate(small);
+  allocator.Deallocate(big);
+  ASSERT_EQ(allocator.UsedBytes(), 0);
+  ASSERT_EQ(allocator.LargestFreeBlock(), 1024);
 }
 
-TEST(EmptyFsTest, SimpleMakeDir) {
-  filesystem::Fs fs;
-  fs.MakeDir("/dir", false);
-  fs.ChangeDir("/dir");
-  fs.PWD();
-  // expect: "/dir"
+TEST_F(BuddyAllocatorTest, Empty) {
+  ASSERT_EQ(allocator.Capacity(), CAPACITY);
+  ASSERT_EQ(allocator.MinBlockSize(), MIN_BLOCK);
+  ASSERT_EQ(allocator.UsedBytes(), 0);
+  ASSERT_EQ(allocator.FreeBytes(), CAPACITY);
+  ASSERT_EQ(allocator.LargestFreeBlock(), CAPACITY);
+  ASSERT_EQ(allocator.ExternalFragmentation(), 0.0);
 }
 
-TEST(EmptyFsTest, MakeDirWithFlag) {
-  filesystem::Fs fs;
-  fs.MakeDir("/dir/other_dir", true);
-  fs.ChangeDir("/dir");
-  fs.ChangeDir("other_dir");
-  fs.PWD();
-  // expect: "/dir/other_dir"
+TEST_F(BuddyAllocatorTest, RoundsUpToPowerOfTwo) {
+  void* zero = allocator.Allocate(0);
+  void* one = allocator.Allocate(1);
+  void* exact = allocator.Allocate(MIN_BLOCK);
+  void* above = allocator.Allocate(MIN_BLOCK + 1);
+  void* odd = allocator.Allocate(3 * MIN_BLOCK + 5);
+
+  ASSERT_EQ(allocator.BlockSize(zero), MIN_BLOCK);
+  ASSERT_EQ(allocator.BlockSize(one), MIN_BLOCK);
+  ASSERT_EQ(allocator.BlockSize(exact), MIN_BLOCK);
+  ASSERT_EQ(allocator.BlockSize(above), 2 * MIN_BLOCK);
+  ASSERT_EQ(allocator.BlockSize(odd), 4 * MIN_BLOCK);
+  ASSERT_EQ(allocator.UsedBytes(), 9 * MIN_BLOCK);
 }
 
-TEST(EmptyFsTest, MakeSeveralDirsWithoutFlag) {
-  filesystem::Fs fs;
-  EXPECT_THROW({
-    fs.MakeDir("/dir/other_dir", false);
-  }, filesystem::exceptions::FileNotFoundException);
+TEST_F(BuddyAllocatorTest, BlocksAreAlignedToTheirSize) {
+  for (size_t size = MIN_BLOCK; size <= 4096; size *= 2) {
+    void* ptr = allocator.Allocate(size);
+    ASSERT_TRUE(allocator.Owns(ptr));
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(ptr) % size, 0);
+  }
 }
 
-TEST(EmptyFsTest, ChangeDirToNotExistingDir) {
-  filesystem::Fs fs;
+TEST_F(BuddyAllocatorTest, SplitAndMerge) {
+  void* first = allocator.Allocate(1);
+  ASSERT_EQ(allocator.LargestFreeBlock(), CAPACITY / 2);
+
+  void* second = allocator.Allocate(1);
+  ASSERT_EQ(static_cast<std::byte*>(second) - static_cast<std::byte*>(first), MIN_BLOCK);
+
+  allocator.Deallocate(first);
+  ASSERT_EQ(allocator.LargestFreeBlock(), CAPACITY / 2);
+  allocator.Deallocate(second);
+  ASSERT_EQ(allocator.LargestFreeBlock(), CAPACITY);
+  ASSERT_EQ(allocator.UsedBytes(), 0);
+}
+
+TEST_F(BuddyAllocatorTest, FreedBlockIsReused) {
+  void* ptr = allocator.Allocate(100);
+  allocator.Deallocate(ptr);
+  ASSERT_EQ(allocator.Allocate(100), ptr);
+}
+
+TEST_F(BuddyAllocatorTest, CapacityLimit) {
+  void* whole = allocator.Allocate(CAPACITY);
+  ASSERT_EQ(allocator.FreeBytes(), 0);
   EXPECT_THROW({
-    fs.ChangeDir("/dir");
-  }, filesystem::exceptions::FileNotFoundException);
-}
-
-TEST(EmptyFsTest, SimpleCreateFile) {
-  filesystem::Fs fs;
-  fs.CreateFile("file.txt", false);
-  fs.ListFiles(".");
-  // expect: "file.txt"
-}
-
-TEST(EmptyFsTest, ShowFileContent) {
-  filesystem::Fs fs;
-  std::ostringstream oss;
-  oss << "Hello world!\n";
-  fs.CreateFile("file.txt", false);
-  fs.WriteToFile("file.txt", false, oss);
-  fs.ShowFileContent("file.txt");
-  // expect: "Hello world!"
-}
-
-TEST(EmptyFsTest, OverwriteFile) {
-  filesystem::Fs fs;
-  std::ostringstream oss;
-  oss << "Hello world!\n";
-  fs.CreateFile("file.txt", false);
-  fs.WriteToFile("file.txt", false, oss);
-  oss << "Hello Meeeen!\n";
-  fs.WriteToFile("file.txt", true, oss);
-  fs.ShowFileContent("file.txt");
-  // expect: "Hello Meeeen!"
-}
-
-TEST(EmptyFsTest, OverwriteFileByCreate) {
-  filesystem::Fs fs;
-  std::ostringstream oss;
-  oss << "Hello world!\n";
-  fs.CreateFile("file.txt", false);
-  fs.WriteToFile("file.txt", false, oss);
-  fs.CreateFile("file.txt", true);
-  fs.ShowFileContent("file.txt");
-  // expect:
-}
-
-TEST(EmptyFsTest, OverwriteFirstCreateFile) {
-  filesystem::Fs fs;
-  std::ostringstream oss;
-  oss << "Hello world!\n";
-  fs.CreateFile("file.txt", true);
-  fs.WriteToFile("file.txt", false, oss);
-  fs.ShowFileContent("file.txt");
-  // expect:
-}
-
-TEST(EmptyFsTest, SimpleRemoveFile) {
-  filesystem::Fs fs;
-  std::ostringstream oss;
-  oss << "Hello world!\n";
-  fs.CreateFile("file.txt", false);
-  fs.RemoveFile("file.txt");
-  fs.ListFiles(".");
-  // expect:
-}
-
-TEST(EmptyFsTest, RemoveNotExistFile) {
-  filesystem::Fs fs;
+    allocator.Allocate(1);
+  }, std::bad_alloc);
+  ASSERT_EQ(allocator.TryAllocate(1), nullptr);
+
+  allocator.Deallocate(whole);
+  ASSERT_EQ(allocator.TryAllocate(CAPACITY + 1), nullptr);
   EXPECT_THROW({
-    fs.RemoveFile("file.txt");
-  }, filesystem::exceptions::FileNotFoundException);
+    allocator.Allocate(CAPACITY + 1);
+  }, std::bad_alloc);
+}
+
+TEST_F(BuddyAllocatorTest, HugeSizes) {
+  for (size_t size : {SIZE_MAX, SIZE_MAX - CAPACITY, SIZE_MAX / 2 + 1}) {
+    ASSERT_EQ(allocator.TryAllocate(size), nullptr) << size;
+    EXPECT_THROW({
+      allocator.Allocate(size);
+    }, std::bad_alloc);
+  }
+  ASSERT_EQ(allocator.UsedBytes(), 0);
+}
+
+TEST_F(BuddyAllocatorTest, ExternalFragmentation) {
+  std::vector<void*> blocks;
+  for (size_t i = 0; i < CAPACITY / MIN_BLOCK; ++i) {
+    blocks.push_back(allocator.Allocate(MIN_BLOCK));
+  }
+  ASSERT_EQ(allocator.LargestFreeBlock(), 0);
+  ASSERT_EQ(allocator.ExternalFragmentation(), 0.0);
+
+  // Every other block is free, but no two of them are buddies
+  for (size_t i = 0; i < blocks.size(); i += 2) {
+    allocator.Deallocate(blocks[i]);
+  }
+  ASSERT_EQ(allocator.FreeBytes(), CAPACITY / 2);
+  ASSERT_EQ(allocator.LargestFreeBlock(), MIN_BLOCK);
+  ASSERT_DOUBLE_EQ(allocator.ExternalFragmentation(), 1.0 - 2.0 * MIN_BLOCK / CAPACITY);
+  ASSERT_EQ(allocator.TryAllocate(2 * MIN_BLOCK), nullptr);
+
+  for (size_t i = 1; i < blocks.size(); i += 2) {
+    allocator.Deallocate(blocks[i]);
+  }
+  ASSERT_EQ(allocator.LargestFreeBlock(), CAPACITY);
+  ASSERT_EQ(allocator.ExternalFragmentation(), 0.0);
+}
+
+TEST_F(BuddyAllocatorTest, RandomAllocations) {
+  std::mt19937 mt(42);
+  std::uniform_int_distribution<size_t> size_dist(1, 2048);
+  std::vector<std::pair<unsigned char*, size_t>> live;
+
+  for (int step = 0; step < 20000; ++step) {
+    if (live.empty() || mt() % 2 == 0) {
+      size_t size = size_dist(mt);
+      auto* ptr = static_cast<unsigned char*>(allocator.TryAllocate(size));
+      if (ptr != nullptr) {
+        ASSERT_GE(allocator.BlockSize(ptr), size);
+        std::memset(ptr, static_cast<int>(live.size() & 0xFF), size);
+        live.emplace_back(ptr, size);
+      }
+    } else {
+      size_t index = mt() % live.size();
+      auto [ptr, size] = live[index];
+      unsigned char mark = ptr[0];
+      for (size_t i = 0; i < size; ++i) {
+        ASSERT_EQ(ptr[i], mark) << "Blocks overlap";
+      }
+      allocator.Deallocate(ptr);
+      live[index] = live.back();
+      live.pop_back();
+    }
+  }
+
+  for (auto [ptr, size] : live) {
+    allocator.Deallocate(ptr);
+  }
+  ASSERT_EQ(allocator.UsedBytes(), 0);
+  ASSERT_EQ(allocator.LargestFreeBlock(), CAPACITY);
+}
+
+TEST(StackAllocatorTest, ServesFromBuffer) {
+  StackAllocator<1024> arena;
+  void* first = arena.Allocate(100);
+  void* second = arena.Allocate(100);
+  ASSERT_TRUE(arena.Owns(first));
+  ASSERT_TRUE(arena.Owns(second));
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(second) % alignof(std::max_align_t), 0);
+  ASSERT_GE(arena.Used(), 200);
+}
+
+TEST(StackAllocatorTest, LifoDeallocation) {
+  StackAllocator<1024> arena;
+  void* first = arena.Allocate(64);
+  size_t used = arena.Used();
+  void* second = arena.Allocate(64);
+  arena.Deallocate(second, 64);
+  ASSERT_EQ(arena.Used(), used);
+  ASSERT_EQ(arena.Allocate(64), second);
+
+  // Not the last allocation: memory stays reserved until Reset
+  arena.Deallocate(first, 64);
+  ASSERT_GT(arena.Used(), 0);
+  arena.Reset();
+  ASSERT_EQ(arena.Used(), 0);
+}
+
+TEST(StackAllocatorTest, OverflowsToHeap) {
+  StackAllocator<256> arena;
+  void* inline_ptr = arena.Allocate(200);
+  void* heap_ptr = arena.Allocate(200);
+  ASSERT_TRUE(arena.Owns(inline_ptr));
+  ASSERT_FALSE(arena.Owns(heap_ptr));
+  std::memset(heap_ptr, 0, 200);
+  arena.Deallocate(heap_ptr, 200);
+  arena.Deallocate(inline_ptr, 200);
+  ASSERT_EQ(arena.Used(), 0);
+}
+
+TEST(StackAllocatorTest, ZeroSizeFromFullBuffer) {
+  StackAllocator<256> arena;
+  void* whole = arena.Allocate(256);
+  void* empty = arena.Allocate(0);
+  ASSERT_TRUE(arena.Owns(empty));
+  arena.Deallocate(empty, 0);
+  arena.Deallocate(whole, 256);
+  ASSERT_EQ(arena.Used(), 0);
+}
+
+TEST(StackAllocatorTest, OverAlignedOverflow) {
+  StackAllocator<64> arena;
+  void* ptr = arena.Allocate(128, 256);
+  ASSERT_FALSE(arena.Owns(ptr));
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(ptr) % 256, 0);
+  arena.Deallocate(ptr, 128, 256);
+}
+
+TEST(StackAllocatorTest, VectorInArena) {
+  using Arena = StackAllocator<4096>;
+  Arena arena;
+  std::vector<int, StackStlAllocator<int, 4096>> values{StackStlAllocator<int, 4096>(arena)};
+  values.reserve(100);
+  for (int i = 0; i < 100; ++i) {
+    values.push_back(i);
+  }
+  ASSERT_TRUE(arena.Owns(values.data()));
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_EQ(values[i], i);
+  }
+
+  // Growing past the buffer moves the elements to the heap
+  for (int i = 100; i < 2000; ++i) {
+    values.push_back(i);
+  }
+  ASSERT_FALSE(arena.Owns(values.data()));
+  ASSERT_EQ(values[1999], 1999);
+}
+
+TEST(StackAllocatorTest, MapInArena) {
+  using MapAllocator = StackStlAllocator<std::pair<const int, int>, 8192>;
+  MapAllocator::Arena arena;
+  std::map<int, int, std::less<int>, MapAllocator> mp{MapAllocator(arena)};
+  for (int i = 0; i < 50; ++i) {
+    mp[i] = i * i;
+  }
+  ASSERT_GT(arena.Used(), 0);
+  ASSERT_EQ(mp.size(), 50);
+  ASSERT_EQ(mp[7], 49);
+  ASSERT_TRUE(MapAllocator(arena) == mp.get_allocator());
 }
 
+class PersistentHeapTest: public testing::Test {
+  protected:
+    void SetUp() override {
+      path = (std::filesystem::temp_directory_path() /
+              ("persistent_heap_" + std::to_string(::getpid()) + ".bin")).string();
+      std::filesystem::remove(path);
+    }
 
-TEST_F(FsTest, SimpleFind) {
-  fs.FindFile("text3.txt");
-  // expect: 
-  // /mnt/c/Users/Sysoev/VSCodeProjects/test3.txt
-  // /mnt/c/Users/Sysoev/test3.txt
-  // 
+    void TearDown() override {
+      std::filesystem::remove(path);
+    }
+
+  std::string path;
+  static constexpr size_t CAPACITY = 1 << 20;
+};
+
+struct PersistentNode {
+  int value;
+  OffsetPtr<PersistentNode> next;
+};
+
+
+TEST(OffsetPtrTest, NullAndDereference) {
+  OffsetPtr<int> null_ptr;
+  ASSERT_FALSE(null_ptr);
+  ASSERT_EQ(null_ptr.Get(), nullptr);
+
+  int value = 5;
+  OffsetPtr<int> ptr = &value;
+  ASSERT_TRUE(ptr);
+  ASSERT_EQ(*ptr, 5);
+  OffsetPtr<int> copy = ptr;
+  ASSERT_EQ(copy.Get(), &value);
+  ASSERT_TRUE(copy == ptr);
+  copy = nullptr;
+  ASSERT_FALSE(copy);
+}
+
+TEST(OffsetPtrTest, SurvivesRelocation) {
+  struct Pair {
+    OffsetPtr<int> ptr;
+    int value;
+  };
+  alignas(Pair) unsigned char first[sizeof(Pair)];
+  alignas(Pair) unsigned char second[sizeof(Pair)];
+
+  auto* pair = new (first) Pair{{}, 42};
+  pair->ptr = &pair->value;
+  std::memcpy(second, first, sizeof(Pair));
+
+  auto* moved = reinterpret_cast<Pair*>(second);
+  ASSERT_EQ(moved->ptr.Get(), &moved->value);
+  ASSERT_EQ(*moved->ptr, 42);
 }
 
-TEST_F(FsTest, FailedChangeDirToFile) {
+TEST_F(PersistentHeapTest, AllocateAndCoalesce) {
+  PersistentHeap heap(path, CAPACITY);
+  ASSERT_EQ(heap.Capacity(), CAPACITY);
+
+  void* first = heap.Allocate(1000);
+  void* second = heap.Allocate(1000);
+  void* third = heap.Allocate(1000);
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(second) % 16, 0);
+  std::memset(second, 0xAB, 1000);
+
+  heap.Deallocate(first);
+  ASSERT_EQ(heap.Allocate(500), first);
+  heap.Deallocate(first);
+
+  // first and second merge into one chunk, which then fits a bigger request
+  heap.Deallocate(second);
+  ASSERT_EQ(heap.Allocate(1800), first);
+  heap.Deallocate(first);
+  heap.Deallocate(third);
+
+  // Everything is free again: the whole space is available
+  void* whole = heap.Allocate(CAPACITY / 2);
+  ASSERT_EQ(whole, first);
+}
+
+TEST_F(PersistentHeapTest, CapacityLimit) {
+  PersistentHeap heap(path, CAPACITY);
   EXPECT_THROW({
-    fs.ChangeDir("/mnt/c/Users/Sysoev/test3.txt");
-  }, filesystem::exceptions::FileNotFoundException);
+    heap.Allocate(CAPACITY);
+  }, std::bad_alloc);
+
+  // Sizes which overflow when the chunk header is added
+  EXPECT_THROW(heap.Allocate(SIZE_MAX - 8), std::bad_alloc);
+  EXPECT_THROW(heap.Allocate(SIZE_MAX), std::bad_alloc);
+  auto* values = heap.Construct<PersistentVector<int>>("values", heap);
+  EXPECT_THROW(values->Reserve(SIZE_MAX / 2), std::bad_alloc);
+  EXPECT_THROW(values->Reserve(SIZE_MAX / sizeof(int) + 1), std::bad_alloc);
+  ASSERT_EQ(values->Capacity(), 0);
 }
 
-TEST_F(FsTest, DirNotExistForCreateFile) {
+TEST_F(PersistentHeapTest, Roots) {
+  PersistentHeap heap(path, CAPACITY);
+  ASSERT_EQ(heap.Find<int>("answer"), nullptr);
+  int* answer = heap.Construct<int>("answer", 42);
+  ASSERT_EQ(heap.Find<int>("answer"), answer);
+  ASSERT_EQ(heap.FindOrConstruct<int>("answer", 0), answer);
   EXPECT_THROW({
-    fs.ChangeDir("/mnt/c/Users/Sysoev/VSCodeProjects");
-    fs.PWD();
-    // expect: /mnt/c/Users/Sysoev/VSCodeProjects/
-    fs.CreateFile("/dir/file.txt", false);
-  }, filesystem::exceptions::FileNotFoundException);
+    heap.Construct<int>("answer", 1);
+  }, PersistentHeapException);
+
+  heap.Destroy<int>("answer");
+  ASSERT_EQ(heap.Find<int>("answer"), nullptr);
 }
 
-TEST_F(FsTest, FileNotFound) {
+struct ThrowingRoot {
+  ThrowingRoot() {
+    throw std::runtime_error("constructor");
+  }
+
+  char payload[1000];
+};
+
+TEST_F(PersistentHeapTest, ThrowingConstructor) {
+  PersistentHeap heap(path, CAPACITY);
+  void* first = heap.Allocate(sizeof(ThrowingRoot));
+  heap.Deallocate(first);
   EXPECT_THROW({
-    fs.FindFile("file.cpp");
-  }, filesystem::exceptions::FileNotFoundException);
+    heap.Construct<ThrowingRoot>("root");
+  }, std::runtime_error);
+  ASSERT_EQ(heap.Find<ThrowingRoot>("root"), nullptr);
+
+  // The memory of the failed object went back to the heap
+  ASSERT_EQ(heap.Allocate(sizeof(ThrowingRoot)), first);
+}
+
+TEST_F(PersistentHeapTest, ReopenVector) {
+  {
+    PersistentHeap heap(path, CAPACITY);
+    auto* values = heap.Construct<PersistentVector<int>>("values", heap);
+    for (int i = 0; i < 1000; ++i) {
+      values->PushBack(i);
+    }
+  }
+  {
+    PersistentHeap heap(path);
+    auto* values = heap.Find<PersistentVector<int>>("values");
+    ASSERT_NE(values, nullptr);
+    ASSERT_EQ(values->Size(), 1000);
+    for (int i = 0; i < 1000; ++i) {
+      ASSERT_EQ((*values)[i], i);
+    }
+    // Still able to grow after reopening
+    for (int i = 1000; i < 5000; ++i) {
+      values->PushBack(i);
+    }
+  }
+  PersistentHeap heap(path);
+  auto* values = heap.Find<PersistentVector<int>>("values");
+  ASSERT_EQ(values->Size(), 5000);
+  ASSERT_EQ(values->Back(), 4999);
+}
+
+TEST_F(PersistentHeapTest, DifferentBaseAddress) {
+  PersistentHeap writer(path, CAPACITY);
+  auto* head = writer.Construct<OffsetPtr<PersistentNode>>("list");
+  for (int i = 0; i < 10; ++i) {
+    auto* node = new (writer.Allocate(sizeof(PersistentNode))) PersistentNode{i, {}};
+    node->next = head->Get();
+    *head = node;
+  }
+
+  // The same file mapped once more lands at another address
+  PersistentHeap reader(path);
+  ASSERT_NE(reader.Base(), writer.Base());
+  auto* list = reader.Find<OffsetPtr<PersistentNode>>("list");
+  ASSERT_NE(list, nullptr);
+  int expected = 9;
+  for (PersistentNode* node = list->Get(); node != nullptr; node = node->next.Get()) {
+    ASSERT_GE(static_cast<const void*>(node), reader.Base());
+    ASSERT_EQ(node->value, expected--);
+  }
+  ASSERT_EQ(expected, -1);
 }
 
-TEST_F(FsTest, DeleteRoot) {
-  fs.RemoveFile("/");
-  fs.ListFiles(".");
-  // expect: 
+TEST_F(PersistentHeapTest, NotAHeapFile) {
+  {
+    std::ofstream file(path);
+    file << "definitely not a heap";
+  }
+  EXPECT_THROW({
+    PersistentHeap heap(path);
+  }, PersistentHeapException);
 }
 
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
 
   return RUN_ALL_TESTS();
-}
\ No newline at end of file
+}
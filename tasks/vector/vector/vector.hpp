@@ -2,55 +2,244 @@
 
 #include <fmt/core.h>
 
+#include <algorithm>
+#include <cstddef>
 #include <initializer_list>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
 #include <utility>
 
 template <typename T>
 class Vector {
 public:
-    Vector();
-
-    Vector(size_t count, const T& value);
-
-    Vector(const Vector& other);
-
-    Vector(Vector&& other) noexcept;
-
-    Vector(std::initializer_list<T> init);
-
-    T& operator[](size_t pos);
-
-    T& Front() const noexcept;
-
-    T& Back() const noexcept;
-
-    T* Data() const noexcept;
-
-    bool IsEmpty() const noexcept;
-
-    size_t Size() const noexcept;
-
-    size_t Capacity() const noexcept;
-
-    void Reserve(size_t new_cap);
-
-    void Clear() noexcept;
-
-    void Insert(size_t pos, T value);
-
-    void Erase(size_t begin_pos, size_t end_pos);
-
-    void PushBack(T value);
+    // The first allocation made by growth holds at least this many elements
+    static constexpr size_t MIN_CAPACITY = 10;
+
+    Vector() {
+    }
+
+    Vector(size_t count, const T& value) {
+        Reserve(NextCapacity(count));
+        std::uninitialized_fill_n(data_, count, value);
+        size_ = count;
+    }
+
+    Vector(const Vector& other) {
+        Reserve(other.size_);
+        std::uninitialized_copy_n(other.data_, other.size_, data_);
+        size_ = other.size_;
+    }
+
+    Vector(Vector&& other) noexcept {
+        Swap(other);
+    }
+
+    Vector(std::initializer_list<T> init) {
+        Reserve(NextCapacity(init.size()));
+        std::uninitialized_copy(init.begin(), init.end(), data_);
+        size_ = init.size();
+    }
+
+    Vector& operator=(const Vector& other) {
+        if (this != &other) {
+            Vector copy(other);
+            Swap(copy);
+        }
+        return *this;
+    }
+
+    Vector& operator=(Vector&& other) noexcept {
+        if (this != &other) {
+            Vector moved(std::move(other));
+            Swap(moved);
+        }
+        return *this;
+    }
+
+    T& operator[](size_t pos) {
+        return data_[pos];
+    }
+
+    const T& operator[](size_t pos) const {
+        return data_[pos];
+    }
+
+    T& Front() const noexcept {
+        return data_[0];
+    }
+
+    T& Back() const noexcept {
+        return data_[size_ - 1];
+    }
+
+    T* Data() const noexcept {
+        return data_;
+    }
+
+    bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    size_t Capacity() const noexcept {
+        return capacity_;
+    }
+
+    void Swap(Vector& other) noexcept {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+    }
+
+    void Reserve(size_t new_cap) {
+        if (new_cap <= capacity_) {
+            return;
+        }
+        T* data = Allocate(new_cap);
+        try {
+            Relocate(data_, size_, data);
+        } catch (...) {
+            Deallocate(data);
+            throw;
+        }
+        std::destroy_n(data_, size_);
+        Deallocate(data_);
+        data_ = data;
+        capacity_ = new_cap;
+    }
+
+    void Clear() noexcept {
+        std::destroy_n(data_, size_);
+        size_ = 0;
+    }
+
+    // Inserts value before position pos, pos == Size() appends
+    void Insert(size_t pos, T value) {
+        if (pos > size_) {
+            throw std::out_of_range(fmt::format("Position {} is out of vector of size {}", pos, size_));
+        }
+        EmplaceBack(std::move(value));
+        std::rotate(data_ + pos, data_ + size_ - 1, data_ + size_);
+    }
+
+    // Erases [begin_pos, end_pos), the part past the end is ignored
+    void Erase(size_t begin_pos, size_t end_pos) {
+        end_pos = std::min(end_pos, size_);
+        if (begin_pos >= end_pos) {
+            return;
+        }
+        std::move(data_ + end_pos, data_ + size_, data_ + begin_pos);
+        size_t new_size = size_ - (end_pos - begin_pos);
+        std::destroy(data_ + new_size, data_ + size_);
+        size_ = new_size;
+    }
+
+    void PushBack(T value) {
+        EmplaceBack(std::move(value));
+    }
 
     template <class... Args>
-    void EmplaceBack(Args&&... args);
-
-    void PopBack();
+    void EmplaceBack(Args&&... args) {
+        if (size_ < capacity_) {
+            new (data_ + size_) T(std::forward<Args>(args)...);
+            ++size_;
+            return;
+        }
+
+        // args may refer to an element, so the new one is built before the old ones move
+        size_t new_cap = NextCapacity(size_ + 1);
+        T* data = Allocate(new_cap);
+        try {
+            new (data + size_) T(std::forward<Args>(args)...);
+        } catch (...) {
+            Deallocate(data);
+            throw;
+        }
+        try {
+            Relocate(data_, size_, data);
+        } catch (...) {
+            std::destroy_at(data + size_);
+            Deallocate(data);
+            throw;
+        }
+        std::destroy_n(data_, size_);
+        Deallocate(data_);
+        data_ = data;
+        capacity_ = new_cap;
+        ++size_;
+    }
+
+    void PopBack() {
+        if (IsEmpty()) {
+            throw std::out_of_range("PopBack from empty vector");
+        }
+        std::destroy_at(data_ + --size_);
+    }
+
+    void Resize(size_t count, const T& value) {
+        if (count <= size_) {
+            std::destroy(data_ + count, data_ + size_);
+            size_ = count;
+            return;
+        }
+        if (count > capacity_) {
+            // value may be an element of the vector
+            T copy(value);
+            Reserve(NextCapacity(count));
+            std::uninitialized_fill(data_ + size_, data_ + count, copy);
+        } else {
+            std::uninitialized_fill(data_ + size_, data_ + count, value);
+        }
+        size_ = count;
+    }
+
+    ~Vector() {
+        std::destroy_n(data_, size_);
+        Deallocate(data_);
+    }
 
-    void Resize(size_t count, const T& value);
-
-    ~Vector();
+private:
+    // Capacity for at least required elements: doubling keeps PushBack O(1) on average
+    size_t NextCapacity(size_t required) const noexcept {
+        return std::max({required, capacity_ * 2, MIN_CAPACITY});
+    }
+
+    static T* Allocate(size_t count) {
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{alignof(T)}));
+    }
+
+    static void Deallocate(T* data) noexcept {
+        if (data != nullptr) {
+            ::operator delete(data, std::align_val_t{alignof(T)});
+        }
+    }
+
+    // Moves count elements to raw memory, or copies them if a throwing move could lose them.
+    // The source is left for the caller to destroy
+    static void Relocate(T* from, size_t count, T* to) {
+        if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+            std::uninitialized_move_n(from, count, to);
+        } else {
+            std::uninitialized_copy_n(from, count, to);
+        }
+    }
 
 private:
-    /*???*/
-}
\ No newline at end of file
+    T* data_ = nullptr;
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+};
+
+
+namespace std {
+    // Global swap overloading
+    template <typename T>
+    void swap(Vector<T>& a, Vector<T>& b) {
+        a.Swap(b);
+    }
+}